@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MBitPacking.h
+/// @brief Упаковка блоков целых чисел до минимальной разрядности (bit packing)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Массив разбивается на блоки по 128 или 256 чисел, каждый блок упаковывается до разрядности
+/// своего максимального значения. Поддерживаются режимы:
+/// - BitPackPlain  - значения упаковываются как есть;
+/// - BitPackFor    - frame of reference, из значений вычитается минимум блока;
+/// - BitPackDelta  - разности соседних значений в zig-zag кодировании.
+///
+/// Формат блока "вертикальный": блок 128 - 4 дорожки по 32 числа (SSE2), блок 256 - 8 дорожек
+/// по 32 числа (AVX2). Число i блока лежит в дорожке i % L, поэтому для BitPackDelta разность
+/// берется между in[i] и in[i - L]. Скалярная реализация дает тот же формат, что и векторная,
+/// т.е. данные, упакованные на одной машине, распаковываются на любой другой.
+///
+/// Упакованный поток - последовательность 32-битных слов:
+/// [заголовок блока][опорное значение (кроме BitPackPlain)][L * bits слов данных] ...
+/// Неполный последний блок дополняется последним значением.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MBITPACKING_H
+#define MBITPACKING_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "../../core/MGlobal.h"
+#include <cstdint>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Режим упаковки
+enum BitPackMode
+{
+    BitPackPlain    = 0,    ///< Без преобразования
+    BitPackFor      = 1,    ///< Frame of reference (вычитание минимума блока)
+    BitPackDelta    = 2     ///< Zig-zag разности с шагом в одну дорожку
+};
+
+/// Размер блока упаковки (количество чисел)
+enum BitPackBlock
+{
+    BitPackBlock128 = 128,  ///< 4 дорожки, ядро SSE2
+    BitPackBlock256 = 256   ///< 8 дорожек, ядро AVX2
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Блочный уровень
+
+/// \brief Разрядность, достаточная для хранения всех значений массива
+/// \return Число в диапазоне [0; 32]
+uint32_t bitpackWidth(const uint32_t * data, size_t count);
+
+/// \brief Упаковка одного блока
+/// \param in       - блок из block чисел, каждое из которых помещается в bits разрядов
+/// \param out      - выходной буфер размером (block / 32) * bits слов
+/// \param bits     - разрядность [0; 32]
+void bitpackBlock(const uint32_t * in, uint32_t * out, uint32_t bits, BitPackBlock block);
+
+/// \brief Распаковка одного блока
+/// \param in       - упакованные данные, (block / 32) * bits слов
+/// \param out      - выходной буфер на block чисел
+void bitunpackBlock(const uint32_t * in, uint32_t * out, uint32_t bits, BitPackBlock block);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Потоковый уровень
+
+/// \brief Максимальный размер упакованного потока (в 32-битных словах) для count чисел
+size_t bitpackEncodeBound(size_t count, BitPackBlock block);
+
+/// \brief Упаковка массива
+/// \param in       - входной массив
+/// \param count    - количество чисел
+/// \param out      - выходной буфер размером не менее bitpackEncodeBound(count, block) слов
+/// \return Количество записанных 32-битных слов
+size_t bitpackEncode(const uint32_t * in, size_t count, uint32_t * out,
+                     BitPackMode mode = BitPackFor, BitPackBlock block = BitPackBlock128);
+size_t bitpackEncode(const int32_t * in, size_t count, uint32_t * out,
+                     BitPackMode mode = BitPackFor, BitPackBlock block = BitPackBlock128);
+size_t bitpackEncode(const uint16_t * in, size_t count, uint32_t * out,
+                     BitPackMode mode = BitPackFor, BitPackBlock block = BitPackBlock128);
+size_t bitpackEncode(const int16_t * in, size_t count, uint32_t * out,
+                     BitPackMode mode = BitPackFor, BitPackBlock block = BitPackBlock128);
+
+/// \brief Распаковка массива
+/// \param in       - упакованный поток
+/// \param count    - количество чисел (то же, что при упаковке)
+/// \param out      - выходной массив на count чисел
+/// \return Количество прочитанных 32-битных слов, 0 - поток поврежден или параметры не совпадают
+size_t bitpackDecode(const uint32_t * in, size_t count, uint32_t * out,
+                     BitPackMode mode = BitPackFor, BitPackBlock block = BitPackBlock128);
+size_t bitpackDecode(const uint32_t * in, size_t count, int32_t * out,
+                     BitPackMode mode = BitPackFor, BitPackBlock block = BitPackBlock128);
+size_t bitpackDecode(const uint32_t * in, size_t count, uint16_t * out,
+                     BitPackMode mode = BitPackFor, BitPackBlock block = BitPackBlock128);
+size_t bitpackDecode(const uint32_t * in, size_t count, int16_t * out,
+                     BitPackMode mode = BitPackFor, BitPackBlock block = BitPackBlock128);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MBITPACKING_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
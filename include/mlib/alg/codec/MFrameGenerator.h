@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MFrameGenerator.h
+/// @brief Генератор случайных корректных кадров "синхрослово, длина, данные, CRC32"
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Поток кадров для нагрузочных испытаний и замеров скорости разборщиков протоколов:
+///
+///     [синхрослово: 0-4 байта][длина данных: 1, 2, 4 байта][данные][CRC32 (zlib): 4 байта]
+///
+/// Длина данных равномерно распределена в [minPayload, maxPayload], данные - случайные
+/// байты (fillRandom). Последовательность кадров определяется только начальным значением
+/// и не зависит от размеров буферов, которыми она выбирается.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MFRAMEGENERATOR_H
+#define MFRAMEGENERATOR_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "../../core/MGlobal.h"
+#include "../../core/MRandomEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Формат кадра
+struct MFrameLayout
+{
+    uint32_t sync;              ///< Синхрослово (младшие syncSize байтов, старшим байтом вперед)
+    unsigned syncSize;          ///< Байтов синхрослова: 0..4
+    unsigned lengthSize;        ///< Байтов поля длины: 1, 2 или 4
+    bool bigEndian;             ///< Порядок байтов полей длины и CRC
+    bool crcCoversHeader;       ///< CRC считается и по синхрослову с длиной (иначе - только по данным)
+    size_t minPayload;          ///< Диапазон длины данных
+    size_t maxPayload;
+
+    MFrameLayout() : sync(0xAA55), syncSize(2), lengthSize(2), bigEndian(false),
+                     crcCoversHeader(true), minPayload(0), maxPayload(1024) {}
+
+    inline size_t headerSize() const { return syncSize + lengthSize; }
+    inline size_t frameSize(size_t payload) const { return headerSize() + payload + 4; }
+    /// \brief Наибольшая длина, которую вмещает поле длины
+    inline size_t maxLength() const
+    {   return lengthSize >= 4 ? static_cast<size_t>(0xFFFFFFFFu) : (static_cast<size_t>(1) << (8 * lengthSize)) - 1; }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Генератор кадров с заданным начальным значением
+class MFrameGenerator
+{
+public:
+    /// \param layout - формат; неподдерживаемые размеры полей и диапазон длины приводятся
+    ///                 к ближайшим допустимым
+    explicit MFrameGenerator(const MFrameLayout & layout = MFrameLayout(), uint64_t seed = 0);
+
+    /// \brief Начало последовательности кадров заново
+    void seed(uint64_t seed);
+
+    inline const MFrameLayout & layout() const { return m_layout; }
+
+    /// \brief Следующий кадр в конец out
+    /// \return Размер кадра
+    size_t next(std::vector<uint8_t> & out);
+
+    /// \brief Запись следующих кадров в buffer, пока они помещаются целиком
+    /// \param used - байтов занято кадрами (может быть 0)
+    /// \return Количество кадров
+    size_t fill(uint8_t * buffer, size_t size, size_t * used = 0);
+
+    /// \brief Проверка кадра в начале data (эталонный разбор)
+    /// \return Размер кадра, 0 - кадр неполный или поврежден либо размеры полей layout
+    ///         не поддерживаются (layout не приводится к допустимому, как в конструкторе)
+    static size_t check(const MFrameLayout & layout, const uint8_t * data, size_t size);
+
+private:
+    /// Запись кадра с длиной данных payload
+    void write(uint8_t * out, size_t payload);
+    /// Длина данных следующего кадра
+    size_t pendingPayload();
+
+    MFrameLayout m_layout;
+    MXoshiro256ss m_engine;
+    size_t m_pending;           ///< Длина данных следующего кадра (выбрана, но еще не записан)
+    bool m_hasPending;
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MFRAMEGENERATOR_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MVarInt.h
+/// @brief Кодирование целых чисел переменной длины (LEB128, zig-zag, Stream VByte)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// LEB128 (varint) - 7 бит данных в байте, старший бит - признак продолжения.
+/// Знаковые числа предварительно кодируются zig-zag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+///
+/// Пакетное декодирование LEB128 без ветвления по каждому байту: серии однобайтовых чисел
+/// разворачиваются по 16 за раз (SSE2), одно- и двухбайтовые числа - до 8 за одну перестановку
+/// по таблице масок продолжения (Masked VByte, SSSE3), остальные числа извлекаются из 64-битного
+/// слова по маске признаков продолжения (PEXT при наличии BMI2).
+///
+/// Stream VByte - формат для максимальной скорости декодирования: управляющие байты
+/// (по 2 бита длины на число) хранятся отдельно от данных, 4 числа распаковываются одной
+/// инструкцией pshufb (SSSE3). Формат не совместим с LEB128.
+///
+/// Функции декодирования возвращают количество прочитанных байтов, 0 - данные повреждены
+/// или обрываются.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MVARINT_H
+#define MVARINT_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "../../core/MGlobal.h"
+#include <cstdint>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Zig-zag
+
+inline MLIB_CONSTEXPR uint32_t zigzagEncode(int32_t value)
+{   return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31); }
+
+inline MLIB_CONSTEXPR uint64_t zigzagEncode(int64_t value)
+{   return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+
+inline MLIB_CONSTEXPR int32_t zigzagDecode(uint32_t value)
+{   return static_cast<int32_t>((value >> 1) ^ (0u - (value & 1u))); }
+
+inline MLIB_CONSTEXPR int64_t zigzagDecode(uint64_t value)
+{   return static_cast<int64_t>((value >> 1) ^ (0ull - (value & 1ull))); }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// LEB128
+
+const size_t cVarIntMaxBytes32 = 5;     ///< Максимальная длина 32-битного числа
+const size_t cVarIntMaxBytes64 = 10;    ///< Максимальная длина 64-битного числа
+
+/// \brief Длина числа в кодировке LEB128
+inline MLIB_CONSTEXPR size_t varintSize(uint64_t value)
+{   return value < 0x80 ? 1 : 1 + varintSize(value >> 7); }
+
+/// \brief Кодирование одного числа
+/// \param out      - буфер не менее cVarIntMaxBytes32 (cVarIntMaxBytes64) байтов
+/// \return Количество записанных байтов
+size_t varintEncode(uint32_t value, uint8_t * out);
+size_t varintEncode(uint64_t value, uint8_t * out);
+
+/// \brief Декодирование одного числа
+/// \param size     - количество доступных байтов
+/// \return Количество прочитанных байтов, 0 - ошибка
+size_t varintDecode(const uint8_t * in, size_t size, uint32_t & value);
+size_t varintDecode(const uint8_t * in, size_t size, uint64_t & value);
+
+/// \brief Максимальный размер закодированного массива
+inline MLIB_CONSTEXPR size_t varintEncodeBound32(size_t count) { return count * cVarIntMaxBytes32; }
+inline MLIB_CONSTEXPR size_t varintEncodeBound64(size_t count) { return count * cVarIntMaxBytes64; }
+
+/// \brief Кодирование массива (знаковые числа - в zig-zag)
+/// \return Количество записанных байтов
+size_t varintEncodeArray(const uint32_t * in, size_t count, uint8_t * out);
+size_t varintEncodeArray(const int32_t * in, size_t count, uint8_t * out);
+size_t varintEncodeArray(const uint64_t * in, size_t count, uint8_t * out);
+size_t varintEncodeArray(const int64_t * in, size_t count, uint8_t * out);
+
+/// \brief Декодирование count чисел
+/// \param size     - размер закодированных данных в байтах
+/// \return Количество прочитанных байтов, 0 - ошибка
+size_t varintDecodeArray(const uint8_t * in, size_t size, uint32_t * out, size_t count);
+size_t varintDecodeArray(const uint8_t * in, size_t size, int32_t * out, size_t count);
+size_t varintDecodeArray(const uint8_t * in, size_t size, uint64_t * out, size_t count);
+size_t varintDecodeArray(const uint8_t * in, size_t size, int64_t * out, size_t count);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Stream VByte
+
+/// \brief Максимальный размер закодированного массива
+inline MLIB_CONSTEXPR size_t streamVByteEncodeBound(size_t count)
+{   return (count + 3) / 4 + count * 4; }
+
+/// \brief Кодирование массива (знаковые числа - в zig-zag)
+/// \return Количество записанных байтов
+size_t streamVByteEncode(const uint32_t * in, size_t count, uint8_t * out);
+size_t streamVByteEncode(const int32_t * in, size_t count, uint8_t * out);
+
+/// \brief Декодирование count чисел
+/// \return Количество прочитанных байтов, 0 - ошибка
+size_t streamVByteDecode(const uint8_t * in, size_t size, uint32_t * out, size_t count);
+size_t streamVByteDecode(const uint8_t * in, size_t size, int32_t * out, size_t count);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MVARINT_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
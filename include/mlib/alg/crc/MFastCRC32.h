@@ -30,7 +30,9 @@ typedef unsigned long int crc32_t; ///< Для совместимости кро
 
 /// \brief Инициализация (подготовка) переменной для подсчета контрольной суммы
 /// \param crc32    - переменная для подсчета контрольной суммы
-extern inline void crc32Init(crc32_t & crc32){ crc32 = (crc32_t)(~0); }
+/// Начальное значение - 32 единицы: при 64-битном unsigned long (~0) дал бы лишние старшие
+/// единицы, которые сдвиг в crc32Update переносит в результат
+extern inline void crc32Init(crc32_t & crc32){ crc32 = 0xFFFFFFFFul; }
 
 
 /// \brief Расчет контрольной суммы для массива входных данных
@@ -42,7 +44,14 @@ extern void crc32Update(const unsigned char * data, crc32_t length, crc32_t & cr
 /// \brief Получение контрольной суммы в используемой переменной 
 /// \param[IN]  crc32 - переменная для подсчета контрольной суммы (с промежуточным значением)
 /// \param[OUT] crc32 - контрольная сумма рассчитанная по алгоритму CRC-32-IEEE 802.3
-extern inline void crc32Result(crc32_t & crc32){ crc32 = ~crc32; }
+extern inline void crc32Result(crc32_t & crc32){ crc32 = ~crc32 & 0xFFFFFFFFul; }
+
+/// \brief Контрольная сумма строки "123456789" (check по каталогу CRC, как у zlib crc32)
+const crc32_t cCrc32Check = 0xCBF43926ul;
+
+/// \brief Проверка реализации по известному значению cCrc32Check
+/// \return false - расчет не совпадает с CRC-32-IEEE 802.3
+extern bool crc32SelfTest();
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 MLIB_END_NAMESPACE
 ////////////////////////////////////////////////////////////////////////////////////////////////////
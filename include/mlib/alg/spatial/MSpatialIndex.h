@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MSpatialIndex.h
+/// @brief Пространственный индекс точек на плоскости: равномерная сетка в порядке Мортона
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Координаты точек квантуются в ячейки равномерной сетки, ячейке ставится в соответствие
+/// код Мортона (Z-порядок, чередование битов номеров столбца и строки, PDEP при наличии BMI2).
+/// Точки сортируются по коду поразрядной сортировкой и хранятся раздельными массивами x, y
+/// в этом порядке, поэтому точки одной ячейки и соседних ячеек лежат в памяти рядом.
+/// Хранятся только непустые ячейки (таблица кодов и начал), поиск ячейки - двоичный; если
+/// ячеек сетки не больше 4N, дополнительно строится прямая таблица ячеек сетки.
+///
+/// Перестроение - O(N) без выделения памяти после первого вызова, его можно выполнять
+/// на каждом цикле обработки. Поиск в радиусе перебирает ячейки квадрата, описанного
+/// вокруг круга; поиск k ближайших - кольца ячеек вокруг ячейки запроса, пока расстояние
+/// до следующего кольца не превысит k-е найденное. Если ячеек квадрата или колец больше,
+/// чем непустых ячеек, просматриваются непустые ячейки подряд, поэтому время запроса
+/// не больше O(N) при любом расположении точек.
+///
+/// Размер ячейки задается в единицах координат; лучше всего - порядка радиуса запросов.
+/// При нулевом размере он подбирается при перестроении так, чтобы на ячейку приходилось
+/// около двух точек. Если сетка не помещается в 2^30 ячеек по оси, ячейка увеличивается.
+///
+/// Точки с NaN и Inf в индекс не попадают. Индексы точек - номера во входных массивах
+/// (не больше 2^32 - 2 точек).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MSPATIALINDEX_H
+#define MSPATIALINDEX_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "../../core/MGlobal.h"
+#include "../../core/MBitOps.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Коды Мортона
+
+namespace detail {
+
+/// Разнесение 32 битов в четные разряды 64-битного слова
+inline uint64_t mortonSpread(uint32_t v)
+{
+    uint64_t x = v;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+    x = (x | (x << 8))  & 0x00FF00FF00FF00FFull;
+    x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0Full;
+    x = (x | (x << 2))  & 0x3333333333333333ull;
+    x = (x | (x << 1))  & 0x5555555555555555ull;
+    return x;
+}
+
+/// Сбор четных разрядов в младшие 32 бита
+inline uint32_t mortonCompact(uint64_t x)
+{
+    x &= 0x5555555555555555ull;
+    x = (x | (x >> 1))  & 0x3333333333333333ull;
+    x = (x | (x >> 2))  & 0x0F0F0F0F0F0F0F0Full;
+    x = (x | (x >> 4))  & 0x00FF00FF00FF00FFull;
+    x = (x | (x >> 8))  & 0x0000FFFF0000FFFFull;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+    return static_cast<uint32_t>(x);
+}
+
+} // namespace detail
+
+/// \brief Код Мортона: биты x - в четных разрядах, биты y - в нечетных
+inline uint64_t mortonEncode2(uint32_t x, uint32_t y)
+{
+#if defined(MLIB_ISA_BMI2) && defined(MLIB_ARCH_X86_64)
+    return bits::pdep<uint64_t>(x, 0x5555555555555555ull) | bits::pdep<uint64_t>(y, 0xAAAAAAAAAAAAAAAAull);
+#else
+    return detail::mortonSpread(x) | (detail::mortonSpread(y) << 1);
+#endif
+}
+
+/// \brief Разбор кода Мортона на x и y
+inline void mortonDecode2(uint64_t code, uint32_t & x, uint32_t & y)
+{
+#if defined(MLIB_ISA_BMI2) && defined(MLIB_ARCH_X86_64)
+    x = static_cast<uint32_t>(bits::pext<uint64_t>(code, 0x5555555555555555ull));
+    y = static_cast<uint32_t>(bits::pext<uint64_t>(code, 0xAAAAAAAAAAAAAAAAull));
+#else
+    x = detail::mortonCompact(code);
+    y = detail::mortonCompact(code >> 1);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Индекс точек плоскости для поиска в радиусе и k ближайших (float, double)
+template <typename _Ty>
+class MSpatialIndex2
+{
+public:
+    typedef _Ty value_type;
+
+    /// \brief Индекс отсутствующей точки в результатах поиска
+    static MLIB_CONSTEXPR uint32_t invalidIndex() { return 0xFFFFFFFFu; }
+
+    /// \param cellSize - размер ячейки сетки, 0 - подбирается по плотности точек
+    explicit MSpatialIndex2(_Ty cellSize = 0);
+
+    /// \brief Размер ячейки для следующих перестроений (0 - автоматически)
+    inline void setCellSize(_Ty cellSize) { m_cellSize = cellSize; }
+    inline _Ty cellSize() const { return m_cellSize; }
+    /// \brief Размер ячейки, выбранный при последнем перестроении
+    inline _Ty effectiveCellSize() const { return m_cell; }
+
+    /// \brief Перестроение индекса по массивам координат
+    void rebuild(const _Ty * x, const _Ty * y, size_t count);
+
+    void clear();
+
+    /// \brief Количество проиндексированных точек
+    inline size_t size() const { return m_id.size(); }
+    inline bool isEmpty() const { return m_id.empty(); }
+    /// \brief Количество непустых ячеек
+    inline size_t cellCount() const { return m_cellCode.size(); }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Одиночные запросы
+
+    /// \brief Точки на расстоянии не больше r от (x, y), порядок не определен
+    /// \param out - индексы добавляются в конец
+    /// \return Количество добавленных индексов
+    size_t queryRadius(_Ty x, _Ty y, _Ty r, std::vector<uint32_t> & out) const;
+
+    /// \brief k ближайших к (x, y) точек по возрастанию расстояния
+    /// \param indices - k индексов, недостающие - invalidIndex()
+    /// \param dist2   - k квадратов расстояний, недостающие - бесконечность (может быть 0)
+    /// \return Количество найденных точек, min(k, size())
+    size_t queryKNearest(_Ty x, _Ty y, size_t k, uint32_t * indices, _Ty * dist2) const;
+
+    /// \brief Ближайшая к (x, y) точка, invalidIndex() для пустого индекса
+    inline uint32_t queryNearest(_Ty x, _Ty y, _Ty * dist2 = 0) const
+    {
+        uint32_t index;
+        queryKNearest(x, y, 1, &index, dist2);
+        return index;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Пакетные запросы
+
+    /// \brief Поиск в радиусе для count точек запроса
+    /// \param offsets - count + 1 смещений: результаты запроса i - indices[offsets[i] .. offsets[i + 1])
+    void queryRadius(const _Ty * x, const _Ty * y, size_t count, _Ty r,
+                     std::vector<size_t> & offsets, std::vector<uint32_t> & indices) const;
+
+    /// \brief k ближайших для count точек запроса
+    /// \param indices, dist2 - по k значений на запрос подряд (dist2 может быть 0)
+    void queryKNearest(const _Ty * x, const _Ty * y, size_t count, size_t k,
+                       uint32_t * indices, _Ty * dist2) const;
+
+    /// \brief Ближайшая точка для count точек запроса
+    inline void queryNearest(const _Ty * x, const _Ty * y, size_t count,
+                             uint32_t * indices, _Ty * dist2 = 0) const
+    {   queryKNearest(x, y, count, 1, indices, dist2); }
+
+private:
+    /// Диапазон ячеек [lo, hi] оси, пересекающийся с [a, b]; false - не пересекается
+    bool cellRange(_Ty a, _Ty b, _Ty origin, uint32_t n, uint32_t & lo, uint32_t & hi) const;
+    /// Номер непустой ячейки или cellCount()
+    size_t findCell(uint32_t cx, uint32_t cy) const;
+
+    _Ty m_cellSize;                     ///< Заданный размер ячейки
+    _Ty m_cell;                         ///< Размер ячейки последнего перестроения
+    _Ty m_invCell;
+    _Ty m_originX;                      ///< Угол сетки (минимум координат)
+    _Ty m_originY;
+    uint32_t m_gridW;                   ///< Размер сетки в ячейках
+    uint32_t m_gridH;
+    _Ty m_slack;                        ///< Запас на погрешность отнесения точки к ячейке
+
+    std::vector<_Ty> m_x;               ///< Координаты точек в порядке кодов
+    std::vector<_Ty> m_y;
+    std::vector<uint32_t> m_id;         ///< Исходные индексы точек
+    std::vector<uint64_t> m_cellCode;   ///< Коды непустых ячеек по возрастанию
+    std::vector<uint32_t> m_cellStart;  ///< Начала ячеек в m_x, m_y, m_id (+ конец)
+    std::vector<uint32_t> m_cellTable;  ///< Номера непустых ячеек по строкам сетки (плотная сетка)
+
+    // Буферы поразрядной сортировки
+    std::vector<uint64_t> m_keys;
+    std::vector<uint64_t> m_keysTmp;
+    std::vector<uint32_t> m_order;
+    std::vector<uint32_t> m_orderTmp;
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MSPATIALINDEX_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MBam.h
+/// @brief Двоичное представление угла (BAM, binary angular measurement)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Угол хранится беззнаковым целым, полный оборот равен 2^N (N = 16 или 32), т.е. младший
+/// разряд MBam16 - 360/65536 градуса, MBam32 - 360/2^32 градуса. Сложение и вычитание углов
+/// выполняются по модулю оборота за счет переполнения, без fmod и ветвлений.
+///
+/// Знаковое представление тех же битов (signedBits) - угол в диапазоне [-ПИ, ПИ).
+///
+/// Преобразования из целых градусов и т.д. выполняются только в целых числах с округлением
+/// к ближайшему, из вещественных радиан/градусов/т.д. - с округлением к ближайшему и
+/// сокращением по модулю оборота (NaN и Inf дают 0).
+///
+/// sin/cos вычисляются по таблице четверти периода (256 отсчетов Q15) с линейной интерполяцией
+/// по младшим битам угла, только целочисленные операции. Погрешность не более 4e-5.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MBAM_H
+#define MBAM_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMath.h"
+#include <cstdint>
+#include <type_traits>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief sin угла в формате 32-битного BAM, результат в Q15 (32767 ~ 1.0)
+int16_t bamSinQ15(uint32_t angle);
+
+/// \brief cos угла в формате 32-битного BAM, результат в Q15
+inline int16_t bamCosQ15(uint32_t angle)
+{   return bamSinQ15(angle + 0x40000000u); }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Угол в двоичном представлении
+/// \param _Ty - uint16_t или uint32_t
+template <typename _Ty>
+class MBam
+{
+public:
+    typedef _Ty                                 value_type;
+    typedef typename std::make_signed<_Ty>::type signed_type;
+
+    static const unsigned cBits = sizeof(_Ty) * 8;  ///< Разрядность
+
+    MLIB_CONSTEXPR MBam() : m_bits(0) {}
+
+    /// \brief Угол из двоичного представления
+    static MLIB_CONSTEXPR MBam fromBits(_Ty bits)
+    {   return MBam(bits, 0); }
+
+    /// \brief Двоичное представление, [0, 2ПИ)
+    MLIB_CONSTEXPR _Ty bits() const { return m_bits; }
+
+    /// \brief Знаковое представление, [-ПИ, ПИ)
+    MLIB_CONSTEXPR signed_type signedBits() const
+    {   return static_cast<signed_type>(m_bits); }
+
+    //----------------------------------------------------------------------------------------------
+    // Преобразование из целых единиц (без вещественной арифметики)
+
+    /// \brief Угол из целого числа градусов
+    static MBam fromDeg(int32_t degrees)
+    {   return fromUnits(degrees, 360); }
+
+    /// \brief Угол из целого числа т.д. (6000 на оборот)
+    static MBam fromTd(int32_t td)
+    {   return fromUnits(td, 6000); }
+
+    /// \brief Целое число градусов, [0, 360)
+    int32_t toDegInt() const { return toUnits(360); }
+
+    /// \brief Целое число т.д., [0, 6000)
+    int32_t toTdInt() const { return toUnits(6000); }
+
+    //----------------------------------------------------------------------------------------------
+    // Преобразование из вещественных единиц
+
+    static MBam fromRad(float value)  { return fromScaled(value * (cTurn() / c2piDbl())); }
+    static MBam fromRad(double value) { return fromScaled(value * (cTurn() / c2piDbl())); }
+    static MBam fromDeg(float value)  { return fromScaled(value * (cTurn() / 360.0)); }
+    static MBam fromDeg(double value) { return fromScaled(value * (cTurn() / 360.0)); }
+    static MBam fromTd(float value)   { return fromScaled(value * (cTurn() / 6000.0)); }
+    static MBam fromTd(double value)  { return fromScaled(value * (cTurn() / 6000.0)); }
+
+    /// \brief Радианы, [0, 2ПИ)
+    template <typename _Fp = double>
+    MLIB_CONSTEXPR _Fp toRad() const
+    {   return static_cast<_Fp>(m_bits * (c2piDbl() / cTurn())); }
+
+    /// \brief Радианы, [-ПИ, ПИ)
+    template <typename _Fp = double>
+    MLIB_CONSTEXPR _Fp toRadSigned() const
+    {   return static_cast<_Fp>(signedBits() * (c2piDbl() / cTurn())); }
+
+    /// \brief Градусы, [0, 360)
+    template <typename _Fp = double>
+    MLIB_CONSTEXPR _Fp toDeg() const
+    {   return static_cast<_Fp>(m_bits * (360.0 / cTurn())); }
+
+    /// \brief Градусы, [-180, 180)
+    template <typename _Fp = double>
+    MLIB_CONSTEXPR _Fp toDegSigned() const
+    {   return static_cast<_Fp>(signedBits() * (360.0 / cTurn())); }
+
+    /// \brief Т.д., [0, 6000)
+    template <typename _Fp = double>
+    MLIB_CONSTEXPR _Fp toTd() const
+    {   return static_cast<_Fp>(m_bits * (6000.0 / cTurn())); }
+
+    /// \brief Т.д., [-3000, 3000)
+    template <typename _Fp = double>
+    MLIB_CONSTEXPR _Fp toTdSigned() const
+    {   return static_cast<_Fp>(signedBits() * (6000.0 / cTurn())); }
+
+    //----------------------------------------------------------------------------------------------
+    // Смена разрядности
+
+    /// \brief Угол в формате 32-битного BAM
+    MLIB_CONSTEXPR uint32_t bits32() const
+    {   return static_cast<uint32_t>(m_bits) << (32 - cBits); }
+
+    /// \brief Преобразование в MBam другой разрядности (с округлением к ближайшему)
+    template <typename _Other>
+    MLIB_CONSTEXPR MBam<_Other> cast() const
+    {
+        return MBam<_Other>::fromBits(static_cast<_Other>(
+            (bits32() + (MBam<_Other>::cBits < 32 ? 1u << (31 - MBam<_Other>::cBits % 32) : 0u))
+                >> (32 - MBam<_Other>::cBits)));
+    }
+
+    //----------------------------------------------------------------------------------------------
+    // Тригонометрия по таблице
+
+    int16_t sinQ15() const { return bamSinQ15(bits32()); }
+    int16_t cosQ15() const { return bamCosQ15(bits32()); }
+
+    float sin() const { return sinQ15() * (1.0f / 32768.0f); }
+    float cos() const { return cosQ15() * (1.0f / 32768.0f); }
+
+    //----------------------------------------------------------------------------------------------
+    // Арифметика по модулю оборота
+
+    MLIB_CONSTEXPR MBam operator+(MBam other) const
+    {   return MBam(static_cast<_Ty>(m_bits + other.m_bits), 0); }
+
+    MLIB_CONSTEXPR MBam operator-(MBam other) const
+    {   return MBam(static_cast<_Ty>(m_bits - other.m_bits), 0); }
+
+    MLIB_CONSTEXPR MBam operator-() const
+    {   return MBam(static_cast<_Ty>(0u - m_bits), 0); }
+
+    MLIB_CONSTEXPR MBam operator*(int32_t factor) const
+    {   return MBam(static_cast<_Ty>(static_cast<uint32_t>(m_bits) * static_cast<uint32_t>(factor)), 0); }
+
+    MBam & operator+=(MBam other) { m_bits = static_cast<_Ty>(m_bits + other.m_bits); return *this; }
+    MBam & operator-=(MBam other) { m_bits = static_cast<_Ty>(m_bits - other.m_bits); return *this; }
+
+    MLIB_CONSTEXPR bool operator==(MBam other) const { return m_bits == other.m_bits; }
+    MLIB_CONSTEXPR bool operator!=(MBam other) const { return m_bits != other.m_bits; }
+
+private:
+    MLIB_CONSTEXPR MBam(_Ty bits, int) : m_bits(bits) {}
+
+    /// Полный оборот
+    static MLIB_CONSTEXPR double cTurn()
+    {   return static_cast<double>(1ull << cBits); }
+
+    /// value / units оборота, округление к ближайшему
+    static MBam fromUnits(int32_t value, int32_t units)
+    {
+        int64_t t = value % units;
+        if (t < 0)
+            t += units;
+        return MBam(static_cast<_Ty>(((static_cast<uint64_t>(t) << cBits) + units / 2) / units), 0);
+    }
+
+    int32_t toUnits(int32_t units) const
+    {
+        const int32_t v = static_cast<int32_t>((static_cast<uint64_t>(m_bits) * units
+                                                + (1ull << (cBits - 1))) >> cBits);
+        return v == units ? 0 : v;
+    }
+
+    /// value - угол в единицах младшего разряда
+    static MBam fromScaled(double value)
+    {
+        if (!(value - value == 0))
+            return MBam();
+        double r = std::floor(value + 0.5);
+        r -= std::floor(r * (1.0 / cTurn())) * cTurn();
+        return MBam(static_cast<_Ty>(static_cast<uint64_t>(r)), 0);
+    }
+
+    _Ty m_bits;
+};
+
+typedef MBam<uint16_t> MBam16;
+typedef MBam<uint32_t> MBam32;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MBAM_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MBitOps.h
+/// @brief Подсчет и поиск битов, перестановки битов (popcount, clz/ctz, PDEP/PEXT)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// bits::portable - переносимые реализации на чистом C++ (constexpr начиная с C++14).
+/// bits           - быстрые реализации: встроенные функции компилятора и инструкции
+///                  POPCNT/LZCNT/BMI2, если они определены в MPlatformIdentification.h.
+///
+/// Функции принимают беззнаковые целые разрядностью 8, 16, 32 и 64 бита.
+/// clz и ctz от нуля возвращают разрядность типа.
+///
+/// @warning На процессорах AMD до Zen 3 инструкции PDEP/PEXT микрокодовые и медленные.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MBITOPS_H
+#define MBITOPS_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#if defined(MLIB_MSC)
+    #include <intrin.h>
+#endif
+#if defined(MLIB_ISA_BMI2)
+    #include <immintrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace bits {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace portable {
+
+/// \brief Количество единичных битов
+template <typename T>
+inline MLIB_CONSTEXPR14 int popcount(T x)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+    uint64_t v = x;
+    v = v - ((v >> 1) & 0x5555555555555555ull);
+    v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<int>((v * 0x0101010101010101ull) >> 56);
+}
+
+/// \brief Количество старших нулевых битов
+template <typename T>
+inline MLIB_CONSTEXPR14 int clz(T x)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+    const int w = std::numeric_limits<T>::digits;
+    if (x == 0)
+        return w;
+    uint64_t v = x;
+    int n = 0;
+    if (v <= 0x00000000FFFFFFFFull) { n += 32; v <<= 32; }
+    if (v <= 0x0000FFFFFFFFFFFFull) { n += 16; v <<= 16; }
+    if (v <= 0x00FFFFFFFFFFFFFFull) { n += 8;  v <<= 8;  }
+    if (v <= 0x0FFFFFFFFFFFFFFFull) { n += 4;  v <<= 4;  }
+    if (v <= 0x3FFFFFFFFFFFFFFFull) { n += 2;  v <<= 2;  }
+    if (v <= 0x7FFFFFFFFFFFFFFFull) { n += 1; }
+    return n - (64 - w);
+}
+
+/// \brief Количество младших нулевых битов
+template <typename T>
+inline MLIB_CONSTEXPR14 int ctz(T x)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+    if (x == 0)
+        return std::numeric_limits<T>::digits;
+    const T low = static_cast<T>(x & static_cast<T>(0 - x));
+    return popcount(static_cast<T>(low - 1));
+}
+
+/// \brief Обратный порядок битов
+template <typename T>
+inline MLIB_CONSTEXPR14 T reverse(T x)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+    uint64_t v = x;
+    v = ((v >> 1)  & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+    v = ((v >> 2)  & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+    v = ((v >> 4)  & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+    v = ((v >> 8)  & 0x00FF00FF00FF00FFull) | ((v & 0x00FF00FF00FF00FFull) << 8);
+    v = ((v >> 16) & 0x0000FFFF0000FFFFull) | ((v & 0x0000FFFF0000FFFFull) << 16);
+    v = (v >> 32) | (v << 32);
+    return static_cast<T>(v >> (64 - std::numeric_limits<T>::digits));
+}
+
+/// \brief Циклический сдвиг влево
+template <typename T>
+inline MLIB_CONSTEXPR14 T rotl(T x, unsigned n)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+    const unsigned w = std::numeric_limits<T>::digits;
+    n &= w - 1;
+    return n ? static_cast<T>((x << n) | (x >> (w - n))) : x;
+}
+
+/// \brief Циклический сдвиг вправо
+template <typename T>
+inline MLIB_CONSTEXPR14 T rotr(T x, unsigned n)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+    const unsigned w = std::numeric_limits<T>::digits;
+    n &= w - 1;
+    return n ? static_cast<T>((x >> n) | (x << (w - n))) : x;
+}
+
+/// \brief Распределение младших битов src по единичным позициям mask (PDEP)
+template <typename T>
+inline MLIB_CONSTEXPR14 T pdep(T src, T mask)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+    T res = 0;
+    for (T bb = 1; mask != 0; bb = static_cast<T>(bb + bb))
+    {
+        if (src & bb)
+            res = static_cast<T>(res | (mask & static_cast<T>(0 - mask)));
+        mask = static_cast<T>(mask & (mask - 1));
+    }
+    return res;
+}
+
+/// \brief Сбор битов src из единичных позиций mask в младшие разряды (PEXT)
+template <typename T>
+inline MLIB_CONSTEXPR14 T pext(T src, T mask)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+    T res = 0;
+    for (T bb = 1; mask != 0; bb = static_cast<T>(bb + bb))
+    {
+        if (src & mask & static_cast<T>(0 - mask))
+            res = static_cast<T>(res | bb);
+        mask = static_cast<T>(mask & (mask - 1));
+    }
+    return res;
+}
+
+/// \brief Количество разрядов, необходимое для представления числа
+template <typename T>
+inline MLIB_CONSTEXPR14 int bitWidth(T x)
+{   return std::numeric_limits<T>::digits - clz(x); }
+
+} // namespace portable
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Быстрые реализации
+
+// Встроенные функции GCC/Clang вычисляются на этапе компиляции
+#if defined(MLIB_GCC)
+    #define MLIB_BITOPS_CONSTEXPR MLIB_CONSTEXPR14
+#else
+    #define MLIB_BITOPS_CONSTEXPR
+#endif
+
+/// \brief Количество единичных битов
+template <typename T>
+inline MLIB_BITOPS_CONSTEXPR int popcount(T x)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+#if defined(MLIB_GCC)
+    return (sizeof(T) <= 4) ? __builtin_popcount(static_cast<unsigned>(x))
+                            : __builtin_popcountll(static_cast<unsigned long long>(x));
+#elif defined(MLIB_MSC) && defined(MLIB_ISA_POPCNT) && defined(MLIB_ARCH_X86_64)
+    return (sizeof(T) <= 4) ? static_cast<int>(__popcnt(static_cast<unsigned>(x)))
+                            : static_cast<int>(__popcnt64(static_cast<unsigned __int64>(x)));
+#else
+    return portable::popcount(x);
+#endif
+}
+
+/// \brief Количество старших нулевых битов
+template <typename T>
+inline MLIB_BITOPS_CONSTEXPR int clz(T x)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+#if defined(MLIB_GCC)
+    return (x == 0) ? std::numeric_limits<T>::digits
+         : (sizeof(T) <= 4) ? __builtin_clz(static_cast<unsigned>(x)) - (32 - std::numeric_limits<T>::digits)
+                            : __builtin_clzll(static_cast<unsigned long long>(x));
+#elif defined(MLIB_MSC) && defined(MLIB_ARCH_X86_64)
+    unsigned long index = 0;
+    if (!_BitScanReverse64(&index, static_cast<unsigned __int64>(x)))
+        return std::numeric_limits<T>::digits;
+    return std::numeric_limits<T>::digits - 1 - static_cast<int>(index);
+#else
+    return portable::clz(x);
+#endif
+}
+
+/// \brief Количество младших нулевых битов
+template <typename T>
+inline MLIB_BITOPS_CONSTEXPR int ctz(T x)
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "Unsigned integer type required.");
+#if defined(MLIB_GCC)
+    return (x == 0) ? std::numeric_limits<T>::digits
+         : (sizeof(T) <= 4) ? __builtin_ctz(static_cast<unsigned>(x))
+                            : __builtin_ctzll(static_cast<unsigned long long>(x));
+#elif defined(MLIB_MSC) && defined(MLIB_ARCH_X86_64)
+    unsigned long index = 0;
+    if (!_BitScanForward64(&index, static_cast<unsigned __int64>(x)))
+        return std::numeric_limits<T>::digits;
+    return static_cast<int>(index);
+#else
+    return portable::ctz(x);
+#endif
+}
+
+/// \brief Обратный порядок битов
+template <typename T>
+inline MLIB_CONSTEXPR14 T reverse(T x)
+{
+#if defined(__has_builtin)
+    #if __has_builtin(__builtin_bitreverse64)
+    return static_cast<T>(__builtin_bitreverse64(x) >> (64 - std::numeric_limits<T>::digits));
+    #else
+    return portable::reverse(x);
+    #endif
+#else
+    return portable::reverse(x);
+#endif
+}
+
+/// \brief Циклический сдвиг влево (компиляторы распознают шаблон и генерируют rol)
+template <typename T>
+inline MLIB_CONSTEXPR14 T rotl(T x, unsigned n)
+{   return portable::rotl(x, n); }
+
+/// \brief Циклический сдвиг вправо (компиляторы распознают шаблон и генерируют ror)
+template <typename T>
+inline MLIB_CONSTEXPR14 T rotr(T x, unsigned n)
+{   return portable::rotr(x, n); }
+
+/// \brief Распределение младших битов src по единичным позициям mask (PDEP)
+template <typename T>
+inline T pdep(T src, T mask)
+{
+#if defined(MLIB_ISA_BMI2) && defined(MLIB_ARCH_X86_64)
+    return (sizeof(T) <= 4) ? static_cast<T>(_pdep_u32(static_cast<unsigned>(src), static_cast<unsigned>(mask)))
+                            : static_cast<T>(_pdep_u64(static_cast<unsigned long long>(src),
+                                                       static_cast<unsigned long long>(mask)));
+#else
+    return portable::pdep(src, mask);
+#endif
+}
+
+/// \brief Сбор битов src из единичных позиций mask в младшие разряды (PEXT)
+template <typename T>
+inline T pext(T src, T mask)
+{
+#if defined(MLIB_ISA_BMI2) && defined(MLIB_ARCH_X86_64)
+    return (sizeof(T) <= 4) ? static_cast<T>(_pext_u32(static_cast<unsigned>(src), static_cast<unsigned>(mask)))
+                            : static_cast<T>(_pext_u64(static_cast<unsigned long long>(src),
+                                                       static_cast<unsigned long long>(mask)));
+#else
+    return portable::pext(src, mask);
+#endif
+}
+
+/// \brief Количество разрядов, необходимое для представления числа
+template <typename T>
+inline MLIB_BITOPS_CONSTEXPR int bitWidth(T x)
+{   return std::numeric_limits<T>::digits - clz(x); }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Обработка массивов (AVX-512 VPOPCNTDQ, AVX2 или по 64-битным словам)
+
+/// \brief Количество единичных битов в буфере
+/// \param data     - буфер
+/// \param size     - размер буфера в байтах
+uint64_t popcountBuffer(const void * data, size_t size);
+
+/// \brief Расстояние Хэмминга между буферами (количество различающихся битов)
+/// \param size     - размер каждого буфера в байтах
+uint64_t hammingDistance(const void * a, const void * b, size_t size);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace bits
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MBITOPS_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
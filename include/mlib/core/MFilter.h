@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MFilter.h
+/// @brief Потоковые фильтры: КИХ, скользящее среднее, скользящие минимум и максимум
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Все фильтры хранят состояние между вызовами process, поэтому поток можно подавать блоками
+/// любой длины - результат не зависит от разбиения. Допускается in == out.
+///
+/// MFirFilter - y[n] = Σ h[k] x[n - k], k = 0 .. N - 1, история до первого отсчета нулевая.
+/// Внутренний цикл векторизован по отсчетам (SSE2/AVX2/AVX-512F): коэффициент размножается
+/// по регистру и умножается на сдвинутые загрузки входа, четыре независимых аккумулятора.
+///
+/// MMovingAverage - среднее последних N отсчетов за O(1) на отсчет (скользящая сумма в double,
+/// пересчитывается заново на каждом обороте кольцевого буфера, чтобы не накапливать ошибку).
+/// Пока отсчетов меньше N - среднее имеющихся.
+///
+/// MMovingMin / MMovingMax - экстремум последних N отсчетов за O(1) в среднем (монотонная
+/// очередь Лемира). Для NaN результат не определен.
+///
+/// MFilterBank - набор одинаковых фильтров для многих каналов, данные - раздельные массивы
+/// каналов (SoA).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MFILTER_H
+#define MFILTER_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief КИХ-фильтр с произвольным числом коэффициентов (float, double)
+template <typename _Ty>
+class MFirFilter
+{
+public:
+    typedef _Ty value_type;
+
+    /// \param taps  - коэффициенты h[0] .. h[count - 1]
+    /// \param count - число коэффициентов, не меньше 1
+    MFirFilter(const _Ty * taps, size_t count);
+
+    /// \brief Обнуление истории
+    void reset();
+
+    inline size_t tapCount() const { return m_taps.size(); }
+    /// \brief Коэффициент h[k]
+    inline _Ty tap(size_t k) const { return m_taps[m_taps.size() - 1 - k]; }
+
+    /// \brief Фильтрация блока
+    void process(const _Ty * in, _Ty * out, size_t count);
+
+    /// \brief Фильтрация одного отсчета
+    inline _Ty process(_Ty x)
+    {
+        _Ty y;
+        process(&x, &y, 1);
+        return y;
+    }
+
+private:
+    std::vector<_Ty> m_taps;    ///< Коэффициенты в обратном порядке: h[N - 1] .. h[0]
+    std::vector<_Ty> m_buffer;  ///< История (N - 1 отсчет) и текущая порция входа
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Скользящее среднее по окну из N отсчетов
+template <typename _Ty>
+class MMovingAverage
+{
+public:
+    typedef _Ty value_type;
+
+    /// \param window - длина окна, не меньше 1
+    explicit MMovingAverage(size_t window);
+
+    void reset();
+
+    inline size_t window() const { return m_ring.size(); }
+
+    /// \brief Добавление отсчета, результат - среднее окна
+    inline _Ty process(_Ty x)
+    {
+        const size_t n = m_ring.size();
+        if (m_filled == n)
+            m_sum -= m_ring[m_pos];
+        else
+            ++m_filled;
+        m_ring[m_pos] = x;
+        m_sum += x;
+        if (++m_pos == n)
+            wrap();
+        return static_cast<_Ty>(m_sum / static_cast<double>(m_filled));
+    }
+
+    void process(const _Ty * in, _Ty * out, size_t count);
+
+    /// \brief Текущее среднее (0 до первого отсчета)
+    inline _Ty value() const
+    {   return m_filled > 0 ? static_cast<_Ty>(m_sum / static_cast<double>(m_filled)) : _Ty(0); }
+
+private:
+    /// Конец оборота кольцевого буфера: точный пересчет суммы
+    void wrap();
+
+    std::vector<_Ty> m_ring;
+    size_t m_pos;
+    size_t m_filled;
+    double m_sum;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Экстремум по окну из N отсчетов
+/// \param _IsMax - true - максимум, false - минимум
+template <typename _Ty, bool _IsMax>
+class MMovingExtremum
+{
+public:
+    typedef _Ty value_type;
+
+    /// \param window - длина окна, не меньше 1
+    explicit MMovingExtremum(size_t window);
+
+    void reset();
+
+    inline size_t window() const { return m_values.size(); }
+
+    /// \brief Добавление отсчета, результат - экстремум окна
+    _Ty process(_Ty x);
+
+    void process(const _Ty * in, _Ty * out, size_t count);
+
+    /// \brief Текущий экстремум (0 до первого отсчета)
+    inline _Ty value() const { return m_size > 0 ? m_values[m_head] : _Ty(0); }
+
+private:
+    // Монотонная очередь в кольцевом буфере: значения и номера отсчетов
+    std::vector<_Ty> m_values;
+    std::vector<uint64_t> m_index;
+    size_t m_head;
+    size_t m_size;
+    uint64_t m_count;
+};
+
+template <typename _Ty>
+class MMovingMin : public MMovingExtremum<_Ty, false>
+{
+public:
+    explicit MMovingMin(size_t window) : MMovingExtremum<_Ty, false>(window) {}
+};
+
+template <typename _Ty>
+class MMovingMax : public MMovingExtremum<_Ty, true>
+{
+public:
+    explicit MMovingMax(size_t window) : MMovingExtremum<_Ty, true>(window) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Набор одинаковых фильтров для многоканального потока
+///
+/// \param _Filter - MFirFilter, MMovingAverage, MMovingMin, MMovingMax
+template <class _Filter>
+class MFilterBank
+{
+public:
+    typedef typename _Filter::value_type value_type;
+
+    /// \param channels  - число каналов
+    /// \param prototype - фильтр, копия которого создается для каждого канала
+    MFilterBank(size_t channels, const _Filter & prototype)
+        : m_filters(channels, prototype) {}
+
+    inline size_t channels() const { return m_filters.size(); }
+
+    inline _Filter & channel(size_t i)             { return m_filters[i]; }
+    inline const _Filter & channel(size_t i) const { return m_filters[i]; }
+
+    void reset()
+    {
+        for (size_t i = 0; i < m_filters.size(); ++i)
+            m_filters[i].reset();
+    }
+
+    /// \brief Фильтрация блока всех каналов
+    /// \param in, out - массивы указателей на данные каналов, count - отсчетов в каждом канале
+    void process(const value_type * const * in, value_type * const * out, size_t count)
+    {
+        for (size_t i = 0; i < m_filters.size(); ++i)
+            m_filters[i].process(in[i], out[i], count);
+    }
+
+private:
+    std::vector<_Filter> m_filters;
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MFILTER_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MFloat16.h
+/// @brief Массовое преобразование float <-> float16_t / bfloat16_t
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Для хранения больших массивов значений, которым достаточно 16-битной точности
+/// (вдвое меньше памяти и пропускной способности). Результат совпадает со скалярными
+/// преобразованиями float16_t/bfloat16_t (округление к ближайшему четному).
+///
+/// binary16: F16C (vcvtps2ph, vcvtph2ps), иначе SSE2 или скалярный вариант.
+/// bfloat16: AVX2 или SSE2, иначе скалярный вариант.
+/// Выравнивание массивов не требуется.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MFLOAT16_H
+#define MFLOAT16_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MTypes.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Преобразование массива float -> binary16
+void toFloat16(const float * in, float16_t * out, size_t count);
+
+/// \brief Преобразование массива binary16 -> float
+void fromFloat16(const float16_t * in, float * out, size_t count);
+
+/// \brief Преобразование массива float -> bfloat16
+void toBfloat16(const float * in, bfloat16_t * out, size_t count);
+
+/// \brief Преобразование массива bfloat16 -> float
+void fromBfloat16(const bfloat16_t * in, float * out, size_t count);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MFLOAT16_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MFloatBits.h
+/// @brief Битовое представление чисел с плавающей точкой (binary32/binary64)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// ULP (unit in the last place) - расстояние между соседними представимыми числами.
+/// Сравнение в ULP не зависит от порядка величины, в отличие от isEqual() с абсолютной
+/// погрешностью. Расстояние считается через монотонное отображение битов числа в целое:
+/// соседние числа отличаются на 1, +0 и -0 совпадают. NaN не равен ничему.
+///
+/// Пакетные проверки массивов (NaN/Inf, сравнение в ULP) - SSE2/AVX2, иначе скалярные.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MFLOATBITS_H
+#define MFLOATBITS_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MTypes.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Упорядоченное целочисленное представление
+
+/// \brief Монотонное отображение float в int32_t (a < b <=> ordered(a) < ordered(b))
+inline int32_t floatToOrdered(float value)
+{
+    binary32 f;
+    f.f = value;
+    const int32_t i = static_cast<int32_t>(f.u);
+    const int32_t m = i >> 31;
+    return (i ^ static_cast<int32_t>(static_cast<uint32_t>(m) >> 1)) - m;
+}
+
+/// \brief Монотонное отображение double в int64_t
+inline int64_t floatToOrdered(double value)
+{
+    binary64 f;
+    f.f = value;
+    const int64_t i = static_cast<int64_t>(f.u);
+    const int64_t m = i >> 63;
+    return (i ^ static_cast<int64_t>(static_cast<uint64_t>(m) >> 1)) - m;
+}
+
+/// \brief Расстояние в ULP между двумя числами
+/// \return Количество представимых чисел между a и b, для NaN - максимальное значение типа
+inline uint32_t ulpDistance(float a, float b)
+{
+    if (a != a || b != b)
+        return 0xFFFFFFFFu;
+    const int32_t oa = floatToOrdered(a);
+    const int32_t ob = floatToOrdered(b);
+    return oa > ob ? static_cast<uint32_t>(oa) - static_cast<uint32_t>(ob)
+                   : static_cast<uint32_t>(ob) - static_cast<uint32_t>(oa);
+}
+
+inline uint64_t ulpDistance(double a, double b)
+{
+    if (a != a || b != b)
+        return 0xFFFFFFFFFFFFFFFFull;
+    const int64_t oa = floatToOrdered(a);
+    const int64_t ob = floatToOrdered(b);
+    return oa > ob ? static_cast<uint64_t>(oa) - static_cast<uint64_t>(ob)
+                   : static_cast<uint64_t>(ob) - static_cast<uint64_t>(oa);
+}
+
+/// \brief Проверка аргументов на равенство с точностью до maxUlps представимых чисел
+inline bool isEqualUlps(float a, float b, uint32_t maxUlps)
+{   return ulpDistance(a, b) <= maxUlps && a == a; }
+
+inline bool isEqualUlps(double a, double b, uint64_t maxUlps)
+{   return ulpDistance(a, b) <= maxUlps && a == a; }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Порядок и мантисса
+
+/// \brief Быстрый аналог std::frexp: value = mantissa * 2^exp, |mantissa| в [0.5, 1)
+/// Для 0, Inf и NaN возвращается value, exp = 0
+inline float fastFrexp(float value, int & exp)
+{
+    binary32 f;
+    f.f = value;
+    int e = static_cast<int>((f.u >> 23) & 0xFF);
+    if (e == 0)
+    {
+        if ((f.u & 0x7FFFFFFFu) == 0)
+        {
+            exp = 0;
+            return value;
+        }
+        f.f *= 33554432.0f;     // 2^25, нормализация денормализованного числа
+        e = static_cast<int>((f.u >> 23) & 0xFF) - 25;
+    }
+    else if (e == 0xFF)
+    {
+        exp = 0;
+        return value;
+    }
+    exp = e - 126;
+    f.u = (f.u & 0x807FFFFFu) | (126u << 23);
+    return f.f;
+}
+
+inline double fastFrexp(double value, int & exp)
+{
+    binary64 f;
+    f.f = value;
+    int e = static_cast<int>((f.u >> 52) & 0x7FF);
+    if (e == 0)
+    {
+        if ((f.u & 0x7FFFFFFFFFFFFFFFull) == 0)
+        {
+            exp = 0;
+            return value;
+        }
+        f.f *= 18014398509481984.0;     // 2^54
+        e = static_cast<int>((f.u >> 52) & 0x7FF) - 54;
+    }
+    else if (e == 0x7FF)
+    {
+        exp = 0;
+        return value;
+    }
+    exp = e - 1022;
+    f.u = (f.u & 0x800FFFFFFFFFFFFFull) | (1022ull << 52);
+    return f.f;
+}
+
+/// \brief 2^exp для exp в диапазоне нормализованных чисел
+inline float pow2Flt(int exp)
+{
+    binary32 f;
+    f.u = static_cast<uint32_t>(exp + 127) << 23;
+    return f.f;
+}
+
+inline double pow2Dbl(int exp)
+{
+    binary64 f;
+    f.u = static_cast<uint64_t>(exp + 1023) << 52;
+    return f.f;
+}
+
+/// \brief Быстрый аналог std::ldexp: value * 2^exp (одно округление, как у ldexp)
+inline float fastLdexp(float value, int exp)
+{
+    if (exp > 127)
+    {
+        value *= pow2Flt(127);
+        exp -= 127;
+        if (exp > 127)
+        {
+            value *= pow2Flt(127);
+            exp -= 127;
+            if (exp > 127)
+                exp = 127;
+        }
+    }
+    else if (exp < -126)
+    {
+        // Промежуточный результат остается нормализованным, округляется только последнее умножение
+        value *= pow2Flt(-126 + 24);
+        exp += 126 - 24;
+        if (exp < -126)
+        {
+            value *= pow2Flt(-126 + 24);
+            exp += 126 - 24;
+            if (exp < -126)
+                exp = -126;
+        }
+    }
+    return value * pow2Flt(exp);
+}
+
+inline double fastLdexp(double value, int exp)
+{
+    if (exp > 1023)
+    {
+        value *= pow2Dbl(1023);
+        exp -= 1023;
+        if (exp > 1023)
+        {
+            value *= pow2Dbl(1023);
+            exp -= 1023;
+            if (exp > 1023)
+                exp = 1023;
+        }
+    }
+    else if (exp < -1022)
+    {
+        value *= pow2Dbl(-1022 + 53);
+        exp += 1022 - 53;
+        if (exp < -1022)
+        {
+            value *= pow2Dbl(-1022 + 53);
+            exp += 1022 - 53;
+            if (exp < -1022)
+                exp = -1022;
+        }
+    }
+    return value * pow2Dbl(exp);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Пакетные проверки массивов
+
+/// \brief Есть ли в массиве NaN или бесконечность
+bool anyNonFinite(const float * data, size_t count);
+bool anyNonFinite(const double * data, size_t count);
+
+/// \brief Количество NaN и бесконечностей в массиве
+size_t countNonFinite(const float * data, size_t count);
+size_t countNonFinite(const double * data, size_t count);
+
+/// \brief Все ли элементы массива отличаются от соответствующих элементов reference
+/// не более чем на maxUlps (NaN - всегда отличие)
+bool allWithinUlps(const float * data, const float * reference, size_t count, uint32_t maxUlps);
+bool allWithinUlps(const double * data, const double * reference, size_t count, uint64_t maxUlps);
+
+/// \brief Все ли элементы массива отличаются от значения reference не более чем на maxUlps
+bool allWithinUlps(const float * data, float reference, size_t count, uint32_t maxUlps);
+bool allWithinUlps(const double * data, double reference, size_t count, uint64_t maxUlps);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MFLOATBITS_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
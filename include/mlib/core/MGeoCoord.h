@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MGeoCoord.h
+/// @brief Преобразования координат WGS-84: геодезические, ECEF, местные ENU
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Геодезические координаты - широта и долгота в радианах, высота над эллипсоидом в метрах.
+/// ECEF (Earth-Centered, Earth-Fixed) - прямоугольные координаты в метрах с началом в центре
+/// Земли. ENU (East-North-Up) - местная система с началом в точке MEnuFrame: восток, север,
+/// вверх по нормали к эллипсоиду.
+///
+/// Массивы раздельные (SoA), допускается совпадение входных и выходных массивов.
+/// Вычисления выполняются в double и для float-версий (float - только формат хранения):
+/// разность ECEF-координат порядка 6e6 м в float теряла бы метры.
+///
+/// Обратное преобразование ECEF -> геодезические - две итерации метода Боуринга без
+/// тригонометрических функций (кроме двух atan2). Погрешность для высот от -1e5 до 1e7 м
+/// относительно точного решения: широта и долгота не более 1e-15 рад, высота не более 1e-8 м.
+///
+/// Векторизация - SSE2/AVX2/AVX-512F (ядра MMathBatch с точностью AccuracyHigh), без них -
+/// скалярный вариант того же алгоритма. Для Inf, NaN и углов вне |x| < 2^24 результат - NaN,
+/// высота ограничена только конечностью.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MGEOCOORD_H
+#define MGEOCOORD_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMatrix.h"
+#include <cstddef>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace geo {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Эллипсоид WGS-84
+
+/// \brief Большая полуось, м
+inline MLIB_CONSTEXPR double cWgs84A()
+{   return 6378137.0; }
+
+/// \brief Сжатие
+inline MLIB_CONSTEXPR double cWgs84F()
+{   return 1.0 / 298.257223563; }
+
+/// \brief Малая полуось, м
+inline MLIB_CONSTEXPR double cWgs84B()
+{   return cWgs84A() * (1.0 - cWgs84F()); }
+
+/// \brief Квадрат первого эксцентриситета
+inline MLIB_CONSTEXPR double cWgs84E2()
+{   return cWgs84F() * (2.0 - cWgs84F()); }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Местная система координат ENU
+///
+/// Начало координат в ECEF и матрица поворота ECEF -> ENU вычисляются один раз в конструкторе.
+class MEnuFrame
+{
+public:
+    /// \brief Конструктор
+    /// \param lat, lon - геодезические широта и долгота начала координат, рад
+    /// \param height   - высота начала координат над эллипсоидом, м
+    MEnuFrame(double lat, double lon, double height);
+
+    inline double lat() const    { return m_lat; }
+    inline double lon() const    { return m_lon; }
+    inline double height() const { return m_height; }
+
+    /// \brief Начало координат в ECEF, м
+    inline const math::MVec3d & origin() const { return m_origin; }
+
+    /// \brief Матрица поворота ECEF -> ENU (строки - орты E, N, U в ECEF)
+    inline const math::MMat3d & rotation() const { return m_rotation; }
+
+private:
+    double m_lat;
+    double m_lon;
+    double m_height;
+    math::MVec3d m_origin;
+    math::MMat3d m_rotation;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Геодезические <-> ECEF
+
+/// \brief Геодезические координаты в ECEF
+void geodeticToEcef(const float * lat, const float * lon, const float * height,
+                    float * x, float * y, float * z, size_t count);
+void geodeticToEcef(const double * lat, const double * lon, const double * height,
+                    double * x, double * y, double * z, size_t count);
+
+/// \brief ECEF в геодезические координаты
+void ecefToGeodetic(const float * x, const float * y, const float * z,
+                    float * lat, float * lon, float * height, size_t count);
+void ecefToGeodetic(const double * x, const double * y, const double * z,
+                    double * lat, double * lon, double * height, size_t count);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// ECEF <-> ENU
+
+/// \brief ECEF в местную систему
+void ecefToEnu(const MEnuFrame & frame, const float * x, const float * y, const float * z,
+               float * e, float * n, float * u, size_t count);
+void ecefToEnu(const MEnuFrame & frame, const double * x, const double * y, const double * z,
+               double * e, double * n, double * u, size_t count);
+
+/// \brief Местная система в ECEF
+void enuToEcef(const MEnuFrame & frame, const float * e, const float * n, const float * u,
+               float * x, float * y, float * z, size_t count);
+void enuToEcef(const MEnuFrame & frame, const double * e, const double * n, const double * u,
+               double * x, double * y, double * z, size_t count);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Геодезические <-> ENU (за один проход, без промежуточных массивов ECEF)
+
+/// \brief Геодезические координаты в местную систему
+void geodeticToEnu(const MEnuFrame & frame, const float * lat, const float * lon, const float * height,
+                   float * e, float * n, float * u, size_t count);
+void geodeticToEnu(const MEnuFrame & frame, const double * lat, const double * lon, const double * height,
+                   double * e, double * n, double * u, size_t count);
+
+/// \brief Местная система в геодезические координаты
+void enuToGeodetic(const MEnuFrame & frame, const float * e, const float * n, const float * u,
+                   float * lat, float * lon, float * height, size_t count);
+void enuToGeodetic(const MEnuFrame & frame, const double * e, const double * n, const double * u,
+                   double * lat, double * lon, double * height, size_t count);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace geo
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MGEOCOORD_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MGeodesy.h
+/// @brief Расстояние и начальный азимут по дуге большого круга (сфера), пакетные функции
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Координаты - широта и долгота в радианах, массивы раздельные (SoA). Расстояние - в единицах
+/// радиуса (по умолчанию метры, средний радиус Земли), для морских миль - nauticalMileToMeter()
+/// из MMath.h или radius = cEarthRadius() / 1852. Азимут - от направления на север по часовой
+/// стрелке, [0, 2ПИ).
+///
+/// Методы:
+/// - GeoHaversine - формула гаверсинусов, точна на всех расстояниях;
+/// - GeoSphericalCosines - сферическая теорема косинусов, на малых расстояниях (единицы метров
+///   для double, километры для float) теряет точность из-за acos около 1;
+/// - GeoEquirectangular - плоское приближение (долгота масштабируется косинусом средней
+///   широты), быстрее остальных, погрешность растет с расстоянием и широтой (около 0.1% на
+///   100 км в средних широтах), не применимо около полюсов.
+///
+/// Азимут для GeoHaversine и GeoSphericalCosines вычисляется точно, для GeoEquirectangular -
+/// в том же плоском приближении.
+///
+/// Функции "одна точка - N точек" считают sin/cos первой точки один раз. Векторизация -
+/// SSE2/AVX2/AVX-512F (ядра MMathBatch с точностью AccuracyHigh), без них - скалярный вариант
+/// того же алгоритма. Координаты вне |x| < 2048 (float) и 2^24 (double), Inf и NaN
+/// обрабатываются скалярными функциями std.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MGEODESY_H
+#define MGEODESY_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMath.h"
+#include <cstddef>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace geo {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Средний радиус Земли (IUGG), м
+inline MLIB_CONSTEXPR double cEarthRadius()
+{   return 6371008.8; }
+
+/// \brief Метод вычисления расстояния
+enum GeoMethod
+{
+    GeoHaversine,           ///< Формула гаверсинусов
+    GeoSphericalCosines,    ///< Сферическая теорема косинусов
+    GeoEquirectangular      ///< Плоское приближение
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Одна точка (lat0, lon0) - N точек
+
+/// \brief Расстояния от точки до массива точек
+void distance(float lat0, float lon0, const float * lat, const float * lon, float * out, size_t count,
+              GeoMethod method = GeoHaversine, float radius = static_cast<float>(cEarthRadius()));
+void distance(double lat0, double lon0, const double * lat, const double * lon, double * out, size_t count,
+              GeoMethod method = GeoHaversine, double radius = cEarthRadius());
+
+/// \brief Начальные азимуты от точки на массив точек
+void bearing(float lat0, float lon0, const float * lat, const float * lon, float * out, size_t count,
+             GeoMethod method = GeoHaversine);
+void bearing(double lat0, double lon0, const double * lat, const double * lon, double * out, size_t count,
+             GeoMethod method = GeoHaversine);
+
+/// \brief Расстояния и азимуты за один проход
+void distanceBearing(float lat0, float lon0, const float * lat, const float * lon,
+                     float * distOut, float * bearOut, size_t count,
+                     GeoMethod method = GeoHaversine, float radius = static_cast<float>(cEarthRadius()));
+void distanceBearing(double lat0, double lon0, const double * lat, const double * lon,
+                     double * distOut, double * bearOut, size_t count,
+                     GeoMethod method = GeoHaversine, double radius = cEarthRadius());
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Попарно: i-я точка первого массива - i-я точка второго
+
+void distance(const float * lat1, const float * lon1, const float * lat2, const float * lon2,
+              float * out, size_t count, GeoMethod method = GeoHaversine,
+              float radius = static_cast<float>(cEarthRadius()));
+void distance(const double * lat1, const double * lon1, const double * lat2, const double * lon2,
+              double * out, size_t count, GeoMethod method = GeoHaversine, double radius = cEarthRadius());
+
+void bearing(const float * lat1, const float * lon1, const float * lat2, const float * lon2,
+             float * out, size_t count, GeoMethod method = GeoHaversine);
+void bearing(const double * lat1, const double * lon1, const double * lat2, const double * lon2,
+             double * out, size_t count, GeoMethod method = GeoHaversine);
+
+void distanceBearing(const float * lat1, const float * lon1, const float * lat2, const float * lon2,
+                     float * distOut, float * bearOut, size_t count,
+                     GeoMethod method = GeoHaversine, float radius = static_cast<float>(cEarthRadius()));
+void distanceBearing(const double * lat1, const double * lon1, const double * lat2, const double * lon2,
+                     double * distOut, double * bearOut, size_t count,
+                     GeoMethod method = GeoHaversine, double radius = cEarthRadius());
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Одна пара точек
+
+/// \brief Расстояние между двумя точками
+inline double distance(double lat1, double lon1, double lat2, double lon2,
+                       GeoMethod method = GeoHaversine, double radius = cEarthRadius())
+{
+    double d;
+    distance(lat1, lon1, &lat2, &lon2, &d, 1, method, radius);
+    return d;
+}
+
+/// \brief Начальный азимут из первой точки на вторую
+inline double bearing(double lat1, double lon1, double lat2, double lon2, GeoMethod method = GeoHaversine)
+{
+    double b;
+    bearing(lat1, lon1, &lat2, &lon2, &b, 1, method);
+    return b;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace geo
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MGEODESY_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
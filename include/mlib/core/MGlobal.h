@@ -53,6 +53,41 @@
 #else
     #define MLIB_CONSTEXPR
 #endif
+
+/// constexpr для функций с циклами и ветвлениями (ослабленные правила C++14)
+#if MLIB_SUPPORT_CPP14
+    #define MLIB_CONSTEXPR14 constexpr
+#else
+    #define MLIB_CONSTEXPR14
+#endif
+
+/// Признак вычисления выражения при компиляции (std::is_constant_evaluated без C++20).
+/// Без поддержки компилятора - всегда false: constexpr-обертки вызывают функции времени выполнения
+#if defined(__has_builtin)
+    #if __has_builtin(__builtin_is_constant_evaluated)
+        #define MLIB_HAS_CONSTANT_EVALUATED 1
+    #endif
+#endif
+#if !defined(MLIB_HAS_CONSTANT_EVALUATED) \
+    && ((defined(MLIB_GCC) && !defined(__clang__) && MLIB_GCC_VERSION >= 90000) \
+        || (defined(MLIB_MSC) && _MSC_VER >= 1925))
+    #define MLIB_HAS_CONSTANT_EVALUATED 1
+#endif
+
+#if defined(MLIB_HAS_CONSTANT_EVALUATED)
+    #define MLIB_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+    #define MLIB_IS_CONSTANT_EVALUATED() false
+#endif
+
+/// Принудительная подстановка функции (для вычислительных ядер)
+#if defined(MLIB_GCC)
+    #define MLIB_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(MLIB_MSC)
+    #define MLIB_FORCE_INLINE __forceinline
+#else
+    #define MLIB_FORCE_INLINE inline
+#endif
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #endif // MGLOBAL_H
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MHdrHistogram.h
+/// @brief Гистограмма задержек с заданной относительной точностью (HdrHistogram)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+///     MHdrRecorder latency(1, 10000000000ull, 3);    // 1 нс .. 10 с, 3 значащие цифры
+///     ...
+///     MPosixTimeMeter meter;                          // в рабочих потоках
+///     meter.start();
+///     process();
+///     latency.record(meter.nsecsi64());
+///     ...
+///     const MHdrHistogram h = latency.snapshot();
+///     h.valueAtPercentile(99.9);
+///
+/// Диапазон [lowest, highest] делится на корзины-степени двойки, каждая - на 2^k равных
+/// интервалов, где 2^k >= 2 * 10^digits. Значение попадает в интервал, ширина которого
+/// не больше 10^-digits от значения, индекс считается за O(1) через clz. Память -
+/// (log2(highest / lowest) - k + 2) * 2^(k-1) счетчиков: 1 нс .. 1 ч при 3 цифрах - 256 КБ.
+///
+/// MHdrHistogram - для одного потока. MHdrRecorder - общий объект: record() пишет
+/// в гистограмму вызывающего потока без блокировок, snapshot() объединяет их.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MHDRHISTOGRAM_H
+#define MHDRHISTOGRAM_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include "MBitOps.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Гистограмма значений (задержек) с относительной погрешностью 10^-digits
+class MHdrHistogram
+{
+public:
+    /// \param lowest - наименьшее различимое значение (>= 1)
+    /// \param highest - наибольшее значение (>= 2 * lowest)
+    /// \param digits - значащих десятичных цифр: 1..5
+    ///
+    /// Недопустимые параметры приводятся к ближайшим допустимым.
+    explicit MHdrHistogram(uint64_t lowest = 1, uint64_t highest = 3600000000000ull, int digits = 3);
+
+    inline uint64_t lowest() const  { return m_lowest; }
+    inline uint64_t highest() const { return m_highest; }
+    inline int digits() const       { return m_digits; }
+
+    /// \brief Учет count значений value
+    /// \return false - значение больше highest() и не учтено
+    inline bool record(uint64_t value, uint64_t count = 1)
+    {
+        if (value > m_highest)
+            return false;
+        m_counts[index(value)] += count;
+        m_total += count;
+        if (value < m_min)
+            m_min = value;
+        if (value > m_max)
+            m_max = value;
+        return true;
+    }
+
+    /// \brief Учет с поправкой на скоординированное пропускание: если замер длиннее
+    /// ожидаемого интервала между запросами, дополнительно учитываются задержки запросов,
+    /// которые не были отправлены, пока шел этот (value - interval, value - 2 * interval...)
+    bool recordCorrected(uint64_t value, uint64_t interval);
+
+    /// \brief Добавление значений другой гистограммы (параметры могут отличаться)
+    /// \return Количество значений other, не вошедших в диапазон
+    uint64_t add(const MHdrHistogram & other);
+
+    void reset();
+
+    inline uint64_t totalCount() const { return m_total; }
+    /// \brief Наименьшее и наибольшее учтенные значения (точно), 0 - значений нет
+    /// (в скобках - от макросов min/max из windows.h)
+    inline uint64_t (min)() const { return m_total != 0 ? m_min : 0; }
+    inline uint64_t (max)() const { return m_max; }
+    double mean() const;
+    double stddev() const;
+
+    /// \brief Значение, не меньше которого percentile процентов учтенных (0..100)
+    ///
+    /// Верхняя граница интервала, в который попал процентиль, но не больше (max)().
+    uint64_t valueAtPercentile(double percentile) const;
+
+    /// \brief Количество значений, неотличимых от value
+    uint64_t countAtValue(uint64_t value) const;
+
+    /// \brief Границы интервала значений, неотличимых от value
+    uint64_t lowestEquivalent(uint64_t value) const;
+    uint64_t highestEquivalent(uint64_t value) const;
+
+    /// \brief Компактная запись: параметры и счетчики (ZigZag LEB128, серии нулей - одним
+    /// отрицательным числом)
+    std::vector<uint8_t> encode() const;
+
+    /// \brief Восстановление из encode()
+    /// \return false - данные повреждены, out не изменен
+    static bool decode(const uint8_t * data, size_t size, MHdrHistogram & out);
+
+private:
+    friend class MHdrRecorder;
+
+    /// Номер счетчика для value <= highest
+    inline size_t index(uint64_t value) const
+    {
+        const int bucket = m_clzBase - bits::clz(value | m_subBucketMask);
+        const uint64_t sub = value >> (bucket + m_unitMagnitude);
+        return (static_cast<size_t>(bucket + 1) << m_subBucketHalfMagnitude) + static_cast<size_t>(sub - m_subBucketHalf);
+    }
+
+    /// Наименьшее значение счетчика с номером i
+    uint64_t valueAt(size_t i) const;
+    /// Ширина интервала счетчика, в который попадает value
+    uint64_t unitsAt(uint64_t value) const;
+    /// Совпадает ли разбиение на счетчики
+    bool sameLayout(const MHdrHistogram & other) const;
+
+    uint64_t m_lowest;
+    uint64_t m_highest;
+    int m_digits;
+    int m_unitMagnitude;            ///< log2(lowest), округленный вниз
+    int m_subBucketHalfMagnitude;   ///< k - 1
+    uint64_t m_subBucketHalf;       ///< 2^(k-1)
+    uint64_t m_subBucketMask;       ///< (2^k - 1) << unitMagnitude
+    int m_clzBase;                  ///< 64 - unitMagnitude - k
+    std::vector<uint64_t> m_counts;
+    uint64_t m_total;
+    uint64_t m_min;
+    uint64_t m_max;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Гистограмма с записью из нескольких потоков
+///
+/// Каждый поток при первом record() получает свою копию счетчиков и дальше пишет только
+/// в нее (атомарные слова без read-modify-write, O(1)). Копия завершившегося потока
+/// со всеми итогами переходит к следующему новому потоку, поэтому копий не больше,
+/// чем одновременно работавших потоков.
+class MHdrRecorder
+{
+public:
+    explicit MHdrRecorder(uint64_t lowest = 1, uint64_t highest = 3600000000000ull, int digits = 3);
+    ~MHdrRecorder();
+
+    /// \brief Учет значения в копии текущего потока
+    /// \return false - значение больше highest() или поток завершается (вызов из деструктора
+    /// thread_local объекта после освобождения копий потока) и не учтено
+    inline bool record(uint64_t value)
+    {
+        if (value > m_layout.m_highest)
+            return false;
+        Shard * s = shard();
+        if (s == 0)
+            return false;
+        std::atomic<uint64_t> & c = s->counts[m_layout.index(value)];
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (value < s->min.load(std::memory_order_relaxed))
+            s->min.store(value, std::memory_order_relaxed);
+        if (value > s->max.load(std::memory_order_relaxed))
+            s->max.store(value, std::memory_order_relaxed);
+        return true;
+    }
+
+    inline uint64_t highest() const { return m_layout.m_highest; }
+
+    /// \brief Объединение копий всех потоков
+    MHdrHistogram snapshot() const;
+
+    /// \brief Обнуление копий всех потоков
+    ///
+    /// Значения, которые учитываются во время сброса в других потоках, могут быть потеряны.
+    void reset();
+
+private:
+    MHdrRecorder(const MHdrRecorder &);
+    MHdrRecorder & operator=(const MHdrRecorder &);
+
+    struct Shard;
+
+    /// Копия текущего потока: кеш потока, при промахе - поиск или создание
+    inline Shard * shard()
+    {
+        const Slot & slot = s_cache[m_id % cCacheSlots];
+        return slot.id == m_id ? slot.shard : attach();
+    }
+
+    /// Поиск или создание копии, 0 - копии потока уже освобождены
+    Shard * attach();
+
+    /// Признак текущего потока (0 - освобожден), при первом вызове - его закрепление
+    static const void * threadToken();
+
+    /// Освобождение признака и очистка кеша при завершении потока
+    struct ThreadRelease;
+
+    struct Slot
+    {
+        uint64_t id;
+        Shard * shard;
+    };
+    static const size_t cCacheSlots = 4;
+    static thread_local Slot s_cache[cCacheSlots];
+
+    struct Shard
+    {
+        std::atomic<uint64_t> * counts;
+        std::atomic<uint64_t> min;
+        std::atomic<uint64_t> max;
+        std::atomic<const void *> owner;    ///< Поток-владелец
+        Shard * next;
+    };
+
+    MHdrHistogram m_layout;         ///< Параметры и разбиение (без своих счетчиков)
+    size_t m_length;                ///< Счетчиков в копии
+    uint64_t m_id;                  ///< Уникальный номер объекта для кеша потоков
+    std::atomic<Shard *> m_shards;
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MHDRHISTOGRAM_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
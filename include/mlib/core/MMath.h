@@ -45,11 +45,16 @@
 /// оборота, округленные до 6000 (для стран бывшего СССР и др.)
 ///
 /// Эпсилон (положительное сколь угодно малое вещественное число)
+///
+/// Функции, помеченные MLIB_CONSTEXPR, при вычислении во время компиляции считаются
+/// реализациями math::cexpr (MMathConstexpr.h), во время выполнения - функциями std
+/// (если компилятор различает эти случаи, см. MLIB_IS_CONSTANT_EVALUATED).
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #ifndef MMATH_H
 #define MMATH_H
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "MGlobal.h"
+#include "MMathConstexpr.h"
 #include <cmath>
 #include <cfloat>
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -192,14 +197,15 @@ inline MLIB_CONSTEXPR long double cHalfPi()
 
 /// \brief Absolute value of a number (Modulus of a number)
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty abs(_Ty value){   return std::abs(value); }
+inline MLIB_CONSTEXPR _Ty abs(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::abs(value) : std::abs(value); }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// \brief Возведение в степень
 template <typename _Ty>
 inline MLIB_CONSTEXPR _Ty pow(_Ty value, _Ty power)
-{   return std::pow(value, power); }
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::pow(value, power) : std::pow(value, power); }
 
 /// \brief Возведение в 2 степень
 template <typename _Ty>
@@ -212,71 +218,76 @@ inline MLIB_CONSTEXPR _Ty pow3(_Ty value){  return value * value * value; }
 
 /// \brief Квадратный корень
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty sqrt(_Ty value){  return std::sqrt(value); }
+inline MLIB_CONSTEXPR _Ty sqrt(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::sqrt(value) : std::sqrt(value); }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Тригонометрические функции
 
 /// \brief Синус
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty sin(_Ty value){   return std::sin(value); }
+inline MLIB_CONSTEXPR _Ty sin(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::sin(value) : std::sin(value); }
 
 /// \brief Косинус
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty cos(_Ty value){   return std::cos(value); }
+inline MLIB_CONSTEXPR _Ty cos(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::cos(value) : std::cos(value); }
 
 /// \brief Тангенс
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty tan(_Ty value){   return std::tan(value); }
+inline MLIB_CONSTEXPR _Ty tan(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::tan(value) : std::tan(value); }
 
 /// \brief Арксинус
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty asin(_Ty value){  return std::asin(value); }
+inline MLIB_CONSTEXPR _Ty asin(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::asin(value) : std::asin(value); }
 #define arcsin asin
 
 /// \brief Арккосинус
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty acos(_Ty value){  return std::acos(value); }
+inline MLIB_CONSTEXPR _Ty acos(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::acos(value) : std::acos(value); }
 #define arccos acos
 
 /// \brief Арктангенс
 template <typename _Ty>
-inline _Ty arcTan(_Ty y, _Ty x)
+inline MLIB_CONSTEXPR _Ty arcTan(_Ty y, _Ty x)
 {
-    if ( abs(x) < cEps<_Ty>() || abs(y) < cEps<_Ty>() )
-    {
-        if ( y > cEps<_Ty>() )
-            return cHalfPi<_Ty>();
-        if ( -y > cEps<_Ty>() )
-            return -(cHalfPi<_Ty>());
-        if ( -x > cEps<_Ty>() )
-            return cPi<_Ty>();
-        return 0.0;
-    }
-    else
-        return std::atan2(y, x);
+    return abs(x) < cEps<_Ty>() || abs(y) < cEps<_Ty>()
+        ? ( y > cEps<_Ty>()  ? cHalfPi<_Ty>()
+          : -y > cEps<_Ty>() ? -(cHalfPi<_Ty>())
+          : -x > cEps<_Ty>() ? cPi<_Ty>()
+                             : static_cast<_Ty>(0.0) )
+        : MLIB_IS_CONSTANT_EVALUATED() ? cexpr::atan2(y, x) : std::atan2(y, x);
 }
 
 /// \brief Логарифм по основанию 10
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty log10(_Ty x){ return std::log10(x); }
+inline MLIB_CONSTEXPR _Ty log10(_Ty x)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::log10(x) : std::log10(x); }
 
 /// \brief Остаток от деления
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty fmod(_Ty arg, _Ty mod){   return std::fmod(arg, mod); }
+inline MLIB_CONSTEXPR _Ty fmod(_Ty arg, _Ty mod)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::fmod(arg, mod) : std::fmod(arg, mod); }
 #define mod fmod
 
 /// \brief Округление по правилам математики
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty round(_Ty value){         return std::round(value); }
+inline MLIB_CONSTEXPR _Ty round(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::round(value) : std::round(value); }
 
 /// \brief Округление в большую сторону
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty ceil(_Ty value){          return std::ceil(value); }
+inline MLIB_CONSTEXPR _Ty ceil(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::ceil(value) : std::ceil(value); }
 
 /// \brief Округление в меньшую сторону
 template <typename _Ty>
-inline MLIB_CONSTEXPR _Ty floor(_Ty value){         return std::floor(value); }
+inline MLIB_CONSTEXPR _Ty floor(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? cexpr::floor(value) : std::floor(value); }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Функции сравнения
@@ -318,9 +329,7 @@ template <typename _Ty>
 inline MLIB_CONSTEXPR
 _Ty bound(_Ty value, _Ty min, _Ty max)
 {
-    if (value > max) return max;
-    if (value < min) return min;
-    return value;
+    return value > max ? max : value < min ? min : value;
 }
 
 /// \brief Определение знака числа
@@ -328,11 +337,7 @@ template <typename _Ty>
 inline MLIB_CONSTEXPR
 int signat(_Ty value)
 {
-    if ( value > cEps<_Ty>() )
-        return 1;
-    if ( value < -(cEps<_Ty>()) )
-        return -1;
-    return 1;
+    return value < -(cEps<_Ty>()) ? -1 : 1;
 }
 
 /// \brief Определение знака числа (обёртка)
@@ -343,7 +348,8 @@ bool signbit(_Ty value){   return std::signbit(value); }
 /// \brief Проверяет является ли переменная нечисловым значением (NaN)
 template <typename _Ty>
 inline MLIB_CONSTEXPR
-bool isnan(_Ty value){   return std::isnan(value); }
+bool isnan(_Ty value)
+{   return MLIB_IS_CONSTANT_EVALUATED() ? value != value : std::isnan(value); }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Функции сокращения радиан
@@ -351,30 +357,32 @@ bool isnan(_Ty value){   return std::isnan(value); }
 /// \brief Сокращение значения числа радиан до 2ПИ
 /// Полный аналог if (value >= math::c2pi()) {value -= math::c2pi();}
 
+namespace detail {
+
+/// Остаток fmod(value, 2ПИ) в [0, 2ПИ)
 template <typename _Ty>
-inline _Ty mod2Pi(_Ty value)
-{
-    _Ty angle = fmod(value, c2pi<_Ty>());
-    if (angle < 0)
-        angle += c2pi<_Ty>();
-    return angle;
-}
+inline MLIB_CONSTEXPR _Ty modAngle2Pi(_Ty angle)
+{   return angle < 0 ? angle + c2pi<_Ty>() : angle; }
+
+/// Угол из [0, 2ПИ) в (-ПИ, ПИ]
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty modAnglePi(_Ty angle)
+{   return angle > cPi<_Ty>() ? angle - c2pi<_Ty>() : angle; }
+
+} // namespace detail
+
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty mod2Pi(_Ty value)
+{   return detail::modAngle2Pi(fmod(value, c2pi<_Ty>())); }
 
 /// \brief Сокращение значения числа радиан до ПИ
 template <typename _Ty>
-inline _Ty modPi(_Ty value)
-{
-    _Ty angle = fmod(value, c2pi<_Ty>());
-    if (angle < 0)
-        angle += c2pi<_Ty>();
-    if (angle > cPi<_Ty>())
-        angle -= c2pi<_Ty>();
-    return angle;
-}
+inline MLIB_CONSTEXPR _Ty modPi(_Ty value)
+{   return detail::modAnglePi(detail::modAngle2Pi(fmod(value, c2pi<_Ty>()))); }
 
 /// \brief Корень
 template <typename _Ty>
-inline _Ty arcTan2Pi(_Ty y, _Ty x)
+inline MLIB_CONSTEXPR _Ty arcTan2Pi(_Ty y, _Ty x)
 {   return mod2Pi(arcTan(y, x)); }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
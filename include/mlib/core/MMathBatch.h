@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MMathBatch.h
+/// @brief Пакетные (над массивами) версии математических функций MMath.h
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Функции принимают входной и выходной массивы одинаковой длины, допускается in == out.
+/// Выравнивание не требуется. Векторизация - SSE2/AVX2/AVX-512F (по ключам компилятора),
+/// без них - скалярный вариант того же алгоритма.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MMATHBATCH_H
+#define MMATHBATCH_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMath.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Функции сокращения радиан
+//
+// Сокращение x - k * 2ПИ, k = floor(x / 2ПИ), константа 2ПИ разложена на две части так, что
+// произведения k * C1, k * C2 и разности вычисляются точно. В рабочем диапазоне
+// (|x| < 16384 для float, |x| < 2^26 для double) результат совпадает со скалярными mod2Pi/modPi
+// с точностью до 1 ULP от 2ПИ (2^-21 для float, 2^-50 для double), большая часть значений -
+// бит в бит. Значения вне диапазона, Inf и NaN обрабатываются скалярными версиями.
+// Результат mod2Pi строго в [0, 2ПИ): где скалярная версия из-за округления дает 2ПИ,
+// пакетная возвращает 0.
+
+/// \brief Сокращение массива углов до [0, 2ПИ)
+void mod2Pi(const float * in, float * out, size_t count);
+void mod2Pi(const double * in, double * out, size_t count);
+
+/// \brief Сокращение массива углов до (-ПИ, ПИ]
+void modPi(const float * in, float * out, size_t count);
+void modPi(const double * in, double * out, size_t count);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Тригонометрические функции
+//
+// Полиномиальные приближения после сокращения аргумента. Класс точности задает
+// максимальную абсолютную погрешность (измерена по всему рабочему диапазону):
+//
+//                      sin/cos             arcTan
+//  AccuracyLow         1.3e-5              8.2e-5              (float и double)
+//  AccuracyMedium      1.1e-6              2.0e-6              (float и double)
+//  AccuracyHigh        9e-8 / 1.6e-16      2.8e-7 / 4.6e-16    (float / double, 1-2 ULP)
+//
+// sin/cos: рабочий диапазон |x| <= 8192 (float) и |x| < 2^26 (double), вне его, а также
+// для Inf и NaN - std::sin/std::cos. arcTan: Inf и NaN - std::atan2, atan2(±0, ±0) как в std.
+
+/// Класс точности пакетных функций
+enum MathAccuracy
+{
+    AccuracyLow,        ///< Быстрые полиномы низкой степени
+    AccuracyMedium,     ///< Промежуточная точность
+    AccuracyHigh        ///< Точность, близкая к std (несколько ULP)
+};
+
+/// \brief Синус массива
+void sin(const float * in, float * out, size_t count, MathAccuracy accuracy = AccuracyHigh);
+void sin(const double * in, double * out, size_t count, MathAccuracy accuracy = AccuracyHigh);
+
+/// \brief Косинус массива
+void cos(const float * in, float * out, size_t count, MathAccuracy accuracy = AccuracyHigh);
+void cos(const double * in, double * out, size_t count, MathAccuracy accuracy = AccuracyHigh);
+
+/// \brief Синус и косинус массива за один проход
+void sinCos(const float * in, float * sinOut, float * cosOut, size_t count,
+            MathAccuracy accuracy = AccuracyHigh);
+void sinCos(const double * in, double * sinOut, double * cosOut, size_t count,
+            MathAccuracy accuracy = AccuracyHigh);
+
+/// \brief Арктангенс y/x массивов (аналог std::atan2, результат в [-ПИ, ПИ])
+void arcTan(const float * y, const float * x, float * out, size_t count, MathAccuracy accuracy = AccuracyHigh);
+void arcTan(const double * y, const double * x, double * out, size_t count, MathAccuracy accuracy = AccuracyHigh);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MMATHBATCH_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MMathConstexpr.h
+/// @brief Математические функции, вычисляемые при компиляции
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Функции пространства math::cexpr - constexpr по правилам C++11 (одно выражение return,
+/// рекурсия вместо циклов), поэтому доступны любому компилятору с constexpr. Счет ведется
+/// в long double, результат приводится к типу аргумента:
+/// - sqrt - масштабирование на степени 4 и метод Ньютона;
+/// - sin, cos, tan - сокращение на ПИ/2, представленное суммой четырех частей по 30 бит
+///   (Коди-Уэйт), и ряды Тейлора на [-ПИ/4, ПИ/4]; полная точность при |x| < 2^30
+///   (80-битный long double). При |x| >= 2^30 вызываются функции std (не constexpr):
+///   при компиляции это ошибка, а не константа, отличная от результата во время выполнения;
+/// - atan, asin, acos, atan2 - сокращение аргумента до |x| <= tg(ПИ/8) и ряд;
+/// - exp, log, log10, pow - сокращение на ln 2 и ряды exp и atanh, pow - exp(y ln x),
+///   целая степень до 64 - возведением в квадрат;
+/// - floor, ceil, round, trunc, fmod - точно, как и соответствующие функции std.
+///
+/// Для double результат отличается от std не более чем на 1-2 ед. младшего разряда
+/// (fmod, округления - совпадают точно). При вычислении во время выполнения функции работают,
+/// но медленно - обертки MMath.h используют их только при вычислении при компиляции
+/// (см. MLIB_IS_CONSTANT_EVALUATED), во время выполнения вызываются функции std.
+///
+/// Глубина рекурсии для аргументов double - до 50 вызовов, для крайних значений long double -
+/// до 300 (ограничение компиляторов - 512).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MMATHCONSTEXPR_H
+#define MMATHCONSTEXPR_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include <cmath>
+#include <limits>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+namespace cexpr {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+typedef long double ld;
+
+//--------------------------------------------------------------------------------------------------
+// Константы и классификация (без операций, дающих NaN - они запрещены при компиляции)
+
+inline MLIB_CONSTEXPR ld nan()      { return std::numeric_limits<ld>::quiet_NaN(); }
+inline MLIB_CONSTEXPR ld inf()      { return std::numeric_limits<ld>::infinity(); }
+inline MLIB_CONSTEXPR ld pow2_16()  { return 65536.0l; }
+inline MLIB_CONSTEXPR ld pow2_30()  { return 1073741824.0l; }
+inline MLIB_CONSTEXPR ld pow2_62()  { return 4611686018427387904.0l; }
+inline MLIB_CONSTEXPR ld pow2_64()  { return 18446744073709551616.0l; }
+
+inline MLIB_CONSTEXPR ld pi()       { return 3.141592653589793238462643383279502884197l; }
+inline MLIB_CONSTEXPR ld halfPi()   { return 1.570796326794896619231321691639751442099l; }
+inline MLIB_CONSTEXPR ld twoByPi()  { return 0.636619772367581343075535053490057448138l; }
+inline MLIB_CONSTEXPR ld tanPi8()   { return 0.414213562373095048801688724209698078570l; }
+inline MLIB_CONSTEXPR ld ln10()     { return 2.302585092994045684017991454684364207601l; }
+
+/// ПИ/2 = halfPi1 + halfPi2 + halfPi3 + halfPi4, каждая часть - 30 значащих бит
+inline MLIB_CONSTEXPR ld halfPi1()  { return 1.57079632580280303955078125l; }
+inline MLIB_CONSTEXPR ld halfPi2()  { return 9.9209357916352214346034088521264493465423583984375e-10l; }
+inline MLIB_CONSTEXPR ld halfPi3()  { return 5.170182978890249594880037316453613716049630966153927147388458251953125e-19l; }
+inline MLIB_CONSTEXPR ld halfPi4()  { return 2.903855972970774930292308683030436391003965883195344320488739953134427196346223354339599609375e-28l; }
+
+/// ln 2 = ln2Hi + ln2Lo, ln2Hi - 32 значащих бита
+inline MLIB_CONSTEXPR ld ln2Hi()    { return 0.69314718036912381649017333984375l; }
+inline MLIB_CONSTEXPR ld ln2Lo()    { return 1.9082149292705878161442657e-10l; }
+
+inline MLIB_CONSTEXPR bool isNan(ld x)    { return x != x; }
+inline MLIB_CONSTEXPR bool isInf(ld x)
+{   return x > std::numeric_limits<ld>::max() || x < -std::numeric_limits<ld>::max(); }
+inline MLIB_CONSTEXPR ld fabs(ld x)       { return x < 0 ? -x : x; }
+inline MLIB_CONSTEXPR ld square(ld x)     { return x * x; }
+
+/// 2^k в пределах диапазона long double
+inline MLIB_CONSTEXPR ld pow2i(long long k)
+{
+    return k == 0 ? 1 : k < 0 ? 1 / pow2i(-k)
+         : k % 2 != 0 ? 2 * pow2i(k - 1) : square(pow2i(k / 2));
+}
+
+//--------------------------------------------------------------------------------------------------
+// Округления
+
+/// Отбрасывание дробной части, x >= 0 и x < 2^digits: старшие части по 62 бита
+inline MLIB_CONSTEXPR ld truncPos(ld x);
+
+inline MLIB_CONSTEXPR ld truncSplit(ld x, ld high)
+{   return high + truncPos(x - high); }
+
+inline MLIB_CONSTEXPR ld truncPos(ld x)
+{
+    return x < pow2_62() ? static_cast<ld>(static_cast<long long>(x))
+                         : truncSplit(x, pow2_62() * truncPos(x / pow2_62()));
+}
+
+/// Все значения от 2^(digits - 1) (а также Inf) - целые
+inline MLIB_CONSTEXPR bool isIntegral(ld x)
+{   return !(fabs(x) < pow2i(std::numeric_limits<ld>::digits - 1)); }
+
+inline MLIB_CONSTEXPR ld trunc(ld x)
+{   return x == 0 || isIntegral(x) || isNan(x) ? x : x < 0 ? -truncPos(-x) : truncPos(x); }
+
+inline MLIB_CONSTEXPR ld floorFrom(ld x, ld t)  { return x < t ? t - 1 : t; }
+inline MLIB_CONSTEXPR ld ceilFrom(ld x, ld t)   { return x > t ? t + 1 : t; }
+inline MLIB_CONSTEXPR ld roundFrom(ld x, ld t)
+{   return fabs(x - t) >= 0.5l ? (x < 0 ? t - 1 : t + 1) : t; }
+
+/// Ближайшее целое для сокращения аргумента
+inline MLIB_CONSTEXPR long long nearest(ld x)
+{   return static_cast<long long>(x < 0 ? x - 0.5l : x + 0.5l); }
+
+//--------------------------------------------------------------------------------------------------
+// Двоичный порядок: floor(log2 x), x > 0 - делением на 2^(2^k) от старшего k к младшему
+
+/// Наибольшее k, при котором 2^(2^k) не выходит из диапазона long double
+inline MLIB_CONSTEXPR int exponentBits(int k = 0)
+{   return (1 << (k + 1)) >= std::numeric_limits<ld>::max_exponent ? k : exponentBits(k + 1); }
+
+inline MLIB_CONSTEXPR long long exponentUp(ld x, int k)
+{
+    return k < 0 ? 0
+         : x >= pow2i(1ll << k) ? exponentUp(x / pow2i(1ll << k), k) + (1ll << k)
+                                : exponentUp(x, k - 1);
+}
+
+inline MLIB_CONSTEXPR long long exponentDown(ld x, int k)
+{
+    return k < 0 ? -1
+         : x < 1 / pow2i(1ll << k) ? exponentDown(x * pow2i(1ll << k), k) - (1ll << k)
+                                   : exponentDown(x, k - 1);
+}
+
+inline MLIB_CONSTEXPR long long exponent(ld x)
+{   return x >= 1 ? exponentUp(x, exponentBits()) : exponentDown(x, exponentBits()); }
+
+//--------------------------------------------------------------------------------------------------
+// Остаток от деления. Частное делится пополам по порядку: при b' = b 2^h
+// fmod(r, b) = fmod(fmod(r, b'), b), и у обоих остатков частное вдвое короче, поэтому
+// глубина рекурсии - log2 от числа бит частного. Короткое частное снимается вычитанием
+// делителя, умноженного на наибольшую степень 2, не превосходящую остаток. Каждое
+// вычитание точное (b <= r < 2b), поэтому и результат точный.
+
+inline MLIB_CONSTEXPR ld scaleUp(ld b, ld r)
+{   return b <= r / 2 ? scaleUp(b * 2, r) : b; }
+
+/// Частное меньше 32
+inline MLIB_CONSTEXPR ld fmodShort(ld r, ld b)
+{   return r < b ? r : fmodShort(r - scaleUp(b, r), b); }
+
+/// b 2^n двумя множителями (2^n для субнормального b может не входить в диапазон)
+inline MLIB_CONSTEXPR ld scale(ld b, long long n)
+{   return b * pow2i(n / 2) * pow2i(n - n / 2); }
+
+/// Частное меньше 2^(n + 1)
+inline MLIB_CONSTEXPR ld fmodBits(ld r, ld b, long long n)
+{
+    return n <= 4 ? fmodShort(r, b)
+                  : fmodBits(fmodBits(r, scale(b, n / 2), n - n / 2), b, n / 2);
+}
+
+inline MLIB_CONSTEXPR ld fmodPos(ld r, ld b)
+{   return r < b ? r : fmodBits(r, b, exponent(r) - exponent(b)); }
+
+//--------------------------------------------------------------------------------------------------
+// Квадратный корень
+
+inline MLIB_CONSTEXPR ld sqrtNewton(ld x, ld g, int n)
+{   return n == 0 ? g : sqrtNewton(x, (g + x / g) / 2, n - 1); }
+
+/// x > 0: приведение к [1, 4) множителями 4^k, начальное приближение (1 + x) / 2 сверху
+inline MLIB_CONSTEXPR ld sqrtScaled(ld x)
+{
+    return x >= pow2_64()     ? sqrtScaled(x / pow2_64()) * 4294967296.0l
+         : x < 1 / pow2_64()  ? sqrtScaled(x * pow2_64()) / 4294967296.0l
+         : x >= pow2_16()     ? sqrtScaled(x / pow2_16()) * 256
+         : x < 1 / pow2_16()  ? sqrtScaled(x * pow2_16()) / 256
+         : x >= 4             ? sqrtScaled(x / 4) * 2
+         : x < 1              ? sqrtScaled(x * 4) / 2
+                              : sqrtNewton(x, (1 + x) / 2, 6);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Тригонометрия
+
+/// Ряд sin(r) = r - r^3/3! + ..., |r| <= ПИ/4
+inline MLIB_CONSTEXPR ld sinSeries(ld r2, ld term, int n, ld sum)
+{
+    return n > 14 ? sum
+                  : sinSeries(r2, -term * r2 / ((2 * n) * (2 * n + 1)), n + 1,
+                              sum - term * r2 / ((2 * n) * (2 * n + 1)));
+}
+
+/// Ряд cos(r) = 1 - r^2/2! + ..., |r| <= ПИ/4
+inline MLIB_CONSTEXPR ld cosSeries(ld r2, ld term, int n, ld sum)
+{
+    return n > 14 ? sum
+                  : cosSeries(r2, -term * r2 / ((2 * n - 1) * (2 * n)), n + 1,
+                              sum - term * r2 / ((2 * n - 1) * (2 * n)));
+}
+
+inline MLIB_CONSTEXPR ld sinReduced(ld r)   { return sinSeries(r * r, r, 1, r); }
+inline MLIB_CONSTEXPR ld cosReduced(ld r)   { return cosSeries(r * r, 1, 1, 1); }
+
+/// x - k ПИ/2
+inline MLIB_CONSTEXPR ld reduce(ld x, long long k)
+{
+    return x - static_cast<ld>(k) * halfPi1() - static_cast<ld>(k) * halfPi2()
+             - static_cast<ld>(k) * halfPi3() - static_cast<ld>(k) * halfPi4();
+}
+
+/// sin(r + q ПИ/2)
+inline MLIB_CONSTEXPR ld sinQuadrant(ld r, int q)
+{
+    return q == 0 ? sinReduced(r) : q == 1 ? cosReduced(r)
+         : q == 2 ? -sinReduced(r) : -cosReduced(r);
+}
+
+/// tg(r + q ПИ/2)
+inline MLIB_CONSTEXPR ld tanQuadrant(ld r, int q)
+{   return q % 2 == 0 ? sinReduced(r) / cosReduced(r) : -cosReduced(r) / sinReduced(r); }
+
+/// Для k ПИ/2 из частей по 30 бит точны произведения k halfPi1, k halfPi2, если |k| < 2^30
+inline MLIB_CONSTEXPR bool reducible(ld x)
+{   return fabs(x) < pow2_30(); }
+
+/// Аргументы вне reducible() - функциями std. Вызовы намеренно не constexpr: значение,
+/// посчитанное при компиляции, не должно отличаться от значения во время выполнения
+inline ld sinOutOfRange(ld x)   { return std::sin(x); }
+inline ld cosOutOfRange(ld x)   { return std::cos(x); }
+inline ld tanOutOfRange(ld x)   { return std::tan(x); }
+
+inline MLIB_CONSTEXPR ld sin(ld x)
+{
+    return x == 0 || isNan(x) ? x
+         : isInf(x) ? nan()
+         : !reducible(x) ? sinOutOfRange(x)
+         : sinQuadrant(reduce(x, nearest(x * twoByPi())), static_cast<int>(nearest(x * twoByPi()) & 3));
+}
+
+inline MLIB_CONSTEXPR ld cos(ld x)
+{
+    return isNan(x) ? x
+         : isInf(x) ? nan()
+         : !reducible(x) ? cosOutOfRange(x)
+         : sinQuadrant(reduce(x, nearest(x * twoByPi())), static_cast<int>((nearest(x * twoByPi()) + 1) & 3));
+}
+
+inline MLIB_CONSTEXPR ld tan(ld x)
+{
+    return x == 0 || isNan(x) ? x
+         : isInf(x) ? nan()
+         : !reducible(x) ? tanOutOfRange(x)
+         : tanQuadrant(reduce(x, nearest(x * twoByPi())), static_cast<int>(nearest(x * twoByPi()) & 3));
+}
+
+/// Ряд atan(x) = x - x^3/3 + ..., |x| <= tg(ПИ/8)
+inline MLIB_CONSTEXPR ld atanSeries(ld x2, ld power, int n, ld sum)
+{
+    return n > 40 ? sum
+                  : atanSeries(x2, -power * x2, n + 1, sum - power * x2 / (2 * n + 1));
+}
+
+inline MLIB_CONSTEXPR ld atanPos(ld x)
+{
+    return x > 1      ? halfPi() - atanPos(1 / x)
+         : x > tanPi8() ? pi() / 4 + atanSeries(square((x - 1) / (x + 1)), (x - 1) / (x + 1), 1,
+                                                (x - 1) / (x + 1))
+                      : atanSeries(x * x, x, 1, x);
+}
+
+inline MLIB_CONSTEXPR ld atan(ld x)
+{   return x == 0 || isNan(x) ? x : x < 0 ? -atanPos(-x) : atanPos(x); }
+
+inline MLIB_CONSTEXPR ld sqrt(ld x);
+
+inline MLIB_CONSTEXPR ld asin(ld x)
+{
+    return x == 0 || isNan(x) ? x
+         : fabs(x) > 1 ? nan()
+         : x == 1 ? halfPi() : x == -1 ? -halfPi()
+         : atan(x / sqrt((1 - x) * (1 + x)));
+}
+
+inline MLIB_CONSTEXPR ld acos(ld x)
+{
+    return isNan(x) ? x
+         : fabs(x) > 1 ? nan()
+         : x == -1 ? pi()
+         : 2 * atan(sqrt((1 - x) / (1 + x)));
+}
+
+inline MLIB_CONSTEXPR ld atan2(ld y, ld x)
+{
+    return isNan(x) || isNan(y) ? nan()
+         : x == 0 ? (y > 0 ? halfPi() : y < 0 ? -halfPi() : y)
+         : isInf(x) || isInf(y) ? (isInf(x) && isInf(y) ? (x > 0 ? pi() / 4 : 3 * pi() / 4) * (y < 0 ? -1 : 1)
+                                 : isInf(y) ? (y > 0 ? halfPi() : -halfPi())
+                                 : x > 0 ? 0 * y : (y < 0 ? -pi() : pi()))
+         : x > 0 ? atan(y / x)
+         : y < 0 ? atan(y / x) - pi() : atan(y / x) + pi();
+}
+
+//--------------------------------------------------------------------------------------------------
+// Экспонента и логарифм
+
+/// Ряд exp(r) = 1 + r + r^2/2! + ..., |r| <= ln2 / 2
+inline MLIB_CONSTEXPR ld expSeries(ld r, ld term, int n, ld sum)
+{   return n > 24 ? sum : expSeries(r, term * r / n, n + 1, sum + term * r / n); }
+
+/// exp(x) = 2^k exp(x - k ln2); множитель 2^k - двумя половинами, чтобы не выйти из диапазона
+inline MLIB_CONSTEXPR ld expReduced(ld x, long long k)
+{
+    return expSeries(x - k * ln2Hi() - k * ln2Lo(), 1, 1, 1) * pow2i(k / 2) * pow2i(k - k / 2);
+}
+
+inline MLIB_CONSTEXPR ld exp(ld x)
+{
+    return isNan(x) ? x
+         : x > std::numeric_limits<ld>::max_exponent * 0.6931471805599453l ? inf()
+         : x < (std::numeric_limits<ld>::min_exponent - std::numeric_limits<ld>::digits)
+               * 0.6931471805599453l ? 0
+         : expReduced(x, nearest(x / (ln2Hi() + ln2Lo())));
+}
+
+/// Ряд atanh(s) = s + s^3/3 + ..., |s| <= 0.172
+inline MLIB_CONSTEXPR ld atanhSeries(ld s2, ld power, int n, ld sum)
+{   return n > 20 ? sum : atanhSeries(s2, power * s2, n + 1, sum + power * s2 / (2 * n + 1)); }
+
+/// ln(m) + e ln2, m в [1/√2, √2]: ln(m) = 2 atanh((m - 1) / (m + 1))
+inline MLIB_CONSTEXPR ld logReduced(ld m, long long e)
+{
+    return e * ln2Hi() + (e * ln2Lo() + 2 * atanhSeries(square((m - 1) / (m + 1)), (m - 1) / (m + 1),
+                                                         1, (m - 1) / (m + 1)));
+}
+
+/// x > 0: x = m 2^e
+inline MLIB_CONSTEXPR ld logScaled(ld x, long long e)
+{
+    return x >= pow2_64()    ? logScaled(x / pow2_64(), e + 64)
+         : x < 1 / pow2_64() ? logScaled(x * pow2_64(), e - 64)
+         : x >= pow2_16()    ? logScaled(x / pow2_16(), e + 16)
+         : x < 1 / pow2_16() ? logScaled(x * pow2_16(), e - 16)
+         : x > 1.4142135623730950488l ? logScaled(x / 2, e + 1)
+         : x < 0.7071067811865475244l ? logScaled(x * 2, e - 1)
+                                      : logReduced(x, e);
+}
+
+inline MLIB_CONSTEXPR ld log(ld x)
+{
+    return isNan(x) ? x : x < 0 ? nan() : x == 0 ? -inf() : isInf(x) ? x : logScaled(x, 0);
+}
+
+/// x^n возведением в квадрат: погрешность растет с log2(n), поэтому только |n| <= 64
+inline MLIB_CONSTEXPR ld powInt(ld x, long long n)
+{
+    return n == 0 ? 1 : n < 0 ? (x == 0 ? inf() : 1 / powInt(x, -n))
+         : n % 2 != 0 ? x * powInt(x, n - 1) : square(powInt(x, n / 2));
+}
+
+/// Целое y - нечетное (от 2^digits все целые четные)
+inline MLIB_CONSTEXPR bool isOdd(ld y)
+{   return trunc(y / 2) * 2 != y; }
+
+/// x >= 0: exp(y ln x). Ошибка y ln x в long double - около 2^-64 |y ln x|, при конечном
+/// результате double (|y ln x| < 745) это меньше единицы его младшего разряда
+inline MLIB_CONSTEXPR ld powPos(ld x, ld y)
+{
+    return x == 1 ? 1
+         : x == 0 ? (y > 0 ? 0 : inf())
+         : exp(y * log(x));
+}
+
+inline MLIB_CONSTEXPR ld pow(ld x, ld y)
+{
+    return y == 0 || x == 1 ? 1
+         : isNan(x) || isNan(y) ? nan()
+         : fabs(y) <= 64 && trunc(y) == y ? powInt(x, static_cast<long long>(y))
+         : x < 0 ? (trunc(y) != y ? nan() : isOdd(y) ? -powPos(-x, y) : powPos(-x, y))
+         : powPos(x, y);
+}
+
+inline MLIB_CONSTEXPR ld sqrt(ld x)
+{   return x == 0 || isNan(x) ? x : x < 0 ? nan() : isInf(x) ? x : sqrtScaled(x); }
+
+inline MLIB_CONSTEXPR ld fmod(ld a, ld b)
+{
+    return isNan(a) || isNan(b) || isInf(a) || b == 0 ? nan()
+         : isInf(b) || a == 0 ? a
+         : a < 0 ? -fmodPos(-a, fabs(b)) : fmodPos(a, fabs(b));
+}
+
+} // namespace detail
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Функции с типом аргумента
+
+/// \brief Модуль числа
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty abs(_Ty value)
+{   return value < 0 ? -value : value == 0 ? _Ty(0) : value; }
+
+/// \brief Квадратный корень
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty sqrt(_Ty value)
+{   return static_cast<_Ty>(detail::sqrt(value)); }
+
+/// \brief Возведение в степень
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty pow(_Ty value, _Ty power)
+{   return static_cast<_Ty>(detail::pow(value, power)); }
+
+/// \brief Экспонента
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty exp(_Ty value)
+{   return static_cast<_Ty>(detail::exp(value)); }
+
+/// \brief Натуральный логарифм
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty log(_Ty value)
+{   return static_cast<_Ty>(detail::log(value)); }
+
+/// \brief Логарифм по основанию 10
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty log10(_Ty value)
+{   return static_cast<_Ty>(detail::log(value) / detail::ln10()); }
+
+/// \brief Синус
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty sin(_Ty value)
+{   return static_cast<_Ty>(detail::sin(value)); }
+
+/// \brief Косинус
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty cos(_Ty value)
+{   return static_cast<_Ty>(detail::cos(value)); }
+
+/// \brief Тангенс
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty tan(_Ty value)
+{   return static_cast<_Ty>(detail::tan(value)); }
+
+/// \brief Арксинус
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty asin(_Ty value)
+{   return static_cast<_Ty>(detail::asin(value)); }
+
+/// \brief Арккосинус
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty acos(_Ty value)
+{   return static_cast<_Ty>(detail::acos(value)); }
+
+/// \brief Арктангенс
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty atan(_Ty value)
+{   return static_cast<_Ty>(detail::atan(value)); }
+
+/// \brief Арктангенс y/x с учетом четверти, (-ПИ, ПИ]
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty atan2(_Ty y, _Ty x)
+{   return static_cast<_Ty>(detail::atan2(y, x)); }
+
+/// \brief Остаток от деления (точный, знак - как у делимого)
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty fmod(_Ty arg, _Ty divisor)
+{   return static_cast<_Ty>(detail::fmod(arg, divisor)); }
+
+/// \brief Отбрасывание дробной части
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty trunc(_Ty value)
+{   return static_cast<_Ty>(detail::trunc(value)); }
+
+/// \brief Округление к ближайшему, половина - от нуля
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty round(_Ty value)
+{   return static_cast<_Ty>(detail::roundFrom(value, detail::trunc(value))); }
+
+/// \brief Округление в большую сторону
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty ceil(_Ty value)
+{   return static_cast<_Ty>(detail::ceilFrom(value, detail::trunc(value))); }
+
+/// \brief Округление в меньшую сторону
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty floor(_Ty value)
+{   return static_cast<_Ty>(detail::floorFrom(value, detail::trunc(value))); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace cexpr
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MMATHCONSTEXPR_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MMathTable.h
+/// @brief Табличные sin/cos/arcTan с интерполяцией
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Альтернатива функциям MMath.h для расчетов, где достаточно точности порядка 1e-5.
+/// Таблицы вычисляются при компиляции (constexpr), размер таблицы и способ интерполяции
+/// задаются параметрами шаблона в месте вызова:
+///
+///     float s = math::tableSin<1024, math::TableLinear>(angle);
+///     double a = math::tableArcTan<256, math::TableCubic>(y, x);
+///
+/// _Size - число интервалов таблицы на оборот (sin/cos, кратно 4) или на отрезке [0, 1]
+/// (arcTan). Степень двойки сокращается маской, иначе - делением. При _Size = 6000 узлы
+/// таблицы совпадают с целыми т.д., и для целых т.д. tableSinTd/tableCosTd возвращают
+/// значения узлов без погрешности интерполяции.
+///
+/// Кубическая интерполяция - полином Эрмита по значениям и производным в узлах (производная
+/// sin берется из той же таблицы со сдвигом на четверть оборота).
+///
+/// Максимальная абсолютная погрешность (double):
+///
+///     _Size       sin/cos linear  sin/cos cubic   arcTan linear   arcTan cubic
+///     256         7.5e-5          9.4e-10         1.2e-6          2.8e-12
+///     1024        4.7e-6          3.7e-12         7.7e-8          1.1e-14
+///     4096        2.9e-7          1.7e-14         4.8e-9          4.4e-16
+///
+/// Для float погрешность ограничена снизу точностью float (~9e-8 для sin/cos, ~3e-7 для arcTan
+/// около ПИ). Номер узла для float вычисляется в double, чтобы не терять точность при больших
+/// аргументах.
+///
+/// Объем таблиц (_Size + _Size / 4 + 1 для sin/cos, _Size + 1 для arcTan, вдвое больше для
+/// кубической arcTan) элементов типа аргумента: sin/cos 1024 float - 5 КБ, double - 10 КБ.
+///
+/// Значения Inf, NaN и аргументы, для которых индекс не помещается в int64_t, обрабатываются
+/// функциями std.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MMATHTABLE_H
+#define MMATHTABLE_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMath.h"
+#include <cstdint>
+#include <cstddef>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Способ интерполяции между узлами таблицы
+enum TableInterpolation
+{
+    TableLinear,    ///< Линейная
+    TableCubic      ///< Кубическая (Эрмит)
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+//--------------------------------------------------------------------------------------------------
+// Последовательность индексов 0..N-1 (глубина инстанцирования log2(N))
+
+template <size_t... _I>
+struct TableIndexSeq { typedef TableIndexSeq type; };
+
+template <class _A, class _B>
+struct TableIndexConcat;
+
+template <size_t... _A, size_t... _B>
+struct TableIndexConcat<TableIndexSeq<_A...>, TableIndexSeq<_B...> >
+{   typedef TableIndexSeq<_A..., (sizeof...(_A) + _B)...> type; };
+
+template <size_t _N>
+struct TableMakeIndexSeq
+    : TableIndexConcat<typename TableMakeIndexSeq<_N / 2>::type,
+                       typename TableMakeIndexSeq<_N - _N / 2>::type> {};
+
+template <> struct TableMakeIndexSeq<0> { typedef TableIndexSeq<> type; };
+template <> struct TableMakeIndexSeq<1> { typedef TableIndexSeq<0> type; };
+
+//--------------------------------------------------------------------------------------------------
+// Функции, вычисляемые при компиляции (ряды Тейлора в long double)
+
+/// sin(x) для |x| <= ПИ/2
+inline MLIB_CONSTEXPR long double tableSinSeries(long double x2, long double term, int n, long double sum)
+{
+    return n > 30 ? sum
+                  : tableSinSeries(x2, -term * x2 / ((2 * n) * (2 * n + 1)), n + 1,
+                                   sum - term * x2 / ((2 * n) * (2 * n + 1)));
+}
+
+/// sin(ПИ * p / q), 0 <= p < 2q
+inline MLIB_CONSTEXPR long double tableSinPi(size_t p, size_t q)
+{
+    return p >= q ? -tableSinPi(p - q, q)
+         : 2 * p > q ? tableSinPi(q - p, q)
+         : tableSinSeries((cPiLdbl() * p / q) * (cPiLdbl() * p / q), cPiLdbl() * p / q, 1,
+                          cPiLdbl() * p / q);
+}
+
+/// atan(x) для |x| <= tg(ПИ/8)
+inline MLIB_CONSTEXPR long double tableAtanSeries(long double x2, long double power, int n, long double sum)
+{
+    return n > 40 ? sum
+                  : tableAtanSeries(x2, -power * x2, n + 1, sum - power * x2 / (2 * n + 1));
+}
+
+/// atan(x) для 0 <= x <= 1, при x > tg(ПИ/8): ПИ/4 + atan((x - 1) / (x + 1))
+inline MLIB_CONSTEXPR long double tableAtan(long double x)
+{
+    return x > 0.41421356237309504880l
+        ? cPiLdbl() / 4 + tableAtan(-(1 - x) / (1 + x))
+        : tableAtanSeries(x * x, x, 1, x);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Таблицы
+
+template <typename _Ty, size_t _Size, class _Seq = typename TableMakeIndexSeq<_Size + _Size / 4 + 1>::type>
+struct TableSinData;
+
+/// sin в узлах 0.._Size + _Size / 4 (cos берется со сдвигом на _Size / 4)
+template <typename _Ty, size_t _Size, size_t... _I>
+struct TableSinData<_Ty, _Size, TableIndexSeq<_I...> >
+{
+    static MLIB_CONSTEXPR _Ty data[sizeof...(_I)] =
+        { static_cast<_Ty>(tableSinPi(2 * _I % (2 * _Size), _Size))... };
+};
+
+template <typename _Ty, size_t _Size, size_t... _I>
+MLIB_CONSTEXPR _Ty TableSinData<_Ty, _Size, TableIndexSeq<_I...> >::data[sizeof...(_I)];
+
+template <typename _Ty, size_t _Size, class _Seq = typename TableMakeIndexSeq<_Size + 1>::type>
+struct TableAtanData;
+
+/// atan и ее производная 1 / (1 + x^2) в узлах x = k / _Size
+template <typename _Ty, size_t _Size, size_t... _I>
+struct TableAtanData<_Ty, _Size, TableIndexSeq<_I...> >
+{
+    static MLIB_CONSTEXPR _Ty data[sizeof...(_I)] =
+        { static_cast<_Ty>(tableAtan(static_cast<long double>(_I) / _Size))... };
+    static MLIB_CONSTEXPR _Ty deriv[sizeof...(_I)] =
+        { static_cast<_Ty>(1.0l / (1.0l + (static_cast<long double>(_I) / _Size)
+                                        * (static_cast<long double>(_I) / _Size)))... };
+};
+
+template <typename _Ty, size_t _Size, size_t... _I>
+MLIB_CONSTEXPR _Ty TableAtanData<_Ty, _Size, TableIndexSeq<_I...> >::data[sizeof...(_I)];
+
+template <typename _Ty, size_t _Size, size_t... _I>
+MLIB_CONSTEXPR _Ty TableAtanData<_Ty, _Size, TableIndexSeq<_I...> >::deriv[sizeof...(_I)];
+
+//--------------------------------------------------------------------------------------------------
+// Интерполяция
+
+/// Значение между узлами y0, y1 с производными d0, d1 (по аргументу), h - шаг, f - доля шага
+template <TableInterpolation _Interp, typename _Ty>
+inline _Ty tableInterpolate(_Ty y0, _Ty y1, _Ty d0, _Ty d1, _Ty h, _Ty f)
+{
+    if (_Interp == TableLinear)
+        return y0 + f * (y1 - y0);
+    const _Ty g = 1 - f;
+    return y0 + f * f * (3 - 2 * f) * (y1 - y0) + h * f * g * (g * d0 - f * d1);
+}
+
+/// Номер интервала и доля шага для t (в шагах таблицы), |t| < 4e18
+template <size_t _Size, typename _Ty>
+inline void tableSplit(double t, size_t & index, _Ty & frac)
+{
+    const double fl = floor(t);
+    frac = static_cast<_Ty>(t - fl);
+    int64_t k = static_cast<int64_t>(fl) % static_cast<int64_t>(_Size);
+    if (k < 0)
+        k += static_cast<int64_t>(_Size);
+    index = static_cast<size_t>(k);
+}
+
+/// sin (cosine = false) или cos (cosine = true), t - аргумент в шагах таблицы
+template <size_t _Size, TableInterpolation _Interp, typename _Ty>
+inline _Ty tableSinCos(double t, bool cosine)
+{
+    typedef TableSinData<_Ty, _Size> Data;
+    size_t i;
+    _Ty f;
+    tableSplit<_Size>(t, i, f);
+    const _Ty * s = Data::data + i;
+    const _Ty * c = Data::data + i + _Size / 4;
+    const _Ty h = static_cast<_Ty>(2 * cPiDbl() / _Size);
+    return cosine ? tableInterpolate<_Interp>(c[0], c[1], -s[0], -s[1], h, f)
+                  : tableInterpolate<_Interp>(s[0], s[1], c[0], c[1], h, f);
+}
+
+} // namespace detail
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// sin/cos
+
+/// \brief sin(value), value в радианах
+template <size_t _Size = 1024, TableInterpolation _Interp = TableLinear, typename _Ty>
+inline _Ty tableSin(_Ty value)
+{
+    static_assert(_Size >= 4 && _Size % 4 == 0, "table size must be a multiple of 4");
+    const double t = value * (_Size / (2 * cPiDbl()));
+    return abs(t) < 4.0e18 ? detail::tableSinCos<_Size, _Interp, _Ty>(t, false)
+                                             : std::sin(value);
+}
+
+/// \brief cos(value), value в радианах
+template <size_t _Size = 1024, TableInterpolation _Interp = TableLinear, typename _Ty>
+inline _Ty tableCos(_Ty value)
+{
+    static_assert(_Size >= 4 && _Size % 4 == 0, "table size must be a multiple of 4");
+    const double t = value * (_Size / (2 * cPiDbl()));
+    return abs(t) < 4.0e18 ? detail::tableSinCos<_Size, _Interp, _Ty>(t, true)
+                                             : std::cos(value);
+}
+
+/// \brief sin(value), value в т.д. (6000 на оборот)
+template <size_t _Size = 1024, TableInterpolation _Interp = TableLinear, typename _Ty>
+inline _Ty tableSinTd(_Ty value)
+{
+    static_assert(_Size >= 4 && _Size % 4 == 0, "table size must be a multiple of 4");
+    const double t = value * (_Size / 6000.0);
+    return abs(t) < 4.0e18 ? detail::tableSinCos<_Size, _Interp, _Ty>(t, false)
+                                             : std::sin(tdToRad(value));
+}
+
+/// \brief cos(value), value в т.д. (6000 на оборот)
+template <size_t _Size = 1024, TableInterpolation _Interp = TableLinear, typename _Ty>
+inline _Ty tableCosTd(_Ty value)
+{
+    static_assert(_Size >= 4 && _Size % 4 == 0, "table size must be a multiple of 4");
+    const double t = value * (_Size / 6000.0);
+    return abs(t) < 4.0e18 ? detail::tableSinCos<_Size, _Interp, _Ty>(t, true)
+                                             : std::cos(tdToRad(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// arcTan
+
+/// \brief Арктангенс y/x с учетом четверти (аналог arcTan(y, x) из MMath.h), (-ПИ, ПИ]
+template <size_t _Size = 1024, TableInterpolation _Interp = TableLinear, typename _Ty>
+inline _Ty tableArcTan(_Ty y, _Ty x)
+{
+    typedef detail::TableAtanData<_Ty, _Size> Data;
+    const _Ty ax = abs(x);
+    const _Ty ay = abs(y);
+    const bool swap = ay > ax;
+    const _Ty r = swap ? ax / ay : (ax > 0 ? ay / ax : 0);
+    if (!(r <= 1))
+        return std::atan2(y, x);
+
+    const _Ty t = r * static_cast<_Ty>(_Size);
+    size_t i = static_cast<size_t>(t);
+    if (i >= _Size)
+        i = _Size - 1;
+    const _Ty f = t - static_cast<_Ty>(i);
+    _Ty a = detail::tableInterpolate<_Interp>(Data::data[i], Data::data[i + 1],
+                                              Data::deriv[i], Data::deriv[i + 1],
+                                              static_cast<_Ty>(1.0 / _Size), f);
+    if (swap)
+        a = cPi<_Ty>() / 2 - a;
+    if (signbit(x))
+        a = cPi<_Ty>() - a;
+    return signbit(y) ? -a : a;
+}
+
+/// \brief Арктангенс value
+template <size_t _Size = 1024, TableInterpolation _Interp = TableLinear, typename _Ty>
+inline _Ty tableArcTan(_Ty value)
+{   return tableArcTan<_Size, _Interp>(value, static_cast<_Ty>(1)); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MMATHTABLE_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
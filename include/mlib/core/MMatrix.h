@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MMatrix.h
+/// @brief Квадратные матрицы 2x2, 3x3, 4x4 и пакетное умножение матрицы на массивы точек
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Матрица хранится по строкам (массив строк MVecN), умножение на вектор - m * v (вектор-столбец).
+/// Конструкторы, транспонирование, определитель, произведения - constexpr; обратная матрица
+/// и матрицы поворота (sin/cos) вычисляются во время выполнения.
+///
+/// Пакетные функции transform применяют одну матрицу к массивам точек в раздельных массивах
+/// (SoA): элементы матрицы размножаются по регистру один раз, каждая координата результата -
+/// цепочка FMA над целыми регистрами SSE2/AVX2/AVX-512F. Допускается совпадение входных
+/// и выходных массивов.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MMATRIX_H
+#define MMATRIX_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MVector.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Матрица 2x2
+template <typename _Ty>
+class MMat2
+{
+public:
+    typedef _Ty         value_type;
+    typedef MVec2<_Ty>  vector_type;
+
+    /// \brief Нулевая матрица
+    MLIB_CONSTEXPR MMat2() : m_rows{ vector_type(), vector_type() } {}
+    MLIB_CONSTEXPR MMat2(const vector_type & r0, const vector_type & r1) : m_rows{ r0, r1 } {}
+    MLIB_CONSTEXPR MMat2(_Ty a00, _Ty a01,
+                         _Ty a10, _Ty a11)
+        : m_rows{ vector_type(a00, a01), vector_type(a10, a11) } {}
+
+    /// \brief Преобразование типа элементов
+    template <typename _Other>
+    MLIB_CONSTEXPR explicit MMat2(const MMat2<_Other> & m) : m_rows{ vector_type(m[0]), vector_type(m[1]) } {}
+
+    static MLIB_CONSTEXPR MMat2 identity()
+    {   return MMat2(1, 0, 0, 1); }
+    static MLIB_CONSTEXPR MMat2 diagonal(const vector_type & d)
+    {   return MMat2(d.x, 0, 0, d.y); }
+    static MLIB_CONSTEXPR MMat2 fromColumns(const vector_type & c0, const vector_type & c1)
+    {   return MMat2(c0.x, c1.x, c0.y, c1.y); }
+
+    /// \brief Поворот на угол (рад) против часовой стрелки
+    static inline MMat2 rotation(_Ty angle)
+    {
+        const _Ty s = std::sin(angle), c = std::cos(angle);
+        return MMat2(c, -s, s, c);
+    }
+
+    MLIB_CONSTEXPR const vector_type & operator[](size_t i) const { return m_rows[i]; }
+    inline vector_type & operator[](size_t i)                     { return m_rows[i]; }
+    MLIB_CONSTEXPR _Ty operator()(size_t i, size_t j) const       { return m_rows[i][j]; }
+    MLIB_CONSTEXPR vector_type column(size_t j) const
+    {   return vector_type(m_rows[0][j], m_rows[1][j]); }
+
+    MLIB_CONSTEXPR MMat2 transposed() const
+    {   return MMat2(column(0), column(1)); }
+    MLIB_CONSTEXPR _Ty determinant() const
+    {   return cross(m_rows[0], m_rows[1]); }
+    MLIB_CONSTEXPR _Ty trace() const
+    {   return m_rows[0].x + m_rows[1].y; }
+
+    /// \brief Обратная матрица (для вырожденной - Inf/NaN)
+    inline MMat2 inverse() const
+    {
+        const _Ty r = _Ty(1) / determinant();
+        return MMat2(m_rows[1].y * r, -m_rows[0].y * r, -m_rows[1].x * r, m_rows[0].x * r);
+    }
+
+    MLIB_CONSTEXPR vector_type operator*(const vector_type & v) const
+    {   return vector_type(dot(m_rows[0], v), dot(m_rows[1], v)); }
+    MLIB_CONSTEXPR MMat2 operator*(const MMat2 & m) const
+    {   return mulTransposed(m.transposed()); }
+    MLIB_CONSTEXPR MMat2 operator*(_Ty s) const
+    {   return MMat2(m_rows[0] * s, m_rows[1] * s); }
+    MLIB_CONSTEXPR MMat2 operator+(const MMat2 & m) const
+    {   return MMat2(m_rows[0] + m.m_rows[0], m_rows[1] + m.m_rows[1]); }
+    MLIB_CONSTEXPR MMat2 operator-(const MMat2 & m) const
+    {   return MMat2(m_rows[0] - m.m_rows[0], m_rows[1] - m.m_rows[1]); }
+
+    MLIB_CONSTEXPR bool operator==(const MMat2 & m) const
+    {   return m_rows[0] == m.m_rows[0] && m_rows[1] == m.m_rows[1]; }
+    MLIB_CONSTEXPR bool operator!=(const MMat2 & m) const
+    {   return !(*this == m); }
+
+private:
+    /// this * t^T (строки t - столбцы второго сомножителя)
+    MLIB_CONSTEXPR MMat2 mulTransposed(const MMat2 & t) const
+    {   return MMat2(t * m_rows[0], t * m_rows[1]); }
+
+    vector_type m_rows[2];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Матрица 3x3
+template <typename _Ty>
+class MMat3
+{
+public:
+    typedef _Ty         value_type;
+    typedef MVec3<_Ty>  vector_type;
+
+    /// \brief Нулевая матрица
+    MLIB_CONSTEXPR MMat3() : m_rows{ vector_type(), vector_type(), vector_type() } {}
+    MLIB_CONSTEXPR MMat3(const vector_type & r0, const vector_type & r1, const vector_type & r2)
+        : m_rows{ r0, r1, r2 } {}
+    MLIB_CONSTEXPR MMat3(_Ty a00, _Ty a01, _Ty a02,
+                         _Ty a10, _Ty a11, _Ty a12,
+                         _Ty a20, _Ty a21, _Ty a22)
+        : m_rows{ vector_type(a00, a01, a02), vector_type(a10, a11, a12), vector_type(a20, a21, a22) } {}
+
+    template <typename _Other>
+    MLIB_CONSTEXPR explicit MMat3(const MMat3<_Other> & m)
+        : m_rows{ vector_type(m[0]), vector_type(m[1]), vector_type(m[2]) } {}
+
+    static MLIB_CONSTEXPR MMat3 identity()
+    {   return MMat3(1, 0, 0, 0, 1, 0, 0, 0, 1); }
+    static MLIB_CONSTEXPR MMat3 diagonal(const vector_type & d)
+    {   return MMat3(d.x, 0, 0, 0, d.y, 0, 0, 0, d.z); }
+    static MLIB_CONSTEXPR MMat3 fromColumns(const vector_type & c0, const vector_type & c1,
+                                            const vector_type & c2)
+    {   return MMat3(c0, c1, c2).transposed(); }
+    /// \brief Матрица из массива 9 элементов по строкам
+    static MLIB_CONSTEXPR MMat3 fromArray(const _Ty * p)
+    {   return MMat3(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8]); }
+    /// \brief Матрица векторного произведения: skew(a) * b = cross(a, b)
+    static MLIB_CONSTEXPR MMat3 skew(const vector_type & a)
+    {   return MMat3(0, -a.z, a.y, a.z, 0, -a.x, -a.y, a.x, 0); }
+
+    /// \brief Повороты на угол (рад) вокруг осей X, Y, Z (правая система, против часовой
+    /// стрелки при взгляде с конца оси)
+    static inline MMat3 rotationX(_Ty angle)
+    {
+        const _Ty s = std::sin(angle), c = std::cos(angle);
+        return MMat3(1, 0, 0, 0, c, -s, 0, s, c);
+    }
+    static inline MMat3 rotationY(_Ty angle)
+    {
+        const _Ty s = std::sin(angle), c = std::cos(angle);
+        return MMat3(c, 0, s, 0, 1, 0, -s, 0, c);
+    }
+    static inline MMat3 rotationZ(_Ty angle)
+    {
+        const _Ty s = std::sin(angle), c = std::cos(angle);
+        return MMat3(c, -s, 0, s, c, 0, 0, 0, 1);
+    }
+
+    /// \brief Поворот на угол (рад) вокруг единичной оси (формула Родрига)
+    static inline MMat3 rotation(const vector_type & axis, _Ty angle)
+    {
+        const _Ty s = std::sin(angle), c = std::cos(angle);
+        const _Ty k = 1 - c;
+        const _Ty x = axis.x, y = axis.y, z = axis.z;
+        return MMat3(c + k * x * x,     k * x * y - s * z, k * x * z + s * y,
+                     k * x * y + s * z, c + k * y * y,     k * y * z - s * x,
+                     k * x * z - s * y, k * y * z + s * x, c + k * z * z);
+    }
+
+    MLIB_CONSTEXPR const vector_type & operator[](size_t i) const { return m_rows[i]; }
+    inline vector_type & operator[](size_t i)                     { return m_rows[i]; }
+    MLIB_CONSTEXPR _Ty operator()(size_t i, size_t j) const       { return m_rows[i][j]; }
+    MLIB_CONSTEXPR vector_type column(size_t j) const
+    {   return vector_type(m_rows[0][j], m_rows[1][j], m_rows[2][j]); }
+
+    MLIB_CONSTEXPR MMat3 transposed() const
+    {   return MMat3(column(0), column(1), column(2)); }
+    MLIB_CONSTEXPR _Ty determinant() const
+    {   return dot(m_rows[0], cross(m_rows[1], m_rows[2])); }
+    MLIB_CONSTEXPR _Ty trace() const
+    {   return m_rows[0].x + m_rows[1].y + m_rows[2].z; }
+
+    /// \brief Обратная матрица (для вырожденной - Inf/NaN)
+    ///
+    /// Для матриц поворота дешевле и точнее transposed().
+    inline MMat3 inverse() const
+    {
+        // Столбцы обратной - векторные произведения строк, деленные на определитель
+        const vector_type c0 = cross(m_rows[1], m_rows[2]);
+        const vector_type c1 = cross(m_rows[2], m_rows[0]);
+        const vector_type c2 = cross(m_rows[0], m_rows[1]);
+        const _Ty r = _Ty(1) / dot(m_rows[0], c0);
+        return fromColumns(c0 * r, c1 * r, c2 * r);
+    }
+
+    MLIB_CONSTEXPR vector_type operator*(const vector_type & v) const
+    {   return vector_type(dot(m_rows[0], v), dot(m_rows[1], v), dot(m_rows[2], v)); }
+    MLIB_CONSTEXPR MMat3 operator*(const MMat3 & m) const
+    {   return mulTransposed(m.transposed()); }
+    MLIB_CONSTEXPR MMat3 operator*(_Ty s) const
+    {   return MMat3(m_rows[0] * s, m_rows[1] * s, m_rows[2] * s); }
+    MLIB_CONSTEXPR MMat3 operator+(const MMat3 & m) const
+    {   return MMat3(m_rows[0] + m.m_rows[0], m_rows[1] + m.m_rows[1], m_rows[2] + m.m_rows[2]); }
+    MLIB_CONSTEXPR MMat3 operator-(const MMat3 & m) const
+    {   return MMat3(m_rows[0] - m.m_rows[0], m_rows[1] - m.m_rows[1], m_rows[2] - m.m_rows[2]); }
+
+    MLIB_CONSTEXPR bool operator==(const MMat3 & m) const
+    {   return m_rows[0] == m.m_rows[0] && m_rows[1] == m.m_rows[1] && m_rows[2] == m.m_rows[2]; }
+    MLIB_CONSTEXPR bool operator!=(const MMat3 & m) const
+    {   return !(*this == m); }
+
+private:
+    MLIB_CONSTEXPR MMat3 mulTransposed(const MMat3 & t) const
+    {   return MMat3(t * m_rows[0], t * m_rows[1], t * m_rows[2]); }
+
+    vector_type m_rows[3];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Матрица 4x4 (однородные координаты)
+template <typename _Ty>
+class MMat4
+{
+public:
+    typedef _Ty         value_type;
+    typedef MVec4<_Ty>  vector_type;
+
+    /// \brief Нулевая матрица
+    MLIB_CONSTEXPR MMat4() : m_rows{ vector_type(), vector_type(), vector_type(), vector_type() } {}
+    MLIB_CONSTEXPR MMat4(const vector_type & r0, const vector_type & r1,
+                         const vector_type & r2, const vector_type & r3)
+        : m_rows{ r0, r1, r2, r3 } {}
+    MLIB_CONSTEXPR MMat4(_Ty a00, _Ty a01, _Ty a02, _Ty a03,
+                         _Ty a10, _Ty a11, _Ty a12, _Ty a13,
+                         _Ty a20, _Ty a21, _Ty a22, _Ty a23,
+                         _Ty a30, _Ty a31, _Ty a32, _Ty a33)
+        : m_rows{ vector_type(a00, a01, a02, a03), vector_type(a10, a11, a12, a13),
+                  vector_type(a20, a21, a22, a23), vector_type(a30, a31, a32, a33) } {}
+
+    template <typename _Other>
+    MLIB_CONSTEXPR explicit MMat4(const MMat4<_Other> & m)
+        : m_rows{ vector_type(m[0]), vector_type(m[1]), vector_type(m[2]), vector_type(m[3]) } {}
+    /// \brief Аффинное преобразование p -> m p + t
+    MLIB_CONSTEXPR MMat4(const MMat3<_Ty> & m, const MVec3<_Ty> & t)
+        : m_rows{ vector_type(m[0], t.x), vector_type(m[1], t.y), vector_type(m[2], t.z),
+                  vector_type(0, 0, 0, 1) } {}
+
+    static MLIB_CONSTEXPR MMat4 identity()
+    {   return MMat4(MMat3<_Ty>::identity(), MVec3<_Ty>()); }
+    static MLIB_CONSTEXPR MMat4 diagonal(const vector_type & d)
+    {   return MMat4(d.x, 0, 0, 0, 0, d.y, 0, 0, 0, 0, d.z, 0, 0, 0, 0, d.w); }
+    static MLIB_CONSTEXPR MMat4 translation(const MVec3<_Ty> & t)
+    {   return MMat4(MMat3<_Ty>::identity(), t); }
+    static MLIB_CONSTEXPR MMat4 fromColumns(const vector_type & c0, const vector_type & c1,
+                                            const vector_type & c2, const vector_type & c3)
+    {   return MMat4(c0, c1, c2, c3).transposed(); }
+
+    MLIB_CONSTEXPR const vector_type & operator[](size_t i) const { return m_rows[i]; }
+    inline vector_type & operator[](size_t i)                     { return m_rows[i]; }
+    MLIB_CONSTEXPR _Ty operator()(size_t i, size_t j) const       { return m_rows[i][j]; }
+    MLIB_CONSTEXPR vector_type column(size_t j) const
+    {   return vector_type(m_rows[0][j], m_rows[1][j], m_rows[2][j], m_rows[3][j]); }
+
+    /// \brief Левый верхний блок 3x3 (линейная часть аффинного преобразования)
+    MLIB_CONSTEXPR MMat3<_Ty> linear() const
+    {   return MMat3<_Ty>(m_rows[0].xyz(), m_rows[1].xyz(), m_rows[2].xyz()); }
+    /// \brief Столбец переноса аффинного преобразования
+    MLIB_CONSTEXPR MVec3<_Ty> translationPart() const
+    {   return MVec3<_Ty>(m_rows[0].w, m_rows[1].w, m_rows[2].w); }
+    /// \brief Аффинное ли преобразование (нижняя строка (0, 0, 0, 1))
+    MLIB_CONSTEXPR bool isAffine() const
+    {   return m_rows[3] == vector_type(0, 0, 0, 1); }
+
+    MLIB_CONSTEXPR MMat4 transposed() const
+    {   return MMat4(column(0), column(1), column(2), column(3)); }
+    MLIB_CONSTEXPR _Ty trace() const
+    {   return m_rows[0].x + m_rows[1].y + m_rows[2].z + m_rows[3].w; }
+
+    /// \brief Обратная аффинная матрица (нижняя строка считается равной (0, 0, 0, 1))
+    inline MMat4 affineInverse() const
+    {
+        const MMat3<_Ty> r = linear().inverse();
+        return MMat4(r, -(r * translationPart()));
+    }
+
+    /// \brief Точка p -> (m (p, 1)).xyz без деления на w
+    MLIB_CONSTEXPR MVec3<_Ty> transformPoint(const MVec3<_Ty> & p) const
+    {   return (*this * vector_type(p, 1)).xyz(); }
+    /// \brief Направление d -> (m (d, 0)).xyz
+    MLIB_CONSTEXPR MVec3<_Ty> transformDirection(const MVec3<_Ty> & d) const
+    {   return (*this * vector_type(d, 0)).xyz(); }
+
+    MLIB_CONSTEXPR vector_type operator*(const vector_type & v) const
+    {   return vector_type(dot(m_rows[0], v), dot(m_rows[1], v), dot(m_rows[2], v), dot(m_rows[3], v)); }
+    MLIB_CONSTEXPR MMat4 operator*(const MMat4 & m) const
+    {   return mulTransposed(m.transposed()); }
+    MLIB_CONSTEXPR MMat4 operator*(_Ty s) const
+    {   return MMat4(m_rows[0] * s, m_rows[1] * s, m_rows[2] * s, m_rows[3] * s); }
+    MLIB_CONSTEXPR MMat4 operator+(const MMat4 & m) const
+    {
+        return MMat4(m_rows[0] + m.m_rows[0], m_rows[1] + m.m_rows[1],
+                     m_rows[2] + m.m_rows[2], m_rows[3] + m.m_rows[3]);
+    }
+    MLIB_CONSTEXPR MMat4 operator-(const MMat4 & m) const
+    {
+        return MMat4(m_rows[0] - m.m_rows[0], m_rows[1] - m.m_rows[1],
+                     m_rows[2] - m.m_rows[2], m_rows[3] - m.m_rows[3]);
+    }
+
+    MLIB_CONSTEXPR bool operator==(const MMat4 & m) const
+    {
+        return m_rows[0] == m.m_rows[0] && m_rows[1] == m.m_rows[1] &&
+               m_rows[2] == m.m_rows[2] && m_rows[3] == m.m_rows[3];
+    }
+    MLIB_CONSTEXPR bool operator!=(const MMat4 & m) const
+    {   return !(*this == m); }
+
+private:
+    MLIB_CONSTEXPR MMat4 mulTransposed(const MMat4 & t) const
+    {   return MMat4(t * m_rows[0], t * m_rows[1], t * m_rows[2], t * m_rows[3]); }
+
+    vector_type m_rows[4];
+};
+
+typedef MMat2<float>  MMat2f;
+typedef MMat2<double> MMat2d;
+typedef MMat3<float>  MMat3f;
+typedef MMat3<double> MMat3d;
+typedef MMat4<float>  MMat4f;
+typedef MMat4<double> MMat4d;
+
+template <typename _Ty>
+inline MLIB_CONSTEXPR MMat2<_Ty> operator*(_Ty s, const MMat2<_Ty> & m) { return m * s; }
+template <typename _Ty>
+inline MLIB_CONSTEXPR MMat3<_Ty> operator*(_Ty s, const MMat3<_Ty> & m) { return m * s; }
+template <typename _Ty>
+inline MLIB_CONSTEXPR MMat4<_Ty> operator*(_Ty s, const MMat4<_Ty> & m) { return m * s; }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Пакетное применение матрицы к массивам точек (SoA)
+
+/// \brief (ox, oy) = m (x, y)
+void transform(const MMat2<float> & m, const float * x, const float * y,
+               float * ox, float * oy, size_t count);
+void transform(const MMat2<double> & m, const double * x, const double * y,
+               double * ox, double * oy, size_t count);
+
+/// \brief (ox, oy, oz) = m (x, y, z)
+void transform(const MMat3<float> & m, const float * x, const float * y, const float * z,
+               float * ox, float * oy, float * oz, size_t count);
+void transform(const MMat3<double> & m, const double * x, const double * y, const double * z,
+               double * ox, double * oy, double * oz, size_t count);
+
+/// \brief (ox, oy, oz) = m (x, y, z) + t
+void transform(const MMat3<float> & m, const MVec3<float> & t,
+               const float * x, const float * y, const float * z,
+               float * ox, float * oy, float * oz, size_t count);
+void transform(const MMat3<double> & m, const MVec3<double> & t,
+               const double * x, const double * y, const double * z,
+               double * ox, double * oy, double * oz, size_t count);
+
+/// \brief Точки в однородных координатах: (ox, oy, oz) = (m (x, y, z, 1)).xyz / w
+///
+/// Для аффинной матрицы (isAffine()) деление на w не выполняется.
+void transform(const MMat4<float> & m, const float * x, const float * y, const float * z,
+               float * ox, float * oy, float * oz, size_t count);
+void transform(const MMat4<double> & m, const double * x, const double * y, const double * z,
+               double * ox, double * oy, double * oz, size_t count);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MMATRIX_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
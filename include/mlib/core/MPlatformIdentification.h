@@ -130,7 +130,7 @@
         #define MLIB_OS_WIN64
     #endif
 #elif defined(__linux__) || defined(linux) || defined(_linux)
-    #ifndef(MLIB_OS_LINUX)
+    #ifndef MLIB_OS_LINUX
         #define MLIB_OS_LINUX
     #endif
 #elif defined(MSDOS) || defined(__MSDOS__) || defined(__DOS__) || defined(_MSDOS)
@@ -234,6 +234,86 @@
 #else
     #error "Undefened compiler"
 #endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Processor architecture
+
+#if defined(__x86_64__) || defined(__amd64__) || defined(_M_X64) || defined(_M_AMD64)
+    #define MLIB_ARCH_X86
+    #define MLIB_ARCH_X86_64
+#elif defined(__i386__) || defined(_M_IX86)
+    #define MLIB_ARCH_X86
+    #define MLIB_ARCH_X86_32
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define MLIB_ARCH_ARM
+    #define MLIB_ARCH_ARM64
+#elif defined(__arm__) || defined(_M_ARM)
+    #define MLIB_ARCH_ARM
+    #define MLIB_ARCH_ARM32
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SIMD instruction set extensions
+// Определяются по ключам компилятора (-msse4.1, -mavx2, -march=native, /arch:AVX2 и т.п.).
+// MLIB_SIMD_DISABLE отключает все векторные реализации (остаются только скалярные).
+
+#if !defined(MLIB_SIMD_DISABLE)
+    #if defined(MLIB_ARCH_X86)
+        #if defined(__SSE2__) || defined(MLIB_ARCH_X86_64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            #define MLIB_SIMD_SSE2
+        #endif
+        #if defined(__SSSE3__) || defined(__AVX__)
+            #define MLIB_SIMD_SSSE3
+        #endif
+        #if defined(__SSE4_1__) || defined(__AVX__)
+            #define MLIB_SIMD_SSE41
+        #endif
+        #if defined(__AVX__)
+            #define MLIB_SIMD_AVX
+        #endif
+        #if defined(__AVX2__)
+            #define MLIB_SIMD_AVX2
+        #endif
+        #if defined(__F16C__) || (defined(MLIB_MSC) && defined(__AVX2__))
+            #define MLIB_SIMD_F16C
+        #endif
+        #if defined(__FMA__) || (defined(MLIB_MSC) && defined(__AVX2__))
+            #define MLIB_SIMD_FMA
+        #endif
+        #if defined(__AVX512F__)
+            #define MLIB_SIMD_AVX512F
+        #endif
+        #if defined(__AVX512BW__)
+            #define MLIB_SIMD_AVX512BW
+        #endif
+        #if defined(__AVX512VPOPCNTDQ__)
+            #define MLIB_SIMD_AVX512VPOPCNTDQ
+        #endif
+    #endif
+
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define MLIB_SIMD_NEON
+    #endif
+#endif // MLIB_SIMD_DISABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bit manipulation instruction set extensions (x86)
+// MSVC не сообщает о них отдельно, считаем доступными вместе с /arch:AVX2.
+
+#if defined(MLIB_ARCH_X86)
+    #if defined(__POPCNT__) || (defined(MLIB_MSC) && defined(__AVX__))
+        #define MLIB_ISA_POPCNT
+    #endif
+    #if defined(__LZCNT__) || (defined(MLIB_MSC) && defined(__AVX2__))
+        #define MLIB_ISA_LZCNT
+    #endif
+    #if defined(__BMI__) || (defined(MLIB_MSC) && defined(__AVX2__))
+        #define MLIB_ISA_BMI1
+    #endif
+    #if defined(__BMI2__) || (defined(MLIB_MSC) && defined(__AVX2__))
+        #define MLIB_ISA_BMI2
+    #endif
+#endif
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #endif //MPLATFORMTYPE_H
 ////////////////////////////////////////////////////////////////////////////////////////////////////
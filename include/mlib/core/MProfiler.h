@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MProfiler.h
+/// @brief Профилировщик зон кода с деревом вызовов
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+///     void parse(const Packet & p)
+///     {
+///         MLIB_PROFILE_SCOPE("parse");
+///         ...
+///     }
+///     ...
+///     std::fputs(mlib::profiler::report().c_str(), stdout);
+///
+/// Зона - время жизни объекта MProfileZone. Каждый поток накапливает итоги в своем дереве
+/// путей вызова (узел - зона внутри конкретной цепочки родительских зон): количество,
+/// суммарное, наименьшее и наибольшее время. Дерево меняет только его поток, отчет
+/// читает деревья всех потоков без блокировок и объединяет их; собственное время зоны
+/// (без вложенных) вычисляется при построении отчета. Время - такты TSC (MTscTimeMeter.h),
+/// в наносекунды переводится только в отчете.
+///
+/// Макросы MLIB_PROFILE_SCOPE и MLIB_PROFILE_FUNCTION раскрываются в код, только если
+/// определен MLIB_PROFILE_ENABLE, иначе - пусто. Включенные при компиляции зоны
+/// отключаются при выполнении setEnabled(false): тогда зона - одна проверка флага.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MPROFILER_H
+#define MPROFILER_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Место в коде, отмеченное зоной (статический объект)
+struct MProfileSite
+{
+    const char * name;
+    const char * function;
+    const char * file;
+    int line;
+};
+
+/// \brief Итоги зоны в объединенном дереве вызовов, время - в наносекундах
+struct MProfileRecord
+{
+    const MProfileSite * site;
+    unsigned depth;             ///< Глубина в дереве, 0 - внешние зоны
+    uint64_t count;             ///< Завершенных вызовов
+    uint64_t total;             ///< Суммарное время
+    uint64_t self;              ///< Суммарное время без вложенных зон
+    uint64_t min;               ///< Наименьшее время вызова
+    uint64_t max;               ///< Наибольшее время вызова
+};
+
+namespace profiler {
+
+namespace detail {
+
+struct Node;
+
+extern std::atomic<bool> enabled;
+
+/// Вход в зону site текущего потока, отсчет начала
+/// (0 - дерево потока уже возвращено: зона в деструкторе thread_local объекта)
+Node * enter(const MProfileSite & site);
+/// Выход из зоны, учет времени вызова
+void leave(Node * node);
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Включен ли учет зон (по умолчанию - да)
+inline bool isEnabled()
+{   return detail::enabled.load(std::memory_order_relaxed); }
+
+inline void setEnabled(bool on)
+{   detail::enabled.store(on, std::memory_order_relaxed); }
+
+/// \brief Итоги всех потоков: обход дерева в глубину, вложенные зоны - сразу за родительской,
+/// по убыванию суммарного времени
+///
+/// Незавершенные вызовы (например, внешней зоны, из которой строится отчет) не учтены.
+std::vector<MProfileRecord> collect();
+
+/// \brief Текстовый отчет по collect(): дерево зон с отступами и столбцы
+/// calls, total, self (мс), avg, min, max (мкс)
+std::string report();
+
+/// \brief Обнуление итогов всех потоков
+///
+/// Вызовы, которые завершаются во время сброса в других потоках, могут быть потеряны.
+void reset();
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace profiler
+
+/// \brief Зона профилирования: от конструктора до деструктора
+class MProfileZone
+{
+public:
+    explicit MProfileZone(const MProfileSite & site)
+        : m_node(profiler::isEnabled() ? profiler::detail::enter(site) : 0)
+    { ; }
+
+    ~MProfileZone()
+    {
+        if (m_node != 0)
+            profiler::detail::leave(m_node);
+    }
+
+private:
+    MProfileZone(const MProfileZone &);
+    MProfileZone & operator=(const MProfileZone &);
+
+    profiler::detail::Node * m_node;   ///< 0 - зона не учитывается
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define MLIB_PROFILE_CONCAT_IMPL(a, b) a##b
+#define MLIB_PROFILE_CONCAT(a, b) MLIB_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(MLIB_PROFILE_ENABLE)
+    /// Зона до конца текущей области видимости, name - строковый литерал
+    #define MLIB_PROFILE_SCOPE(name) \
+        static const ::MLIB_NAMESPACE::MProfileSite MLIB_PROFILE_CONCAT(mlibProfileSite, __LINE__) = \
+            { name, __FUNCTION__, __FILE__, __LINE__ }; \
+        ::MLIB_NAMESPACE::MProfileZone MLIB_PROFILE_CONCAT(mlibProfileZone, __LINE__) \
+            (MLIB_PROFILE_CONCAT(mlibProfileSite, __LINE__))
+    /// Зона с именем функции
+    #define MLIB_PROFILE_FUNCTION() MLIB_PROFILE_SCOPE(__FUNCTION__)
+#else
+    #define MLIB_PROFILE_SCOPE(name) static_cast<void>(0)
+    #define MLIB_PROFILE_FUNCTION() static_cast<void>(0)
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MPROFILER_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -15,114 +15,174 @@
  */
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @file MRandom.h
-/// @brief MRandom - обертка над стандартными функциями генерации случайного числа библиотеки C
+/// @brief MRandom - функции генерации случайного числа
 /// @author Mitrokhin S.V.
 /// @date 01.12.2017
+///
+/// Функции используют генератор xoshiro256** (MRandomEngine.h), свой для каждого потока,
+/// поэтому вызовы из разных потоков не блокируют друг друга и не делят состояние.
+/// Генератор потока при первом обращении инициализируется из системного источника
+/// энтропии (randomSeed), init(seed) задает воспроизводимую последовательность потока.
+/// init(seed, stream) выбирает неперекрывающуюся подпоследовательность с номером stream,
+/// например по номеру задачи; для большого числа задач удобнее генераторы на счетчике
+/// MPhilox4x32 и MThreefry4x64 (MRandomEngine.h).
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #ifndef MRANDOM_H
 #define MRANDOM_H
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "MGlobal.h"
-#include <cstdlib>
-#include <ctime>
+#include "MTypes.h"
+#include "MRandomEngine.h"
+#include "MRandomDistribution.h"
 #include <climits>
-//#include <random>
+#include <cstdlib>
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 MLIB_BEGIN_NAMESPACE
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 class MRandom
 {
 public:
+    typedef MXoshiro256ss engine_type;
 
-    /// @brief Инициализация генератора случайного числа
-    /// Задает стартовое начальное значение для генератора псевдослучайных чисел
+    /// @brief Генератор текущего потока
+    static inline engine_type & engine()
+    {
+        static thread_local engine_type e(randomSeed());
+        return e;
+    }
+
+    /// @brief Инициализация генератора текущего потока из системного источника энтропии
     static inline void init()
     {
-        // in Windows time_t is __time64_t
-        std::srand(static_cast<unsigned>(time(NULL)));
+        engine().seed(randomSeed());
+    }
+
+    /// @brief Инициализация генератора текущего потока заданным значением
+    static inline void init(uint64_t seed)
+    {
+        engine().seed(seed);
+    }
+
+    /// @brief Инициализация генератора текущего потока подпоследовательностью stream от seed
+    /// Подпоследовательности - отрезки по 2^128 значений (jump), время инициализации - O(stream)
+    static inline void init(uint64_t seed, uint64_t stream)
+    {
+        engine_type & e = engine();
+        e.seed(seed);
+        for (uint64_t i = 0; i < stream; ++i)
+            e.jump();
+    }
+
+    /// @brief 64 случайных бита
+    static inline uint64_t random64()
+    {
+        return engine()();
     }
 
-    /// @brief Функция возвращает псевдослучайное целое число в интервале [0; RAND_MAX]=[0; 32767]
-    /// Обертка rand()
+    /// @brief Функция возвращает псевдослучайное целое число в интервале [0; RAND_MAX]
     /// @return Псевдослучайное целое число в диапазоне от 0 до RAND_MAX
     static inline int random()
     {
-        return std::rand();
+        // RAND_MAX + 1 - степень двойки
+        return static_cast<int>((random64() >> 32) & RAND_MAX);
     }
 
     /// @brief Функция возвращает псевдослучайное целое число в интервале [min; max]
     /// min <= random number <= max
     static inline int randomRange(int min, int max)
     {
-        return std::rand() % (max - min + 1) + min;
+        return static_cast<int>(uniformInt(engine(), min, max));
     }
 
     static inline int64 randomRange(int64 min, int64 max)
     {
-        return std::rand() % (max - min + 1) + min;
+        return static_cast<int64>(uniformInt(engine(), min, max));
     }
 
-    /// @brief Функция возвращает псевдослучайное целое число в интервале [min; max]
+    /// @brief Функция возвращает псевдослучайное число в интервале [min; max]
     /// min <= random number <= max
     static inline double randomRange(double min, double max)
     {
-        return (static_cast<double>(std::rand()) / static_cast<double>(RAND_MAX)) * (max - min) + min;
+        return static_cast<double>(random64() >> 11) * (1.0 / 9007199254740991.0) * (max - min) + min;
+    }
+
+    /// @brief Заполнение буфера случайными байтами
+    static inline void fillRandom(void * data, size_t size)
+    {
+        mlib::fillRandom(engine(), data, size);
+    }
+
+    /// @brief Нормальное распределение N(mean, sigma^2)
+    static inline double randomNormal(double mean = 0, double sigma = 1)
+    {
+        return normal(engine(), mean, sigma);
+    }
+
+    /// @brief Экспоненциальное распределение с параметром lambda
+    static inline double randomExponential(double lambda = 1)
+    {
+        return exponential(engine(), lambda);
+    }
+
+    /// @brief Случайная перестановка count элементов
+    template <typename _Ty>
+    static inline void shuffle(_Ty * data, size_t count)
+    {
+        mlib::shuffle(engine(), data, count);
     }
 
     /// @brief Функция возвращает псевдослучайное целое число в интервале [0; 1]
     static inline bool random_bool()
     {
-        return static_cast<bool>(randomRange(0, 1));
+        return (random64() >> 63) != 0;
     }
 
-    /// @brief Функция возвращает псевдослучайное целое число в интервале [CHAR_MIN; CHAR_MAX]=[-128; 127]
+    /// @brief Функция возвращает псевдослучайное целое число в интервале [CHAR_MIN; CHAR_MAX]
     static inline char random_char()
     {
-        return static_cast<char>(std::rand() % (CHAR_MAX - CHAR_MIN + 1) + CHAR_MIN);
+        return static_cast<char>(random64() >> 56);
     }
 
     /// @brief Функция возвращает псевдослучайное целое число в интервале [0; UCHAR_MAX]=[0; 255]
     static inline uchar random_uchar()
     {
-        return static_cast<unsigned char>(std::rand() % (UCHAR_MAX + 1));
+        return static_cast<uchar>(random64() >> 56);
     }
 
-    /// @brief Функция возвращает псевдослучайное целое число в интервале [CHAR_MIN; CHAR_MAX]=[-128; 127]
+    /// @brief Функция возвращает псевдослучайное целое число в интервале [CHAR_MIN; CHAR_MAX]
     static inline int8 random_int8()
     {
-        return static_cast<int8>(std::rand() % (CHAR_MAX - CHAR_MIN + 1) + CHAR_MIN);
+        return static_cast<int8>(random64() >> 56);
     }
 
     /// @brief Функция возвращает псевдослучайное целое число в интервале [0; UCHAR_MAX]
     static inline uint8 random_uint8()
     {
-        return static_cast<uint8>(std::rand() % (UCHAR_MAX + 1));
+        return static_cast<uint8>(random64() >> 56);
     }
 
     /// @brief Функция возвращает псевдослучайное целое число в интервале [SHRT_MIN; SHRT_MAX]=[-32768; 32767]
     static inline int16 random_int16()
     {
-        return static_cast<int16>(std::rand() % (SHRT_MAX - SHRT_MIN + 1) + SHRT_MIN);
+        return static_cast<int16>(static_cast<int16_t>(random64() >> 48));
     }
 
     /// @brief Функция возвращает псевдослучайное целое число в интервале [0; USHRT_MAX]=[0; 65535]
     static inline uint16 random_uint16()
     {
-        return static_cast<uint16>(std::rand() % (USHRT_MAX + 1));
+        return static_cast<uint16>(random64() >> 48);
     }
 
     /// @brief Функция возвращает псевдослучайное целое число в интервале [INT_MIN; INT_MAX]=[-2,147,483,648; 2,147,483,647]
     static inline int32 random_int32()
     {
-        return static_cast<int32>(static_cast<double>(std::rand()) /
-                                  static_cast<double>(RAND_MAX) *
-                                  (static_cast<double>(INT_MAX) - static_cast<double>(INT_MIN)) + INT_MIN);
+        return static_cast<int32>(static_cast<int32_t>(random64() >> 32));
     }
 
-    /// @brief Функция возвращает псевдослучайное целое число в интервале [0; ULONG_MAX]=[0; 4,294,967,295]
+    /// @brief Функция возвращает псевдослучайное целое число во всем диапазоне типа uint32 (unsigned long)
     static inline uint32 random_uint32()
     {
-        return static_cast<uint32>(static_cast<double>(std::rand()) / static_cast<double>(RAND_MAX) * static_cast<double>(ULONG_MAX));
+        return static_cast<uint32>(random64());
     }
 };
 MLIB_END_NAMESPACE
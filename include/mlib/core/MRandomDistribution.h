@@ -0,0 +1,370 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MRandomDistribution.h
+/// @brief Распределения случайных чисел: равномерные, нормальное, экспоненциальное, перестановки
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Функции принимают любой генератор с полным диапазоном 32 или 64 бит (MRandomEngine.h,
+/// std::mt19937, std::mt19937_64). Результаты зависят только от выходов генератора и
+/// воспроизводимы на всех платформах.
+///
+/// - Целые в диапазоне - умножение со сдвигом (Lemire) без деления и без смещения:
+///   деление выполняется только в редком случае отбраковки (вероятность range / 2^64).
+/// - Вещественные в [0, 1) - 52 случайных бита в мантиссе числа из [1, 2) минус 1
+///   (float - 23 бита), без преобразования целого в вещественное.
+/// - Нормальное и экспоненциальное - метод зиккурата (Marsaglia, Tsang; 128 и 256 слоев):
+///   около 99% значений - одно 64-битное случайное число, одно умножение и сравнение.
+/// - Перемешивание - Фишер-Йейтс, выборка без возвращения - резервуарный алгоритм L (Li).
+///
+/// Пакетные функции fill* заполняют массив за один вызов. Для MXoshiro256ss они
+/// реализованы отдельно: генератор порождает несколько независимых потоков xoshiro256**,
+/// которые обрабатываются векторными командами (SSE2, AVX2). Последовательность
+/// при этом отличается от поэлементных вызовов, но так же воспроизводима.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MRANDOMDISTRIBUTION_H
+#define MRANDOMDISTRIBUTION_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include "MRandomEngine.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+/// Таблицы зиккурата: границы слоев x[0..N] (x[0] = V / f(R), x[1] = R, x[N] = 0) и f(x[i])
+extern const double cZigguratNormalX[129];
+extern const double cZigguratNormalF[129];
+extern const double cZigguratExpX[257];
+extern const double cZigguratExpF[257];
+
+/// 64 случайных бита (два выхода 32-битного генератора)
+template <class _Engine>
+inline uint64_t randomBits64(_Engine & e)
+{
+    static_assert(_Engine::min() == 0
+                  && (_Engine::max() == 0xFFFFFFFFu || _Engine::max() == ~static_cast<uint64_t>(0)),
+                  "engine must produce the full 32-bit or 64-bit range");
+    if (sizeof(typename _Engine::result_type) >= 8 && _Engine::max() != 0xFFFFFFFFu)
+        return static_cast<uint64_t>(e());
+    const uint64_t hi = static_cast<uint64_t>(e()) & 0xFFFFFFFFu;
+    return (hi << 32) | (static_cast<uint64_t>(e()) & 0xFFFFFFFFu);
+}
+
+/// Число из [0, 1) по старшим 52 битам
+inline double unitDouble(uint64_t bits)
+{
+    const uint64_t v = (bits >> 12) | 0x3FF0000000000000ull;
+    double d;
+    std::memcpy(&d, &v, sizeof(d));
+    return d - 1.0;
+}
+
+/// Число из [0, 1) по старшим 23 битам
+inline float unitFloat(uint64_t bits)
+{
+    const uint32_t v = static_cast<uint32_t>(bits >> 41) | 0x3F800000u;
+    float f;
+    std::memcpy(&f, &v, sizeof(f));
+    return f - 1.0f;
+}
+
+/// Хвост нормального распределения за R (Marsaglia)
+template <class _Engine>
+double normalTail(_Engine & e)
+{
+    const double r = cZigguratNormalX[1];
+    double a, b;
+    do
+    {
+        a = -std::log(1.0 - unitDouble(randomBits64(e))) / r;
+        b = -std::log(1.0 - unitDouble(randomBits64(e)));
+    }
+    while (b + b < a * a);
+    return r + a;
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Равномерные распределения
+
+/// \brief Целое из [0, range) без смещения, range > 0
+template <class _Engine>
+inline uint64_t uniformBounded(_Engine & e, uint64_t range)
+{
+    uint64_t x = detail::randomBits64(e);
+    uint64_t lo = x * range;
+    if (lo < range)
+    {
+        const uint64_t threshold = (0 - range) % range;
+        while (lo < threshold)
+        {
+            x = detail::randomBits64(e);
+            lo = x * range;
+        }
+    }
+    return detail::mulHigh64(x, range);
+}
+
+/// \brief Целое из [min, max] (включая max), допускается весь диапазон int64_t
+template <class _Engine>
+inline int64_t uniformInt(_Engine & e, int64_t min, int64_t max)
+{
+    const uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min) + 1;
+    const uint64_t r = range != 0 ? uniformBounded(e, range) : detail::randomBits64(e);
+    return static_cast<int64_t>(static_cast<uint64_t>(min) + r);
+}
+
+/// \brief Вещественное из [0, 1) с шагом 2^-52
+template <class _Engine>
+inline double uniformDouble(_Engine & e)
+{   return detail::unitDouble(detail::randomBits64(e)); }
+
+/// \brief Вещественное из [a, b)
+template <class _Engine>
+inline double uniformDouble(_Engine & e, double a, double b)
+{   return a + (b - a) * uniformDouble(e); }
+
+/// \brief Вещественное из [0, 1) с шагом 2^-23
+template <class _Engine>
+inline float uniformFloat(_Engine & e)
+{   return detail::unitFloat(detail::randomBits64(e)); }
+
+/// \brief Вещественное из [a, b)
+template <class _Engine>
+inline float uniformFloat(_Engine & e, float a, float b)
+{   return a + (b - a) * uniformFloat(e); }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Нормальное и экспоненциальное распределения (зиккурат)
+
+/// \brief Стандартное нормальное распределение N(0, 1)
+template <class _Engine>
+inline double normal(_Engine & e)
+{
+    using namespace detail;
+    for (;;)
+    {
+        // Биты 0-6 - слой, бит 7 - знак, биты 12-63 - координата
+        const uint64_t r = randomBits64(e);
+        const unsigned i = static_cast<unsigned>(r & 127);
+        const double x = unitDouble(r) * cZigguratNormalX[i];
+        // Знак без ветвления: переход по случайному биту предсказывается в половине случаев
+        const double sign = static_cast<double>(static_cast<int>(r & 128) - 64) * (1.0 / 64);
+        if (x < cZigguratNormalX[i + 1])
+            return sign * x;
+        if (i == 0)
+            return sign * normalTail(e);
+        // Клин между прямоугольником слоя и кривой
+        const double y = cZigguratNormalF[i]
+                         + unitDouble(randomBits64(e)) * (cZigguratNormalF[i + 1] - cZigguratNormalF[i]);
+        if (y < std::exp(-0.5 * x * x))
+            return sign * x;
+    }
+}
+
+/// \brief Нормальное распределение N(mean, sigma^2)
+template <class _Engine>
+inline double normal(_Engine & e, double mean, double sigma)
+{   return mean + sigma * normal(e); }
+
+/// \brief Экспоненциальное распределение с параметром 1
+template <class _Engine>
+inline double exponential(_Engine & e)
+{
+    using namespace detail;
+    for (;;)
+    {
+        // Биты 0-7 - слой, биты 12-63 - координата
+        const uint64_t r = randomBits64(e);
+        const unsigned i = static_cast<unsigned>(r & 255);
+        const double x = unitDouble(r) * cZigguratExpX[i];
+        if (x < cZigguratExpX[i + 1])
+            return x;
+        if (i == 0)
+            return cZigguratExpX[1] - std::log(1.0 - unitDouble(randomBits64(e)));
+        const double y = cZigguratExpF[i]
+                         + unitDouble(randomBits64(e)) * (cZigguratExpF[i + 1] - cZigguratExpF[i]);
+        if (y < std::exp(-x))
+            return x;
+    }
+}
+
+/// \brief Экспоненциальное распределение с параметром lambda (среднее 1 / lambda)
+template <class _Engine>
+inline double exponential(_Engine & e, double lambda)
+{   return exponential(e) / lambda; }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Перестановки и выборки
+
+/// \brief Случайная перестановка count элементов (Фишер-Йейтс)
+template <class _Engine, typename _Ty>
+inline void shuffle(_Engine & e, _Ty * data, size_t count)
+{
+    using std::swap;
+    for (size_t i = count; i > 1; --i)
+    {
+        const size_t j = static_cast<size_t>(uniformBounded(e, i));
+        swap(data[i - 1], data[j]);
+    }
+}
+
+/// \brief Выборка k из count элементов без возвращения (алгоритм L), один проход по data
+///
+/// Каждое подмножество из k элементов равновероятно, порядок элементов в out
+/// не случаен (при необходимости - shuffle).
+/// \return Количество выбранных элементов, min(k, count)
+template <class _Engine, typename _Ty>
+size_t sample(_Engine & e, const _Ty * data, size_t count, _Ty * out, size_t k)
+{
+    if (k > count)
+        k = count;
+    for (size_t i = 0; i < k; ++i)
+        out[i] = data[i];
+    if (k == 0 || k == count)
+        return k;
+
+    const double invK = 1.0 / static_cast<double>(k);
+    double w = std::exp(std::log1p(-uniformDouble(e)) * invK);
+    size_t i = k - 1;
+    for (;;)
+    {
+        // Количество пропускаемых элементов до следующей замены - геометрическое.
+        // log1p: при w < 1e-16 log(1 - w) обнулился бы, и skip стал бы -Inf
+        const double skip = std::floor(std::log1p(-uniformDouble(e)) / std::log1p(-w));
+        if (!(skip < static_cast<double>(count - 1 - i)))
+            break;
+        i += static_cast<size_t>(skip) + 1;
+        out[uniformBounded(e, k)] = data[i];
+        w *= std::exp(std::log1p(-uniformDouble(e)) * invK);
+    }
+    return k;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Пакетная генерация
+
+/// \brief size случайных байтов (слова генератора в порядке байтов платформы)
+template <class _Engine>
+inline void fillRandom(_Engine & e, void * data, size_t size)
+{
+    unsigned char * dst = static_cast<unsigned char *>(data);
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), dst += sizeof(uint64_t))
+    {
+        const uint64_t word = detail::randomBits64(e);
+        std::memcpy(dst, &word, sizeof(word));
+    }
+    if (size != 0)
+    {
+        const uint64_t word = detail::randomBits64(e);
+        std::memcpy(dst, &word, size);
+    }
+}
+
+/// \brief Массив целых, равномерно распределенных во всем диапазоне типа
+template <class _Engine, typename _Ty>
+inline void fillRandomArray(_Engine & e, _Ty * data, size_t count)
+{
+    static_assert(std::is_integral<_Ty>::value, "fillRandomArray requires an integral type");
+    fillRandom(e, static_cast<void *>(data), count * sizeof(_Ty));
+}
+
+/// \brief count случайных 64-битных слов
+template <class _Engine>
+inline void fillBits(_Engine & e, uint64_t * out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = detail::randomBits64(e);
+}
+
+/// \brief Целые из [0, range), range > 0
+template <class _Engine>
+inline void fillBounded(_Engine & e, uint32_t * out, size_t count, uint32_t range)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = static_cast<uint32_t>(uniformBounded(e, range));
+}
+
+/// \brief Вещественные из [a, b)
+template <class _Engine>
+inline void fillUniform(_Engine & e, double * out, size_t count, double a = 0, double b = 1)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = uniformDouble(e, a, b);
+}
+
+template <class _Engine>
+inline void fillUniform(_Engine & e, float * out, size_t count, float a = 0, float b = 1)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = uniformFloat(e, a, b);
+}
+
+/// \brief Нормальное распределение N(mean, sigma^2)
+template <class _Engine>
+inline void fillNormal(_Engine & e, double * out, size_t count, double mean = 0, double sigma = 1)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = normal(e, mean, sigma);
+}
+
+template <class _Engine>
+inline void fillNormal(_Engine & e, float * out, size_t count, float mean = 0, float sigma = 1)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = static_cast<float>(normal(e, mean, sigma));
+}
+
+/// \brief Экспоненциальное распределение с параметром lambda
+template <class _Engine>
+inline void fillExponential(_Engine & e, double * out, size_t count, double lambda = 1)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = exponential(e, lambda);
+}
+
+template <class _Engine>
+inline void fillExponential(_Engine & e, float * out, size_t count, float lambda = 1)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = static_cast<float>(exponential(e, lambda));
+}
+
+// Векторные реализации для xoshiro256** (несколько независимых потоков генератора).
+// fillRandom для буферов от 4 Мбайт пишет в обход кэша и упирается в пропускную способность памяти
+void fillRandom(MXoshiro256ss & e, void * data, size_t size);
+void fillBits(MXoshiro256ss & e, uint64_t * out, size_t count);
+void fillBounded(MXoshiro256ss & e, uint32_t * out, size_t count, uint32_t range);
+void fillUniform(MXoshiro256ss & e, double * out, size_t count, double a = 0, double b = 1);
+void fillUniform(MXoshiro256ss & e, float * out, size_t count, float a = 0, float b = 1);
+void fillNormal(MXoshiro256ss & e, double * out, size_t count, double mean = 0, double sigma = 1);
+void fillNormal(MXoshiro256ss & e, float * out, size_t count, float mean = 0, float sigma = 1);
+void fillExponential(MXoshiro256ss & e, double * out, size_t count, double lambda = 1);
+void fillExponential(MXoshiro256ss & e, float * out, size_t count, float lambda = 1);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MRANDOMDISTRIBUTION_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,520 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MRandomEngine.h
+/// @brief Генераторы псевдослучайных чисел: SplitMix64, xoshiro256**, PCG32, PCG64
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Генераторы - небольшие объекты-значения без общего состояния и блокировок, каждый поток
+/// использует свой экземпляр. Интерфейс совместим с UniformRandomBitGenerator, поэтому
+/// генераторы подходят и для распределений <random>.
+///
+/// | Генератор       | Состояние | Выход  | Период  | Назначение                            |
+/// |-----------------|-----------|--------|---------|---------------------------------------|
+/// | MSplitMix64     | 64 бит    | 64 бит | 2^64    | заполнение состояния других по seed   |
+/// | MXoshiro256ss   | 256 бит   | 64 бит | 2^256-1 | основной генератор (самый быстрый)    |
+/// | MPcg32          | 128 бит   | 32 бит | 2^64    | 2^63 независимых потоков по stream    |
+/// | MPcg64          | 256 бит   | 64 бит | 2^128   | 2^127 независимых потоков по stream   |
+/// | MPhilox4x32     | 64 бит    | 32 бит | 2^66    | 2^64 потоков, произвольный доступ     |
+/// | MThreefry4x64   | 128 бит   | 64 бит | 2^66    | 2^64 потоков, произвольный доступ     |
+///
+/// MPhilox4x32 и MThreefry4x64 - генераторы на счетчике (Salmon и др., Random123): значение
+/// с номером i - функция только от (seed, stream, i). Каждый обработчик создает свой
+/// генератор с ключом (seed, номер задачи) и получает одну и ту же последовательность
+/// при любом количестве потоков и порядке выполнения, discard() и seek() - за O(1).
+/// generate() вычисляет несколько блоков одновременно в векторных регистрах (AVX2).
+/// Для xoshiro256** независимые подпоследовательности дают jump() (2^128 шагов)
+/// и longJump() (2^192 шагов).
+///
+/// Генераторы не криптостойкие. Для начального значения из системного источника
+/// энтропии - randomSeed().
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MRANDOMENGINE_H
+#define MRANDOMENGINE_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include <cstddef>
+#include <cstdint>
+#if defined(MLIB_MSC) && defined(MLIB_ARCH_X86_64)
+    #include <intrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief 64 бита из системного источника энтропии (/dev/urandom)
+///
+/// Если источник недоступен - смесь времени, счетчика вызовов и адресов.
+uint64_t randomSeed();
+
+namespace detail {
+
+inline uint64_t rotl64(uint64_t x, int k)   { return (x << k) | (x >> (64 - k)); }
+inline uint32_t rotr32(uint32_t x, unsigned k)
+{   return (x >> k) | (x << ((32 - k) & 31)); }
+inline uint64_t rotr64(uint64_t x, unsigned k)
+{   return (x >> k) | (x << ((64 - k) & 63)); }
+
+#if defined(__SIZEOF_INT128__)
+/// 128-битное целое расширения GCC/Clang (__extension__ - без предупреждения -Wpedantic)
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+/// Старшие 64 бита произведения a * b
+inline uint64_t mulHigh64(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<uint128_t>(a) * b) >> 64);
+#elif defined(MLIB_MSC) && defined(MLIB_ARCH_X86_64)
+    return __umulh(a, b);
+#else
+    const uint64_t aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+    const uint64_t bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+    const uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SplitMix64 (Steele, Lea, Flood): счетчик с шагом золотого сечения и перемешивание
+class MSplitMix64
+{
+public:
+    typedef uint64_t result_type;
+
+    static MLIB_CONSTEXPR result_type min() { return 0; }
+    static MLIB_CONSTEXPR result_type max() { return ~static_cast<uint64_t>(0); }
+
+    explicit MSplitMix64(uint64_t seed = 0) : m_state(seed) {}
+
+    inline void seed(uint64_t seed) { m_state = seed; }
+
+    inline result_type operator()()
+    {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief xoshiro256** (Blackman, Vigna)
+class MXoshiro256ss
+{
+public:
+    typedef uint64_t result_type;
+
+    static MLIB_CONSTEXPR result_type min() { return 0; }
+    static MLIB_CONSTEXPR result_type max() { return ~static_cast<uint64_t>(0); }
+
+    /// \param seed - состояние заполняется четырьмя выходами SplitMix64(seed)
+    explicit MXoshiro256ss(uint64_t seed = 0) { this->seed(seed); }
+
+    inline void seed(uint64_t seed)
+    {
+        MSplitMix64 sm(seed);
+        for (int i = 0; i < 4; ++i)
+            m_s[i] = sm();
+    }
+
+    inline result_type operator()()
+    {
+        const uint64_t result = detail::rotl64(m_s[1] * 5, 7) * 9;
+        const uint64_t t = m_s[1] << 17;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = detail::rotl64(m_s[3], 45);
+        return result;
+    }
+
+    /// \brief Переход на 2^128 значений вперед: 2^128 неперекрывающихся подпоследовательностей
+    inline void jump()
+    {
+        static const uint64_t poly[4] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                          0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+        jump(poly);
+    }
+
+    /// \brief Переход на 2^192 значений вперед: 2^64 групп по 2^64 подпоследовательностей jump()
+    inline void longJump()
+    {
+        static const uint64_t poly[4] = { 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull,
+                                          0x77710069854EE241ull, 0x39109BB02ACBE635ull };
+        jump(poly);
+    }
+
+private:
+    /// Состояние после шага, заданного многочленом перехода (сумма состояний по его битам)
+    inline void jump(const uint64_t poly[4])
+    {
+        uint64_t s[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int b = 0; b < 64; ++b)
+            {
+                if (poly[i] & (static_cast<uint64_t>(1) << b))
+                {
+                    for (int k = 0; k < 4; ++k)
+                        s[k] ^= m_s[k];
+                }
+                (*this)();
+            }
+        }
+        for (int k = 0; k < 4; ++k)
+            m_s[k] = s[k];
+    }
+
+    uint64_t m_s[4];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PCG32 (O'Neill): 64-битный ЛКГ и выходная перестановка XSH RR
+class MPcg32
+{
+public:
+    typedef uint32_t result_type;
+
+    static MLIB_CONSTEXPR result_type min() { return 0; }
+    static MLIB_CONSTEXPR result_type max() { return ~static_cast<uint32_t>(0); }
+
+    /// \param seed   - начальное состояние
+    /// \param stream - номер последовательности, генераторы разных потоков не пересекаются
+    explicit MPcg32(uint64_t seed = 0x853C49E6748FEA9Bull, uint64_t stream = 0xDA3E39CB94B95BDBull >> 1)
+    {   this->seed(seed, stream); }
+
+    inline void seed(uint64_t seed, uint64_t stream = 0xDA3E39CB94B95BDBull >> 1)
+    {
+        m_state = 0;
+        m_inc = (stream << 1) | 1;
+        step();
+        m_state += seed;
+        step();
+    }
+
+    inline result_type operator()()
+    {
+        const uint64_t old = m_state;
+        step();
+        const uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        return detail::rotr32(xorshifted, static_cast<unsigned>(old >> 59));
+    }
+
+private:
+    inline void step() { m_state = m_state * 6364136223846793005ull + m_inc; }
+
+    uint64_t m_state;
+    uint64_t m_inc;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PCG64 (O'Neill): 128-битный ЛКГ и выходная перестановка XSL RR
+class MPcg64
+{
+public:
+    typedef uint64_t result_type;
+
+    static MLIB_CONSTEXPR result_type min() { return 0; }
+    static MLIB_CONSTEXPR result_type max() { return ~static_cast<uint64_t>(0); }
+
+    /// \param seed   - младшие 64 бита начального состояния (seedHigh - старшие)
+    /// \param stream - номер последовательности
+    explicit MPcg64(uint64_t seed = 0, uint64_t stream = 0)
+    {   this->seed(0, seed, 0, stream); }
+
+    /// \brief Полное 128-битное начальное состояние и номер последовательности
+    inline void seed(uint64_t seedHigh, uint64_t seedLow, uint64_t streamHigh, uint64_t streamLow)
+    {
+        m_hi = 0;
+        m_lo = 0;
+        m_incHi = (streamHigh << 1) | (streamLow >> 63);
+        m_incLo = (streamLow << 1) | 1;
+        step();
+        add(seedHigh, seedLow);
+        step();
+    }
+
+    inline void seed(uint64_t seed, uint64_t stream = 0)
+    {   this->seed(0, seed, 0, stream); }
+
+    inline result_type operator()()
+    {
+        step();
+        return detail::rotr64(m_hi ^ m_lo, static_cast<unsigned>(m_hi >> 58));
+    }
+
+private:
+    /// state += (hi, lo)
+    inline void add(uint64_t hi, uint64_t lo)
+    {
+        m_lo += lo;
+        m_hi += hi + (m_lo < lo ? 1 : 0);
+    }
+
+    /// state = state * M + inc, M = 2549297995355413924 * 2^64 + 4865540595714422341
+    inline void step()
+    {
+        const uint64_t mulHi = 2549297995355413924ull;
+        const uint64_t mulLo = 4865540595714422341ull;
+        const uint64_t hi = detail::mulHigh64(m_lo, mulLo) + m_lo * mulHi + m_hi * mulLo;
+        m_lo = m_lo * mulLo;
+        m_hi = hi;
+        add(m_incHi, m_incLo);
+    }
+
+    uint64_t m_hi;
+    uint64_t m_lo;
+    uint64_t m_incHi;
+    uint64_t m_incLo;
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Генераторы на счетчике
+
+namespace detail {
+
+/// Блок index Philox4x32-10: ключ key, счетчик (index, stream)
+inline void philox4x32Block(const uint32_t key[2], uint64_t stream, uint64_t index, uint32_t out[4])
+{
+    uint32_t c0 = static_cast<uint32_t>(index), c1 = static_cast<uint32_t>(index >> 32);
+    uint32_t c2 = static_cast<uint32_t>(stream), c3 = static_cast<uint32_t>(stream >> 32);
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; ++round)
+    {
+        const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+        const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+        c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c1 = static_cast<uint32_t>(p1);
+        c3 = static_cast<uint32_t>(p0);
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/// Циклические сдвиги раундов Threefry4x64
+const int cThreefryRot[8][2] = { {14, 16}, {52, 57}, {23, 40}, { 5, 37},
+                                 {25, 33}, {46, 12}, {58, 22}, {32, 32} };
+
+/// Блок index Threefry4x64-20: расширенный ключ ks, счетчик (index, 0, 0, 0)
+inline void threefry4x64Block(const uint64_t ks[5], uint64_t index, uint64_t out[4])
+{
+    uint64_t x0 = index + ks[0], x1 = ks[1], x2 = ks[2], x3 = ks[3];
+    for (int s = 1; s <= 5; ++s)
+    {
+        // Четыре раунда, затем добавление подключа s
+        for (int r = (s - 1) % 2 * 4, end = r + 4; r < end; r += 2)
+        {
+            x0 += x1; x1 = rotl64(x1, cThreefryRot[r][0]);     x1 ^= x0;
+            x2 += x3; x3 = rotl64(x3, cThreefryRot[r][1]);     x3 ^= x2;
+            x0 += x3; x3 = rotl64(x3, cThreefryRot[r + 1][0]); x3 ^= x0;
+            x2 += x1; x1 = rotl64(x1, cThreefryRot[r + 1][1]); x1 ^= x2;
+        }
+        x0 += ks[s % 5];
+        x1 += ks[(s + 1) % 5];
+        x2 += ks[(s + 2) % 5];
+        x3 += ks[(s + 3) % 5] + static_cast<uint64_t>(s);
+    }
+    out[0] = x0;
+    out[1] = x1;
+    out[2] = x2;
+    out[3] = x3;
+}
+
+/// Блоки first .. first + count - 1 Philox4x32-10, по 4 слова на блок подряд
+void philox4x32Blocks(const uint32_t key[2], uint64_t stream, uint64_t first, size_t count, uint32_t * out);
+/// Блоки first .. first + count - 1 Threefry4x64-20, ks - расширенный ключ
+void threefry4x64Blocks(const uint64_t ks[5], uint64_t first, size_t count, uint64_t * out);
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Philox4x32-10: 10 раундов умножения 32x32->64 над 128-битным счетчиком
+///
+/// Ключ - seed, счетчик - (номер блока, stream), блок - 4 значения.
+class MPhilox4x32
+{
+public:
+    typedef uint32_t result_type;
+
+    static MLIB_CONSTEXPR result_type min() { return 0; }
+    static MLIB_CONSTEXPR result_type max() { return ~static_cast<uint32_t>(0); }
+
+    /// \param seed   - ключ
+    /// \param stream - номер последовательности (например, номер задачи)
+    explicit MPhilox4x32(uint64_t seed = 0, uint64_t stream = 0) { this->seed(seed, stream); }
+
+    inline void seed(uint64_t seed, uint64_t stream = 0)
+    {
+        m_key[0] = static_cast<uint32_t>(seed);
+        m_key[1] = static_cast<uint32_t>(seed >> 32);
+        m_stream = stream;
+        m_block = 0;
+        m_pos = 4;
+    }
+
+    inline result_type operator()()
+    {
+        if (m_pos == 4)
+        {
+            block(m_block++, m_buffer);
+            m_pos = 0;
+        }
+        return m_buffer[m_pos++];
+    }
+
+    /// \brief Номер следующего значения последовательности
+    inline uint64_t position() const { return m_block * 4 - (4 - m_pos); }
+
+    /// \brief Переход к значению с номером position
+    inline void seek(uint64_t position)
+    {
+        m_block = position / 4;
+        m_pos = 4;
+        if (position % 4 != 0)
+        {
+            block(m_block++, m_buffer);
+            m_pos = static_cast<unsigned>(position % 4);
+        }
+    }
+
+    /// \brief Пропуск n значений
+    inline void discard(uint64_t n) { seek(position() + n); }
+
+    /// \brief Блок с номером index (не меняет позицию)
+    inline void block(uint64_t index, result_type out[4]) const
+    {   detail::philox4x32Block(m_key, m_stream, index, out); }
+
+    /// \brief count следующих значений (та же последовательность, что и при вызовах operator())
+    inline void generate(result_type * out, size_t count)
+    {
+        while (count != 0 && m_pos != 4)
+        {
+            *out++ = m_buffer[m_pos++];
+            --count;
+        }
+        const size_t blocks = count / 4;
+        detail::philox4x32Blocks(m_key, m_stream, m_block, blocks, out);
+        m_block += blocks;
+        for (size_t i = blocks * 4; i < count; ++i)
+            out[i] = (*this)();
+    }
+
+private:
+    uint32_t m_key[2];
+    uint64_t m_stream;
+    uint64_t m_block;           ///< Номер следующего блока
+    unsigned m_pos;             ///< Позиция в m_buffer, 4 - буфер исчерпан
+    uint32_t m_buffer[4];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Threefry4x64-20: 20 раундов сложения, циклического сдвига и исключающего ИЛИ
+///
+/// Ключ - (seed, stream, 0, 0), счетчик - номер блока, блок - 4 значения.
+class MThreefry4x64
+{
+public:
+    typedef uint64_t result_type;
+
+    static MLIB_CONSTEXPR result_type min() { return 0; }
+    static MLIB_CONSTEXPR result_type max() { return ~static_cast<uint64_t>(0); }
+
+    /// \param seed   - ключ
+    /// \param stream - номер последовательности (например, номер задачи)
+    explicit MThreefry4x64(uint64_t seed = 0, uint64_t stream = 0) { this->seed(seed, stream); }
+
+    inline void seed(uint64_t seed, uint64_t stream = 0)
+    {
+        m_ks[0] = seed;
+        m_ks[1] = stream;
+        m_ks[2] = 0;
+        m_ks[3] = 0;
+        m_ks[4] = 0x1BD11BDAA9FC1A22ull ^ seed ^ stream;
+        m_block = 0;
+        m_pos = 4;
+    }
+
+    inline result_type operator()()
+    {
+        if (m_pos == 4)
+        {
+            block(m_block++, m_buffer);
+            m_pos = 0;
+        }
+        return m_buffer[m_pos++];
+    }
+
+    /// \brief Номер следующего значения последовательности
+    inline uint64_t position() const { return m_block * 4 - (4 - m_pos); }
+
+    /// \brief Переход к значению с номером position
+    inline void seek(uint64_t position)
+    {
+        m_block = position / 4;
+        m_pos = 4;
+        if (position % 4 != 0)
+        {
+            block(m_block++, m_buffer);
+            m_pos = static_cast<unsigned>(position % 4);
+        }
+    }
+
+    /// \brief Пропуск n значений
+    inline void discard(uint64_t n) { seek(position() + n); }
+
+    /// \brief Блок с номером index (не меняет позицию)
+    inline void block(uint64_t index, result_type out[4]) const
+    {   detail::threefry4x64Block(m_ks, index, out); }
+
+    /// \brief count следующих значений (та же последовательность, что и при вызовах operator())
+    inline void generate(result_type * out, size_t count)
+    {
+        while (count != 0 && m_pos != 4)
+        {
+            *out++ = m_buffer[m_pos++];
+            --count;
+        }
+        const size_t blocks = count / 4;
+        detail::threefry4x64Blocks(m_ks, m_block, blocks, out);
+        m_block += blocks;
+        for (size_t i = blocks * 4; i < count; ++i)
+            out[i] = (*this)();
+    }
+
+private:
+    uint64_t m_ks[5];           ///< Ключ и его четность (расширенный ключ)
+    uint64_t m_block;           ///< Номер следующего блока
+    unsigned m_pos;             ///< Позиция в m_buffer, 4 - буфер исчерпан
+    uint64_t m_buffer[4];
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MRANDOMENGINE_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MResample.h
+/// @brief Интерполяция с учетом перехода угла через 0/2ПИ, развертка фазы, передискретизация
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Угловые варианты считают разность соседних углов сокращенной до (-ПИ, ПИ] (как modPi),
+/// т.е. интерполируют по кратчайшей дуге. Результат угловых функций - в [0, 2ПИ) (как mod2Pi).
+///
+/// Развертка фазы: out[i] = in[i] + 2ПИ k[i], где целое k[i] выбирается так, чтобы
+/// out[i] - out[i - 1] попадало в (-ПИ, ПИ]. Число оборотов накапливается в целых, поэтому
+/// ошибка округления не растет с длиной ряда. Скачки NaN, Inf и больше 2^30 рад пропускаются
+/// без изменения числа оборотов.
+///
+/// Передискретизация: ряд с неравномерными, строго возрастающими отсчетами времени
+/// переводится на равномерную сетку start + j step. Вне интервала ряда - крайние значения.
+/// Кубический вариант - эрмитов сплайн с производными по трем точкам (второй порядок для
+/// неравномерного шага), на краях - односторонние разности.
+///
+/// Векторизованы поэлементные операции (interpolateAngle, поиск оборотов при развертке,
+/// сокращение результата угловой передискретизации); проход по отрезкам ряда - скалярный.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MRESAMPLE_H
+#define MRESAMPLE_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMath.h"
+#include <cstddef>
+#include <cstdint>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Метод интерполяции при передискретизации
+enum ResampleMethod
+{
+    ResampleLinear,     ///< Линейная
+    ResampleCubic       ///< Кубический эрмитов сплайн
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Угол между двумя углами
+
+/// \brief Интерполяция угла от a к b по кратчайшей дуге, t в [0, 1], результат в [0, 2ПИ)
+template <typename _Ty>
+inline _Ty lerpAngle(_Ty a, _Ty b, _Ty t)
+{   return mod2Pi(a + t * modPi(b - a)); }
+
+/// \brief Поэлементная интерполяция углов по кратчайшей дуге: out[i] = lerpAngle(a[i], b[i], t[i])
+void interpolateAngle(const float * a, const float * b, const float * t, float * out, size_t count);
+void interpolateAngle(const double * a, const double * b, const double * t, double * out, size_t count);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Развертка фазы
+
+/// \brief Развертка фазы блока с продолжением предыдущего
+/// \param prev  - последнее входное значение предыдущего блока (обновляется)
+/// \param turns - накопленное число оборотов (обновляется)
+void unwrap(const float * in, float * out, size_t count, float & prev, int64_t & turns);
+void unwrap(const double * in, double * out, size_t count, double & prev, int64_t & turns);
+
+/// \brief Развертка фазы массива, out[0] = in[0]
+template <typename _Ty>
+inline void unwrap(const _Ty * in, _Ty * out, size_t count)
+{
+    if (count == 0)
+        return;
+    _Ty prev = in[0];
+    int64_t turns = 0;
+    unwrap(in, out, count, prev, turns);
+}
+
+/// \brief Потоковая развертка фазы
+template <typename _Ty>
+class MPhaseUnwrap
+{
+public:
+    MPhaseUnwrap() : m_prev(0), m_turns(0), m_started(false) {}
+
+    void reset()
+    {
+        m_prev = 0;
+        m_turns = 0;
+        m_started = false;
+    }
+
+    /// \brief Развертка следующего значения
+    inline _Ty update(_Ty value)
+    {
+        _Ty out;
+        update(&value, &out, 1);
+        return out;
+    }
+
+    /// \brief Развертка следующего блока значений (допускается in == out)
+    inline void update(const _Ty * in, _Ty * out, size_t count)
+    {
+        if (count == 0)
+            return;
+        if (!m_started)
+        {
+            m_prev = in[0];
+            m_started = true;
+        }
+        unwrap(in, out, count, m_prev, m_turns);
+    }
+
+    /// \brief Накопленное число оборотов
+    inline int64_t turns() const { return m_turns; }
+
+private:
+    _Ty m_prev;
+    int64_t m_turns;
+    bool m_started;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Передискретизация на равномерную сетку
+
+/// \brief Значения ряда (time, value) в моменты start + j step, j = 0 .. outCount - 1
+///
+/// time строго возрастает. Для пустого ряда результат - NaN.
+void resample(const float * time, const float * value, size_t count,
+              float start, float step, float * out, size_t outCount,
+              ResampleMethod method = ResampleLinear);
+void resample(const double * time, const double * value, size_t count,
+              double start, double step, double * out, size_t outCount,
+              ResampleMethod method = ResampleLinear);
+
+/// \brief То же для углов (рад): интерполяция по кратчайшей дуге, результат в [0, 2ПИ)
+void resampleAngle(const float * time, const float * value, size_t count,
+                   float start, float step, float * out, size_t outCount,
+                   ResampleMethod method = ResampleLinear);
+void resampleAngle(const double * time, const double * value, size_t count,
+                   double start, double step, double * out, size_t outCount,
+                   ResampleMethod method = ResampleLinear);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MRESAMPLE_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MStatistics.h
+/// @brief Накопители статистики потока за один проход
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// MRunningStats - количество, среднее, дисперсия, минимум, максимум. Среднее и сумма квадратов
+/// отклонений (M2) обновляются по Уэлфорду, без вычитания больших близких сумм. Накопители
+/// объединяются (merge) по формуле Чана для параллельной дисперсии, поэтому статистику можно
+/// считать по потокам и затем сложить.
+///
+/// Пакетное обновление обрабатывает данные блоками: среднее и M2 блока считаются в два прохода
+/// по кешу векторными командами (SSE2/AVX2/AVX-512F), затем блок объединяется с накопленным
+/// так же, как в merge. Накопление всегда в double, в т.ч. для данных float.
+///
+/// NaN в данных делает среднее и дисперсию NaN, минимум и максимум для них не определены.
+///
+/// MEwma - экспоненциально взвешенные среднее и дисперсия с коэффициентом alpha.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MSTATISTICS_H
+#define MSTATISTICS_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Количество, среднее, дисперсия, минимум и максимум потока значений
+class MRunningStats
+{
+public:
+    MRunningStats() { reset(); }
+
+    /// \brief Сброс в пустое состояние
+    void reset()
+    {
+        m_count = 0;
+        m_mean = 0.0;
+        m_m2 = 0.0;
+        m_min = std::numeric_limits<double>::infinity();
+        m_max = -std::numeric_limits<double>::infinity();
+    }
+
+    /// \brief Добавление одного значения
+    inline void update(double x)
+    {
+        ++m_count;
+        const double delta = x - m_mean;
+        m_mean += delta / static_cast<double>(m_count);
+        m_m2 += delta * (x - m_mean);
+        m_min = x < m_min ? x : m_min;
+        m_max = x > m_max ? x : m_max;
+    }
+
+    /// \brief Добавление массива значений
+    void update(const float * data, size_t count);
+    void update(const double * data, size_t count);
+
+    /// \brief Объединение с другим накопителем (результат - статистика обоих потоков)
+    void merge(const MRunningStats & other);
+
+    inline uint64_t count() const { return m_count; }
+    inline bool isEmpty() const   { return m_count == 0; }
+
+    /// \brief Среднее (0 для пустого)
+    inline double mean() const    { return m_mean; }
+    /// \brief Сумма значений
+    inline double sum() const     { return m_mean * static_cast<double>(m_count); }
+
+    /// \brief Дисперсия генеральной совокупности M2 / n (0 для пустого)
+    inline double variance() const
+    {   return m_count > 0 ? m_m2 / static_cast<double>(m_count) : 0.0; }
+    /// \brief Несмещенная выборочная дисперсия M2 / (n - 1) (0 при n < 2)
+    inline double sampleVariance() const
+    {   return m_count > 1 ? m_m2 / static_cast<double>(m_count - 1) : 0.0; }
+    /// \brief Стандартное отклонение sqrt(variance())
+    inline double stdDev() const        { return std::sqrt(variance()); }
+    inline double sampleStdDev() const  { return std::sqrt(sampleVariance()); }
+
+    /// \brief Минимум (+Inf для пустого) и максимум (-Inf для пустого)
+    /// (в скобках - от макросов min/max из windows.h)
+    inline double (min)() const { return m_min; }
+    inline double (max)() const { return m_max; }
+
+private:
+    /// Объединение с частью (n, mean, m2, min, max)
+    void mergePart(uint64_t n, double mean, double m2, double mn, double mx);
+
+    uint64_t m_count;
+    double m_mean;
+    double m_m2;    ///< Сумма квадратов отклонений от среднего
+    double m_min;
+    double m_max;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Экспоненциально взвешенные скользящие среднее и дисперсия
+///
+/// mean += alpha (x - mean), var = (1 - alpha) (var + alpha (x - mean_old)²). Первое значение
+/// принимается за среднее без смещения к нулю. Эффективная длина окна ~ 2 / alpha - 1.
+class MEwma
+{
+public:
+    /// \param alpha - вес нового значения, (0, 1]
+    explicit MEwma(double alpha) : m_alpha(alpha) { reset(); }
+
+    /// \brief Коэффициент alpha для окна из span значений: 2 / (span + 1)
+    static inline double alphaForSpan(double span)  { return 2.0 / (span + 1.0); }
+    /// \brief Коэффициент alpha для периода полураспада halfLife значений
+    static inline double alphaForHalfLife(double halfLife)
+    {   return 1.0 - std::exp(-0.69314718055994530942 / halfLife); }
+
+    void reset()
+    {
+        m_count = 0;
+        m_mean = 0.0;
+        m_var = 0.0;
+    }
+
+    inline void update(double x)
+    {
+        if (m_count++ == 0)
+        {
+            m_mean = x;
+            return;
+        }
+        const double delta = x - m_mean;
+        const double incr = m_alpha * delta;
+        m_mean += incr;
+        m_var = (1.0 - m_alpha) * (m_var + delta * incr);
+    }
+
+    /// \brief Добавление массива значений (по порядку)
+    void update(const float * data, size_t count);
+    void update(const double * data, size_t count);
+
+    inline double alpha() const     { return m_alpha; }
+    inline uint64_t count() const   { return m_count; }
+    inline double mean() const      { return m_mean; }
+    inline double variance() const  { return m_var; }
+    inline double stdDev() const    { return std::sqrt(m_var); }
+
+private:
+    double m_alpha;
+    uint64_t m_count;
+    double m_mean;
+    double m_var;
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MSTATISTICS_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -22,19 +22,30 @@
 /// Счетчики времени, по умолчанию, высокого разрешения
 /// см. комментарии к реализации
 ///
+/// MPosixTimeMeter, MWinTimeMeter и MTimeMeter - один шаблон MBasicTimeMeter на разных
+/// часах (clock_gettime, QueryPerformanceCounter, steady_clock). Отсчет - вызов часов
+/// и целочисленное вычитание, единицы переводятся при компиляции через std::ratio.
+/// Для участков кода короче 100 нс - MTscTimeMeter (MTscTimeMeter.h).
+///
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #ifndef MTIMEMETER_H
 #define MTIMEMETER_H
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "MGlobal.h"
-#if defined(MLIB_OS_WIN)    
+#if defined(MLIB_OS_WIN)
+    // Без макросов min/max: они ломают min()/max() классов библиотеки и std::min/std::max
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
     #include <windows.h>
 #endif
 #if defined(MLIB_LIB_QT)
     #include <QTime>
 #endif
+#include <cstdint>
 #include <ctime>
 #include <chrono>
+#include <ratio>
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 MLIB_BEGIN_NAMESPACE
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -48,360 +59,245 @@ public:
     virtual bool isActive() const = 0;
 };
 
-
-#if defined(MLIB_OS_WIN) && (_WIN32_WINNT >= _WIN32_WINNT_VISTA)
-/// @brief Cчетчик времени низкого разрешения
-/// Используются функции подсчета тиков (разрешение в диапазоне 10 - 16 ms)
-class MWinTimeMeterLr
-{
-public:
-    inline MWinTimeMeterLr() : m_uSaveTime(0)
-    { ; }
-
-    inline MWinTimeMeterLr(const MWinTimeMeterLr& timeMeter)
-    { *this = timeMeter; }
-
-    inline MWinTimeMeterLr & operator=(const MWinTimeMeterLr& timeMeter)
-    {
-        this->m_uSaveTime = timeMeter.m_uSaveTime;
-        return *this;
-    }
-
-    /// @brief Начать измерение
-    inline void start()
-    { m_uSaveTime = ::GetTickCount64(); }
-
-    /// @brief Начать измерение заново
-    /// return  Время прошедшее от начала измерения (в миллисекундах)
-    inline uint64_t restart()
-    {
-        uint64_t uTime = msecs();
-        start();
-        return uTime;
-    }
-
-    /// @brief Время прошедшее от начала измерения (в секундах)
-    inline double secs()
-    { return msecs() / 1e+3; }
-
-    /// @brief Время прошедшее от начала измерения (в миллисекундах)
-    inline uint64_t msecs()
-    { return ::GetTickCount64() - m_uSaveTime; }
-
-protected:
-    uint64_t m_uSaveTime;
-};
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-/// @brief Cчетчик времени высокого разрешения реализованный на API ОС Windows
-/// В документации упоминается как Windows High-Resolution Timer
-class MWinTimeMeter : public MAbstractTimeMeter
+/// @brief Счетчик времени на часах Clock
+/// @tparam Clock - часы с интерфейсом std::chrono (duration, time_point, now())
+/// @tparam Rep - тип целочисленных результатов
+///
+/// Целочисленные результаты считаются без double: разность отсчетов переводится в нужные
+/// единицы duration_cast с коэффициентом, известным при компиляции. isActive() внутри
+/// класса вызывается с квалификацией - без обращения к таблице виртуальных функций.
+template <class Clock, class Rep = int64_t>
+class MBasicTimeMeter : public MAbstractTimeMeter
 {
 public:
+    typedef Clock clock_type;
+    typedef typename Clock::duration duration;
+    typedef typename Clock::time_point time_point;
 
     /// @brief Конструктор
-    inline MWinTimeMeter()
-    {
-        ::QueryPerformanceFrequency(&m_frequency);
-        m_time.QuadPart = 0;
-    }
-
-    inline MWinTimeMeter(const MWinTimeMeter& timeMeter)
-    { *this = timeMeter; }
-
-    inline MWinTimeMeter & operator=(const MWinTimeMeter& timeMeter)
-    {
-        this->m_time = timeMeter.m_time;
-        return *this;
-    }
+    inline MBasicTimeMeter() : m_startTime()
+    { ; }
 
+    ///
     /// @brief Начать измерение времени
     inline void start()
-    { ::QueryPerformanceCounter(&m_time); }
+    {   m_startTime = Clock::now(); }
 
-    /// @brief Начать измерение время
+    ///
+    /// @brief Начать измерение времени
     /// @return Время прошедшее от начала измерения (в секундах)
     inline double restart()
     {
-        double dTime = secsf();
-        start();
-        return dTime;
-    }
-
-    /// @brief Остановить измерение времени
-    inline void stop()
-    {   m_time.QuadPart = 0; }
-
-    /// @brief Измеряется ли время
-    inline bool isActive() const
-    {   return (m_time.QuadPart != 0) ? true : false; }
-
-    /// @brief Прошедшее время в секундах
-    inline double secsf() const
-    {
-        if (!isActive())
-            return 0.0;
-        LARGE_INTEGER largeTime;
-        ::QueryPerformanceCounter(&largeTime);
-        // Вычисляем количество тиков
-        largeTime.QuadPart -= m_time.QuadPart;
-        // Переводим тики в секунды
-        return static_cast<double>(largeTime.QuadPart)/static_cast<double>(m_frequency.QuadPart);
-    }
-
-    inline int64_t secsi() const
-    {
-        if (!isActive())
-            return 0.0;
-        LARGE_INTEGER largeTime;
-        ::QueryPerformanceCounter(&largeTime);
-        // Вычисляем количество тиков
-        largeTime.QuadPart -= m_time.QuadPart;
-        // Переводим тики в секунды
-        return largeTime.QuadPart / m_frequency.QuadPart;
-    }
-
-    /// @brief Прошедшее время в миллисекундах
-    inline double msecsf() const
-    { return secsf() * 1e+3; }
-
-    /// @brief Прошедшее время в микросекундах
-    inline double mksecsf() const
-    { return secsf() * 1e+6; }
-
-    /// @brief Прошедшее время в наносекундах (погрешность!)
-    inline double nsecsf() const
-    { return secsf() * 1e+9; }
-
-protected:
-    LARGE_INTEGER m_frequency;
-    LARGE_INTEGER m_time;
-};
-
-typedef MWinTimeMeter   MTimeMeterWin;
-#endif // defined(MLIB_OS_WIN)
-
-/// @brief Cчетчик времени высокого разрешения на базе библиотеки C POSIX
-/// @warning В библиотеке GNU C вы можете просто вычесть значения time_t. Но в других системах тип данных time_t может использовать другую кодировку, где вычитание не работает непосредственно.
-class MPosixTimeMeter : public MAbstractTimeMeter
-{
-public:
-
-    /// @brief Конструктор
-    inline MPosixTimeMeter()
-    {
-        m_startTime.tv_nsec = 0;
-        m_startTime.tv_sec = 0;
-    }
-
-    inline MPosixTimeMeter(const MPosixTimeMeter& timeMeter)
-    { *this = timeMeter; }
-
-    inline MPosixTimeMeter & operator=(const MPosixTimeMeter& timeMeter)
-    {
-        this->m_startTime = timeMeter.m_startTime;
-        return *this;
+        const time_point now = Clock::now();
+        const duration time = MBasicTimeMeter::isActive() ? now - m_startTime : duration::zero();
+        m_startTime = now;
+        return std::chrono::duration<double>(time).count();
     }
 
     ///
     /// @brief Начать измерение времени
-    inline void start()
-    {   clock_gettime(CLOCK_MONOTONIC, &m_startTime); }
-
-    ///
-    /// @brief Начать измерение времени
-    /// @return Время прошедшее от начала измерения (в секундах)
-    inline double restart()
+    /// @return Время прошедшее от начала измерения (в наносекундах)
+    inline uint64_t restartNsecs()
     {
-        double dTime = secsf();
-        start();
-        return dTime;
+        const time_point now = Clock::now();
+        const duration time = MBasicTimeMeter::isActive() ? now - m_startTime : duration::zero();
+        m_startTime = now;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
     }
 
     ///
     /// @brief Остановить измерение времени
     inline void stop()
-    {   m_startTime.tv_nsec = m_startTime.tv_sec = 0; }
+    {   m_startTime = time_point(); }
 
     ///
     /// @brief Измеряется ли время
     inline bool isActive() const
-    {   return !((m_startTime.tv_nsec == 0) && (m_startTime.tv_sec == 0)); }    
+    {   return m_startTime != time_point(); }
+
+    ///
+    /// @brief Прошедшее время в единицах часов
+    inline duration elapsed() const
+    {   return MBasicTimeMeter::isActive() ? Clock::now() - m_startTime : duration::zero(); }
+
+    ///
+    /// @brief Прошедшее время в единицах Period (std::milli, std::micro...), целое
+    template <class Period>
+    inline Rep count() const
+    {   return std::chrono::duration_cast<std::chrono::duration<Rep, Period> >(elapsed()).count(); }
+
+    ///
+    /// @brief Прошедшее время в единицах Period, дробное
+    template <class Period>
+    inline double countf() const
+    {   return std::chrono::duration<double, Period>(elapsed()).count(); }
 
     ///
     /// @brief Прошедшее время в секундах
     inline double secsf() const
-    {
-        if (!isActive())
-            return 0.0;
-        timespec time;
-        clock_gettime(CLOCK_MONOTONIC, &time);
-        return (time.tv_sec - m_startTime.tv_sec) + ((time.tv_nsec - m_startTime.tv_nsec) / 1e+9) ;
-    }
+    {   return countf<std::ratio<1> >(); }
 
-    inline std::time_t secsi() const
-    {
-        if (!isActive())
-            return 0.0;
-        timespec time;
-        clock_gettime(CLOCK_MONOTONIC, &time);
-        return (time.tv_sec - m_startTime.tv_sec);
-    }
+    inline Rep secsi() const
+    {   return count<std::ratio<1> >(); }
 
     ///
     /// @brief Прошедшее время в миллисекундах
     inline double msecsf() const
-    { return secsf() * 1e+3; }
+    {   return countf<std::milli>(); }
 
-    inline std::time_t msecsi() const
-    { return static_cast<std::time_t>(secsf() * 1e+3); }
+    inline Rep msecsi() const
+    {   return count<std::milli>(); }
 
     ///
     /// @brief Прошедшее время в микросекундах
     inline double usecsf() const
-    { return secsf() * 1e+6; }
+    {   return countf<std::micro>(); }
+
+    inline Rep usecsi() const
+    {   return count<std::micro>(); }
 
-    inline std::time_t usecsi() const
-    { return static_cast<std::time_t>(secsf() * 1e+6); }
+    inline double mksecsf() const
+    {   return usecsf(); }
 
     ///
     /// @brief Прошедшее время в наносекундах
-    /// @return Число типа double (дробная часть не используется)
     inline double nsecsf() const
-    {
-        if (!isActive())
-            return 0.0;
-        timespec time;
-        clock_gettime(CLOCK_MONOTONIC, &time);
-        return (((time.tv_sec - m_startTime.tv_sec) * 1e+9) + (time.tv_nsec - m_startTime.tv_nsec));
-    }
+    {   return countf<std::nano>(); }
 
-    ///
-    /// @brief Прошедшее время в наносекундах
-    /// @return Целое число типа time_t, которое переопределяется в зависимости от платформы в 32 или 64 бита
-    inline std::time_t nsecsi() const
-    {
-        if (!isActive())
-            return 0.0;
-        timespec time;
-        clock_gettime(CLOCK_MONOTONIC, &time);
-        return (((time.tv_sec - m_startTime.tv_sec) * 1e+9) + (time.tv_nsec - m_startTime.tv_nsec));
-    }
+    inline Rep nsecsi() const
+    {   return count<std::nano>(); }
 
-    ///
-    /// @brief Прошедшее время в наносекундах
-    /// @return Целое число типа time_t, которое переопределяется в зависимости от платформы в 32 или 64 бита
     inline uint64_t nsecsi64() const
-    {
-        if (!isActive())
-            return 0.0;
-        timespec time;
-        clock_gettime(CLOCK_MONOTONIC, &time);
-        return (((time.tv_sec - m_startTime.tv_sec) * 1000000000ull) + (time.tv_nsec - m_startTime.tv_nsec));
-    }
+    {   return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed()).count()); }
 
 protected:
-    timespec m_startTime;
+    time_point m_startTime;     ///< Отсчет начала измерения, time_point() - не измеряется
 };
 
-// Для совместимости
-#define time_secs   secsf
-#define time_msecs  msecsf
-#define time_mksecs mksecsf
-#define time_nsecf  nsecsf
-
-#define secs   secsf
-#define msecs  msecsf
-#define mksecs usecsf
-#define nsecf  nsecsf
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Часы CLOCK_MONOTONIC библиотеки C POSIX в наносекундах
+struct MPosixClock
+{
+    typedef std::chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef std::chrono::time_point<MPosixClock> time_point;
+    static const bool is_steady = true;
 
-#if MLIB_SUPPORT_STD_CPP11
+    static inline time_point now()
+    {
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return time_point(duration(static_cast<rep>(time.tv_sec) * 1000000000 + time.tv_nsec));
+    }
+};
 
-class MTimeMeter : public MAbstractTimeMeter
+#if defined(MLIB_OS_WIN) && (_WIN32_WINNT >= _WIN32_WINNT_VISTA)
+/// @brief Cчетчик времени низкого разрешения
+/// Используются функции подсчета тиков (разрешение в диапазоне 10 - 16 ms)
+class MWinTimeMeterLr
 {
 public:
+    inline MWinTimeMeterLr() : m_uSaveTime(0)
+    { ; }
 
-    /// @brief Начать измерение времени
-    inline void start()
-    {   m_startTimePoint = std::chrono::steady_clock::now(); }
+    inline MWinTimeMeterLr(const MWinTimeMeterLr& timeMeter)
+    { *this = timeMeter; }
 
-    /// @brief Начать измерение времени
-    inline double restart()
+    inline MWinTimeMeterLr & operator=(const MWinTimeMeterLr& timeMeter)
     {
-        double dTime = secsf();
-        start();
-        return dTime;
+        this->m_uSaveTime = timeMeter.m_uSaveTime;
+        return *this;
     }
 
-    /// @brief Остановить измерение времени
-    inline void stop()
-    {   m_isStart = false; }
-
-    /// @brief Измеряется ли время
-    inline bool isActive() const
-    {   return true;/*m_startTimePoint.time_since_epoch() != 0;*/ }
+    /// @brief Начать измерение
+    inline void start()
+    { m_uSaveTime = ::GetTickCount64(); }
 
-    /// @brief Прошедшее время в секундах
-   /*
-    template <typename _type>
-    inline _type secs() const
+    /// @brief Начать измерение заново
+    /// return  Время прошедшее от начала измерения (в миллисекундах)
+    inline uint64_t restart()
     {
-        if (!isActive())
-            return static_cast<double>(0);
-        std::chrono::steady_clock::time_point endTimePoint = std::chrono::steady_clock::now();
-        std::chrono::duration<_type, 1> elapsedTime = endTimePoint - m_startTimePoint;
-        return elapsedTime.count();
-    }*/
+        uint64_t uTime = msecs();
+        start();
+        return uTime;
+    }
 
-    //typedef inline double secsf() const = secs<double>();
+    /// @brief Время прошедшее от начала измерения (в секундах)
+    inline double secs()
+    { return msecs() / 1e+3; }
 
+    /// @brief Время прошедшее от начала измерения (в миллисекундах)
+    inline uint64_t msecs()
+    { return ::GetTickCount64() - m_uSaveTime; }
 
-    inline double secsf() const
-    {
-        if (!isActive())
-            return static_cast<double>(0);
-        std::chrono::steady_clock::time_point endTimePoint = std::chrono::steady_clock::now();
-        std::chrono::duration<double> elapsedTime = endTimePoint - m_startTimePoint;
-        return elapsedTime.count();
-    }
+protected:
+    uint64_t m_uSaveTime;
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Часы высокого разрешения на API ОС Windows (Windows High-Resolution Timer)
+/// в наносекундах
+///
+/// При частоте, на которую делится 1e+9 (обычно 10 МГц), тики переводятся одним умножением.
+struct MWinClock
+{
+    typedef std::chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef std::chrono::time_point<MWinClock> time_point;
+    static const bool is_steady = true;
 
-    inline int64_t secsi() const
+    static inline time_point now()
     {
-        if (!isActive())
-            return static_cast<int64_t>(0);
-        std::chrono::steady_clock::time_point endTimePoint = std::chrono::steady_clock::now();
-        //std::chrono::duration<int64_t> elapsedTime = std::chrono::duration_cast<std::chrono::duration<int64_t>>(endTimePoint - m_startTimePoint);
-        std::chrono::seconds elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(endTimePoint - m_startTimePoint);
-        return elapsedTime.count();
+        static const rep frequency = queryFrequency();
+        static const rep step = (1000000000 % frequency == 0) ? 1000000000 / frequency : 0;
+        LARGE_INTEGER counter;
+        ::QueryPerformanceCounter(&counter);
+        const rep ticks = counter.QuadPart;
+        if (step != 0)
+            return time_point(duration(ticks * step));
+        return time_point(duration(ticks / frequency * 1000000000 + ticks % frequency * 1000000000 / frequency));
     }
 
-    inline double msecsf() const
+private:
+    static inline rep queryFrequency()
     {
-        if (!isActive())
-            return static_cast<double>(0);
-        std::chrono::steady_clock::time_point endTimePoint = std::chrono::steady_clock::now();
-        std::chrono::duration<double, std::milli> elapsedTime = endTimePoint - m_startTimePoint;
-        return elapsedTime.count();
+        LARGE_INTEGER frequency;
+        ::QueryPerformanceFrequency(&frequency);
+        return frequency.QuadPart;
     }
+};
 
-    inline int64_t msecsi() const
-    {
-        if (!isActive())
-            return static_cast<double>(0);
-        std::chrono::steady_clock::time_point endTimePoint = std::chrono::steady_clock::now();
-        std::chrono::duration<int64_t, std::milli> elapsedTime = std::chrono::duration_cast<std::chrono::duration<int64_t, std::milli>>(endTimePoint - m_startTimePoint);
-        return elapsedTime.count();
-    }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Cчетчик времени высокого разрешения реализованный на API ОС Windows
+/// В документации упоминается как Windows High-Resolution Timer
+typedef MBasicTimeMeter<MWinClock> MWinTimeMeter;
 
-protected:
+typedef MWinTimeMeter   MTimeMeterWin;
+#endif // defined(MLIB_OS_WIN)
 
-    std::chrono::steady_clock::time_point m_startTimePoint;
-    bool m_isStart;
-};
+/// @brief Cчетчик времени высокого разрешения на базе библиотеки C POSIX
+typedef MBasicTimeMeter<MPosixClock> MPosixTimeMeter;
+
+// Для совместимости
+#define time_secs   secsf
+#define time_msecs  msecsf
+#define time_mksecs mksecsf
+#define time_nsecf  nsecsf
+
+#define secs   secsf
+#define msecs  msecsf
+#define mksecs usecsf
+#define nsecf  nsecsf
 
+#if MLIB_SUPPORT_CPP11
+/// @brief Cчетчик времени на std::chrono::steady_clock
+typedef MBasicTimeMeter<std::chrono::steady_clock> MTimeMeter;
 #else
 typedef MPosixTimeMeter MTimeMeter;
 
-#endif // MLIB_SUPPORT_STD_CPP11
+#endif // MLIB_SUPPORT_CPP11
 
 //system_clock::now();
 //auto now = system_clock::now();
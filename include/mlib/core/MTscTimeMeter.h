@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MTscTimeMeter.h
+/// @brief Счетчик времени на счетчике тактов процессора (TSC)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// clock_gettime() и steady_clock::now() стоят 20 - 50 нс на отсчет, rdtsc - единицы
+/// наносекунд, поэтому MTscTimeMeter подходит для участков кода короче 100 нс.
+/// Частота TSC измеряется один раз при запуске по CLOCK_MONOTONIC, такты переводятся
+/// в наносекунды целочисленным умножением на множитель в формате 32.32.
+///
+/// TSC используется, только если он инвариантный (частота не зависит от режимов питания
+/// и P-состояний ядра, CPUID 0x80000007 EDX бит 8) и есть rdtscp. Иначе, и не на x86,
+/// отсчеты берутся из steady_clock - интерфейс и результаты те же, выигрыша нет.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MTSCTIMEMETER_H
+#define MTSCTIMEMETER_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include "MTimeMeter.h"
+#include <cstdint>
+#include <chrono>
+#include <ctime>
+#if defined(MLIB_ARCH_X86)
+    #if defined(MLIB_MSC)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Параметры пересчета тактов TSC в наносекунды
+struct MTscCalibration
+{
+    uint64_t frequency;     ///< Тактов в секунду
+    uint64_t mult;          ///< Наносекунд на такт * 2^32
+    bool supported;         ///< Есть rdtsc и rdtscp
+    bool invariant;         ///< TSC инвариантный
+    bool hardware;          ///< Отсчеты берутся из TSC (иначе - steady_clock, такт = 1 нс)
+};
+
+namespace tsc {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Отсчет TSC без упорядочивания: может выполниться раньше предшествующих инструкций
+MLIB_FORCE_INLINE uint64_t read()
+{
+#if defined(MLIB_ARCH_X86)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/// \brief Отсчет в начале замера (lfence; rdtsc; lfence)
+///
+/// Предшествующие инструкции завершены до чтения, измеряемые не начинаются до него.
+MLIB_FORCE_INLINE uint64_t readStart()
+{
+#if defined(MLIB_ARCH_X86)
+    _mm_lfence();
+    const uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#else
+    return 0;
+#endif
+}
+
+/// \brief Отсчет в конце замера (rdtscp; lfence)
+///
+/// rdtscp ждет завершения измеряемых инструкций, lfence не дает последующим начаться раньше.
+MLIB_FORCE_INLINE uint64_t readStop()
+{
+#if defined(MLIB_ARCH_X86)
+    unsigned int aux;
+    const uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+#else
+    return 0;
+#endif
+}
+
+/// \brief Монотонное время в наносекундах (запасной источник отсчетов)
+inline uint64_t clockNsecs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#if defined(__SIZEOF_INT128__)
+/// Для полного произведения 64x64 (объявлено через __extension__ ради -Wpedantic)
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+/// \brief ticks * mult / 2^32 без переполнения
+MLIB_FORCE_INLINE uint64_t toNsecs(uint64_t ticks, uint64_t mult)
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<uint128_t>(ticks) * mult) >> 32);
+#else
+    const uint64_t lo = (ticks & 0xFFFFFFFFu) * mult;
+    return (ticks >> 32) * mult + (lo >> 32);
+#endif
+}
+
+/// \brief Параметры TSC, при первом вызове - калибровка (потокобезопасно)
+const MTscCalibration & calibration();
+
+/// \brief Новое измерение частоты TSC
+/// \param durationMs - длительность измерения: чем дольше, тем точнее (10 мс - около 1e-6)
+MTscCalibration calibrate(unsigned durationMs = 10);
+
+inline bool isInvariant()   { return calibration().invariant; }
+inline uint64_t frequency() { return calibration().frequency; }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace tsc
+
+/// @brief Cчетчик времени на TSC: отсчет - несколько наносекунд, результаты - целые
+///
+/// Чтение не вызывает виртуальных функций: isActive() внутри класса - с квалификацией.
+class MTscTimeMeter : public MAbstractTimeMeter
+{
+public:
+
+    /// @brief Конструктор
+    inline MTscTimeMeter() : m_start(0)
+    {
+        const MTscCalibration & c = tsc::calibration();
+        m_mult = c.mult;
+        m_hardware = c.hardware;
+    }
+
+    ///
+    /// @brief Начать измерение времени
+    inline void start()
+    {   m_start = m_hardware ? tsc::readStart() : tsc::clockNsecs(); }
+
+    ///
+    /// @brief Начать измерение времени
+    /// @return Время прошедшее от начала измерения (в секундах)
+    inline double restart()
+    {
+        const uint64_t ns = nsecsi64();
+        start();
+        return ns / 1e+9;
+    }
+
+    ///
+    /// @brief Начать измерение времени
+    /// @return Время прошедшее от начала измерения (в наносекундах)
+    inline uint64_t restartNsecs()
+    {
+        const uint64_t now = stamp();
+        const uint64_t ns = MTscTimeMeter::isActive() ? tsc::toNsecs(now - m_start, m_mult) : 0;
+        m_start = now;
+        return ns;
+    }
+
+    ///
+    /// @brief Остановить измерение времени
+    inline void stop()
+    {   m_start = 0; }
+
+    ///
+    /// @brief Измеряется ли время
+    inline bool isActive() const
+    {   return m_start != 0; }
+
+    ///
+    /// @brief Прошедшее время в тактах TSC (в наносекундах, если TSC не используется)
+    inline uint64_t ticks() const
+    {   return MTscTimeMeter::isActive() ? stamp() - m_start : 0; }
+
+    ///
+    /// @brief Прошедшее время в наносекундах
+    inline uint64_t nsecsi64() const
+    {   return tsc::toNsecs(ticks(), m_mult); }
+
+    inline std::time_t nsecsi() const
+    {   return static_cast<std::time_t>(nsecsi64()); }
+
+    inline double nsecsf() const
+    {   return static_cast<double>(nsecsi64()); }
+
+    ///
+    /// @brief Прошедшее время в микросекундах
+    inline std::time_t usecsi() const
+    {   return static_cast<std::time_t>(nsecsi64() / 1000u); }
+
+    inline double usecsf() const
+    {   return nsecsi64() / 1e+3; }
+
+    ///
+    /// @brief Прошедшее время в миллисекундах
+    inline std::time_t msecsi() const
+    {   return static_cast<std::time_t>(nsecsi64() / 1000000u); }
+
+    inline double msecsf() const
+    {   return nsecsi64() / 1e+6; }
+
+    ///
+    /// @brief Прошедшее время в секундах
+    inline std::time_t secsi() const
+    {   return static_cast<std::time_t>(nsecsi64() / 1000000000u); }
+
+    inline double secsf() const
+    {   return nsecsi64() / 1e+9; }
+
+protected:
+    /// Отсчет в конце замера
+    inline uint64_t stamp() const
+    {   return m_hardware ? tsc::readStop() : tsc::clockNsecs(); }
+
+    uint64_t m_start;           ///< Отсчет начала измерения, 0 - не измеряется
+    uint64_t m_mult;            ///< Копия MTscCalibration::mult
+    bool m_hardware;
+};
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MTSCTIMEMETER_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
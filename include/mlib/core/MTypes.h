@@ -45,7 +45,7 @@ typedef unsigned long long int  ullint_t;
 #define MLIB_USING_TYPES_EXT
 
 typedef char                            mint8;
-#if MLIB_SUPPORT_STD_CPP11
+#if MLIB_SUPPORT_CPP11
 typedef char16_t                        mchar16;
 typedef char32_t                        mchar32;
 #endif
@@ -60,7 +60,7 @@ typedef unsigned long long int          muint64;
 
 #if defined(MLIB_USING_TYPES_EXT)
 typedef char                            int8;
-#if MLIB_SUPPORT_STD_CPP11
+#if MLIB_SUPPORT_CPP11
 typedef char16_t                        char16;
 typedef char32_t                        char32;
 #endif
@@ -103,6 +103,134 @@ typedef union
     uint64_t    u;
 } binary64;
 
+// IEEE754 Half precision 16-bit
+typedef union
+{
+    struct
+    {
+        uint16_t f : 10;    // fraction (also mantissa, see wiki)
+        uint16_t e : 5;     // exponent
+        uint16_t s : 1;     // sign
+    }b;                     // binary16 bit field
+    uint16_t    u;
+} binary16;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Число половинной точности IEEE754 binary16 (только хранение)
+///
+/// Вычисления выполняются во float. Преобразование из float - с округлением к ближайшему четному,
+/// переполнение дает бесконечность, малые значения - денормализованные числа, NaN сохраняется.
+/// Массовое преобразование - MFloat16.h.
+class float16_t
+{
+public:
+    float16_t() {}
+    explicit float16_t(float value) : m_bits(fromFloat(value)) {}
+
+    operator float() const { return toFloat(m_bits); }
+
+    uint16_t bits() const { return m_bits; }
+    static float16_t fromBits(uint16_t bits) { float16_t h; h.m_bits = bits; return h; }
+
+    /// \brief Преобразование float -> binary16
+    static inline uint16_t fromFloat(float value)
+    {
+        binary32 f;
+        f.f = value;
+        const uint32_t sign = f.u & 0x80000000u;
+        f.u ^= sign;
+
+        uint16_t h;
+        if (f.u >= 0x47800000u)
+        {
+            // Переполнение, бесконечность или NaN (тихий, старшие биты мантиссы сохраняются)
+            h = f.u > 0x7F800000u ? static_cast<uint16_t>(0x7E00 | ((f.u >> 13) & 0x3FF)) : 0x7C00;
+        }
+        else if (f.u < 0x38800000u)
+        {
+            // Денормализованные числа: округление выполняет сложение с константой 0.5
+            binary32 magic;
+            magic.u = ((127 - 15) + (23 - 10) + 1) << 23;
+            f.f += magic.f;
+            h = static_cast<uint16_t>(f.u - magic.u);
+        }
+        else
+        {
+            const uint32_t odd = (f.u >> 13) & 1;
+            f.u += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + odd;
+            h = static_cast<uint16_t>(f.u >> 13);
+        }
+        return static_cast<uint16_t>(h | (sign >> 16));
+    }
+
+    /// \brief Преобразование binary16 -> float (точное)
+    static inline float toFloat(uint16_t bits)
+    {
+        const uint32_t expMask = 0x7C00u << 13;
+        binary32 f;
+        f.u = static_cast<uint32_t>(bits & 0x7FFF) << 13;
+        const uint32_t exp = f.u & expMask;
+        f.u += static_cast<uint32_t>(127 - 15) << 23;
+        if (exp == expMask)
+        {
+            f.u += static_cast<uint32_t>(128 - 16) << 23;     // Inf/NaN
+            if (f.u & 0x7FFFFFu)
+                f.u |= 0x400000u;                           // NaN становится тихим
+        }
+        else if (exp == 0)
+        {
+            binary32 magic;
+            magic.u = 113u << 23;
+            f.u += 1u << 23;                                // Денормализованные числа
+            f.f -= magic.f;
+        }
+        f.u |= static_cast<uint32_t>(bits & 0x8000) << 16;
+        return f.f;
+    }
+
+private:
+    uint16_t m_bits;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Число формата bfloat16 (старшие 16 бит binary32, только хранение)
+///
+/// Диапазон float при 8 битах мантиссы. Преобразование из float - с округлением к ближайшему
+/// четному, NaN остается (тихим) NaN.
+class bfloat16_t
+{
+public:
+    bfloat16_t() {}
+    explicit bfloat16_t(float value) : m_bits(fromFloat(value)) {}
+
+    operator float() const { return toFloat(m_bits); }
+
+    uint16_t bits() const { return m_bits; }
+    static bfloat16_t fromBits(uint16_t bits) { bfloat16_t h; h.m_bits = bits; return h; }
+
+    /// \brief Преобразование float -> bfloat16
+    static inline uint16_t fromFloat(float value)
+    {
+        binary32 f;
+        f.f = value;
+        if ((f.u & 0x7FFFFFFFu) > 0x7F800000u)
+            return static_cast<uint16_t>((f.u >> 16) | 0x40);
+        f.u += 0x7FFFu + ((f.u >> 16) & 1);
+        return static_cast<uint16_t>(f.u >> 16);
+    }
+
+    /// \brief Преобразование bfloat16 -> float (точное)
+    static inline float toFloat(uint16_t bits)
+    {
+        binary32 f;
+        f.u = static_cast<uint32_t>(bits) << 16;
+        return f.f;
+    }
+
+private:
+    uint16_t m_bits;
+};
+
 MLIB_END_NAMESPACE
 #endif // MTYPES_H
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MVector.h
+/// @brief Векторы фиксированной размерности 2, 3, 4
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Простые типы-значения с открытыми компонентами x, y, z, w без виртуальных функций и
+/// динамической памяти. Конструкторы и все операции, не требующие sqrt, - constexpr.
+///
+/// MVec4 выровнен на свой размер (16 байт для float, 32 для double): вектор целиком
+/// загружается одной командой SSE/AVX, и покомпонентные операции компилятор сводит к одной
+/// векторной. MVec2 и MVec3 не выравниваются, чтобы массивы точек оставались плотными
+/// (совместимыми с double[3]). Для обработки больших массивов точек - пакетные функции
+/// MMatrix.h над раздельными массивами (SoA).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MVECTOR_H
+#define MVECTOR_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGlobal.h"
+#include <cmath>
+#include <cstddef>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Двумерный вектор
+template <typename _Ty>
+struct MVec2
+{
+    typedef _Ty value_type;
+
+    _Ty x, y;
+
+    MLIB_CONSTEXPR MVec2() : x(0), y(0) {}
+    MLIB_CONSTEXPR MVec2(_Ty x_, _Ty y_) : x(x_), y(y_) {}
+
+    /// \brief Преобразование типа компонент
+    template <typename _Other>
+    MLIB_CONSTEXPR explicit MVec2(const MVec2<_Other> & v)
+        : x(static_cast<_Ty>(v.x)), y(static_cast<_Ty>(v.y)) {}
+
+    static MLIB_CONSTEXPR MVec2 zero()   { return MVec2(); }
+    static MLIB_CONSTEXPR MVec2 unitX()  { return MVec2(1, 0); }
+    static MLIB_CONSTEXPR MVec2 unitY()  { return MVec2(0, 1); }
+
+    MLIB_CONSTEXPR _Ty operator[](size_t i) const { return i == 0 ? x : y; }
+    inline _Ty & operator[](size_t i)             { return i == 0 ? x : y; }
+
+    MLIB_CONSTEXPR MVec2 operator-() const                { return MVec2(-x, -y); }
+    MLIB_CONSTEXPR MVec2 operator+(const MVec2 & v) const { return MVec2(x + v.x, y + v.y); }
+    MLIB_CONSTEXPR MVec2 operator-(const MVec2 & v) const { return MVec2(x - v.x, y - v.y); }
+    MLIB_CONSTEXPR MVec2 operator*(_Ty s) const           { return MVec2(x * s, y * s); }
+    MLIB_CONSTEXPR MVec2 operator/(_Ty s) const           { return MVec2(x / s, y / s); }
+
+    inline MVec2 & operator+=(const MVec2 & v) { x += v.x; y += v.y; return *this; }
+    inline MVec2 & operator-=(const MVec2 & v) { x -= v.x; y -= v.y; return *this; }
+    inline MVec2 & operator*=(_Ty s)           { x *= s; y *= s; return *this; }
+    inline MVec2 & operator/=(_Ty s)           { x /= s; y /= s; return *this; }
+
+    MLIB_CONSTEXPR bool operator==(const MVec2 & v) const { return x == v.x && y == v.y; }
+    MLIB_CONSTEXPR bool operator!=(const MVec2 & v) const { return !(*this == v); }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Трехмерный вектор
+template <typename _Ty>
+struct MVec3
+{
+    typedef _Ty value_type;
+
+    _Ty x, y, z;
+
+    MLIB_CONSTEXPR MVec3() : x(0), y(0), z(0) {}
+    MLIB_CONSTEXPR MVec3(_Ty x_, _Ty y_, _Ty z_) : x(x_), y(y_), z(z_) {}
+    MLIB_CONSTEXPR MVec3(const MVec2<_Ty> & v, _Ty z_) : x(v.x), y(v.y), z(z_) {}
+
+    template <typename _Other>
+    MLIB_CONSTEXPR explicit MVec3(const MVec3<_Other> & v)
+        : x(static_cast<_Ty>(v.x)), y(static_cast<_Ty>(v.y)), z(static_cast<_Ty>(v.z)) {}
+
+    /// \brief Вектор из массива (x, y, z)
+    static MLIB_CONSTEXPR MVec3 fromArray(const _Ty * p) { return MVec3(p[0], p[1], p[2]); }
+
+    static MLIB_CONSTEXPR MVec3 zero()   { return MVec3(); }
+    static MLIB_CONSTEXPR MVec3 unitX()  { return MVec3(1, 0, 0); }
+    static MLIB_CONSTEXPR MVec3 unitY()  { return MVec3(0, 1, 0); }
+    static MLIB_CONSTEXPR MVec3 unitZ()  { return MVec3(0, 0, 1); }
+
+    MLIB_CONSTEXPR MVec2<_Ty> xy() const { return MVec2<_Ty>(x, y); }
+
+    MLIB_CONSTEXPR _Ty operator[](size_t i) const { return i == 0 ? x : (i == 1 ? y : z); }
+    inline _Ty & operator[](size_t i)             { return i == 0 ? x : (i == 1 ? y : z); }
+
+    MLIB_CONSTEXPR MVec3 operator-() const                { return MVec3(-x, -y, -z); }
+    MLIB_CONSTEXPR MVec3 operator+(const MVec3 & v) const { return MVec3(x + v.x, y + v.y, z + v.z); }
+    MLIB_CONSTEXPR MVec3 operator-(const MVec3 & v) const { return MVec3(x - v.x, y - v.y, z - v.z); }
+    MLIB_CONSTEXPR MVec3 operator*(_Ty s) const           { return MVec3(x * s, y * s, z * s); }
+    MLIB_CONSTEXPR MVec3 operator/(_Ty s) const           { return MVec3(x / s, y / s, z / s); }
+
+    inline MVec3 & operator+=(const MVec3 & v) { x += v.x; y += v.y; z += v.z; return *this; }
+    inline MVec3 & operator-=(const MVec3 & v) { x -= v.x; y -= v.y; z -= v.z; return *this; }
+    inline MVec3 & operator*=(_Ty s)           { x *= s; y *= s; z *= s; return *this; }
+    inline MVec3 & operator/=(_Ty s)           { x /= s; y /= s; z /= s; return *this; }
+
+    MLIB_CONSTEXPR bool operator==(const MVec3 & v) const { return x == v.x && y == v.y && z == v.z; }
+    MLIB_CONSTEXPR bool operator!=(const MVec3 & v) const { return !(*this == v); }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Четырехмерный (однородный) вектор
+template <typename _Ty>
+struct alignas(4 * sizeof(_Ty)) MVec4
+{
+    typedef _Ty value_type;
+
+    _Ty x, y, z, w;
+
+    MLIB_CONSTEXPR MVec4() : x(0), y(0), z(0), w(0) {}
+    MLIB_CONSTEXPR MVec4(_Ty x_, _Ty y_, _Ty z_, _Ty w_) : x(x_), y(y_), z(z_), w(w_) {}
+    MLIB_CONSTEXPR MVec4(const MVec3<_Ty> & v, _Ty w_) : x(v.x), y(v.y), z(v.z), w(w_) {}
+
+    template <typename _Other>
+    MLIB_CONSTEXPR explicit MVec4(const MVec4<_Other> & v)
+        : x(static_cast<_Ty>(v.x)), y(static_cast<_Ty>(v.y)),
+          z(static_cast<_Ty>(v.z)), w(static_cast<_Ty>(v.w)) {}
+
+    /// \brief Точка (w = 1)
+    static MLIB_CONSTEXPR MVec4 point(const MVec3<_Ty> & v)     { return MVec4(v, 1); }
+    /// \brief Направление (w = 0)
+    static MLIB_CONSTEXPR MVec4 direction(const MVec3<_Ty> & v) { return MVec4(v, 0); }
+
+    static MLIB_CONSTEXPR MVec4 zero()   { return MVec4(); }
+
+    MLIB_CONSTEXPR MVec3<_Ty> xyz() const { return MVec3<_Ty>(x, y, z); }
+
+    MLIB_CONSTEXPR _Ty operator[](size_t i) const
+    {   return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+    inline _Ty & operator[](size_t i)
+    {   return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+
+    MLIB_CONSTEXPR MVec4 operator-() const
+    {   return MVec4(-x, -y, -z, -w); }
+    MLIB_CONSTEXPR MVec4 operator+(const MVec4 & v) const
+    {   return MVec4(x + v.x, y + v.y, z + v.z, w + v.w); }
+    MLIB_CONSTEXPR MVec4 operator-(const MVec4 & v) const
+    {   return MVec4(x - v.x, y - v.y, z - v.z, w - v.w); }
+    MLIB_CONSTEXPR MVec4 operator*(_Ty s) const
+    {   return MVec4(x * s, y * s, z * s, w * s); }
+    MLIB_CONSTEXPR MVec4 operator/(_Ty s) const
+    {   return MVec4(x / s, y / s, z / s, w / s); }
+
+    inline MVec4 & operator+=(const MVec4 & v) { x += v.x; y += v.y; z += v.z; w += v.w; return *this; }
+    inline MVec4 & operator-=(const MVec4 & v) { x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; }
+    inline MVec4 & operator*=(_Ty s)           { x *= s; y *= s; z *= s; w *= s; return *this; }
+    inline MVec4 & operator/=(_Ty s)           { x /= s; y /= s; z /= s; w /= s; return *this; }
+
+    MLIB_CONSTEXPR bool operator==(const MVec4 & v) const
+    {   return x == v.x && y == v.y && z == v.z && w == v.w; }
+    MLIB_CONSTEXPR bool operator!=(const MVec4 & v) const
+    {   return !(*this == v); }
+};
+
+typedef MVec2<float>  MVec2f;
+typedef MVec2<double> MVec2d;
+typedef MVec3<float>  MVec3f;
+typedef MVec3<double> MVec3d;
+typedef MVec4<float>  MVec4f;
+typedef MVec4<double> MVec4d;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Свободные функции
+
+template <typename _Ty>
+inline MLIB_CONSTEXPR MVec2<_Ty> operator*(_Ty s, const MVec2<_Ty> & v) { return v * s; }
+template <typename _Ty>
+inline MLIB_CONSTEXPR MVec3<_Ty> operator*(_Ty s, const MVec3<_Ty> & v) { return v * s; }
+template <typename _Ty>
+inline MLIB_CONSTEXPR MVec4<_Ty> operator*(_Ty s, const MVec4<_Ty> & v) { return v * s; }
+
+/// \brief Скалярное произведение
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty dot(const MVec2<_Ty> & a, const MVec2<_Ty> & b)
+{   return a.x * b.x + a.y * b.y; }
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty dot(const MVec3<_Ty> & a, const MVec3<_Ty> & b)
+{   return a.x * b.x + a.y * b.y + a.z * b.z; }
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty dot(const MVec4<_Ty> & a, const MVec4<_Ty> & b)
+{   return (a.x * b.x + a.y * b.y) + (a.z * b.z + a.w * b.w); }
+
+/// \brief Векторное произведение (для двумерных - z-компонента)
+template <typename _Ty>
+inline MLIB_CONSTEXPR _Ty cross(const MVec2<_Ty> & a, const MVec2<_Ty> & b)
+{   return a.x * b.y - a.y * b.x; }
+template <typename _Ty>
+inline MLIB_CONSTEXPR MVec3<_Ty> cross(const MVec3<_Ty> & a, const MVec3<_Ty> & b)
+{   return MVec3<_Ty>(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x); }
+
+/// \brief Покомпонентное произведение
+template <typename _Ty>
+inline MLIB_CONSTEXPR MVec2<_Ty> hadamard(const MVec2<_Ty> & a, const MVec2<_Ty> & b)
+{   return MVec2<_Ty>(a.x * b.x, a.y * b.y); }
+template <typename _Ty>
+inline MLIB_CONSTEXPR MVec3<_Ty> hadamard(const MVec3<_Ty> & a, const MVec3<_Ty> & b)
+{   return MVec3<_Ty>(a.x * b.x, a.y * b.y, a.z * b.z); }
+template <typename _Ty>
+inline MLIB_CONSTEXPR MVec4<_Ty> hadamard(const MVec4<_Ty> & a, const MVec4<_Ty> & b)
+{   return MVec4<_Ty>(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w); }
+
+namespace detail {
+/// Тип компонент для MVec2/3/4, для прочих типов - ошибка подстановки
+template <class _Vec> struct VecValue {};
+template <typename _Ty> struct VecValue<MVec2<_Ty> > { typedef _Ty type; };
+template <typename _Ty> struct VecValue<MVec3<_Ty> > { typedef _Ty type; };
+template <typename _Ty> struct VecValue<MVec4<_Ty> > { typedef _Ty type; };
+} // namespace detail
+
+/// \brief Квадрат длины
+template <class _Vec>
+inline MLIB_CONSTEXPR typename detail::VecValue<_Vec>::type lengthSquared(const _Vec & v)
+{   return dot(v, v); }
+
+/// \brief Длина
+template <class _Vec>
+inline typename detail::VecValue<_Vec>::type length(const _Vec & v)
+{   return std::sqrt(dot(v, v)); }
+
+/// \brief Расстояние между точками
+template <class _Vec>
+inline typename detail::VecValue<_Vec>::type distance(const _Vec & a, const _Vec & b)
+{   return length(a - b); }
+
+/// \brief Единичный вектор того же направления (нулевой вектор дает NaN)
+template <class _Vec>
+inline _Vec normalized(const _Vec & v, typename detail::VecValue<_Vec>::type * = 0)
+{   return v / length(v); }
+
+/// \brief Линейная интерполяция a + (b - a) t
+template <class _Vec>
+inline MLIB_CONSTEXPR _Vec lerp(const _Vec & a, const _Vec & b, typename detail::VecValue<_Vec>::type t)
+{   return a + (b - a) * t; }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MVECTOR_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
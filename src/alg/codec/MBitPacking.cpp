@@ -0,0 +1,586 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MBitPacking.cpp
+/// @brief Упаковка блоков целых чисел до минимальной разрядности (bit packing)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Векторные ядра написаны один раз в виде шаблона над набором операций V (SSE2, AVX2).
+/// Шаги по 32 числам дорожки разворачиваются рекурсией шаблона, поэтому все сдвиги известны
+/// на этапе компиляции. Скалярные ядра обрабатывают дорожки по очереди в том же формате.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MBitPacking.h"
+#include "MVarInt.h"
+#include "MBitOps.h"
+#if defined(MLIB_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+#if defined(MLIB_SIMD_AVX2)
+    #include <immintrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Маска младших B разрядов
+template <unsigned B>
+struct LowMask
+{   static const uint32_t value = (B >= 32) ? 0xFFFFFFFFu : ((1u << (B & 31)) - 1u); };
+
+typedef void (*PackFn)(const uint32_t *, uint32_t *);
+typedef void (*UnpackFn)(const uint32_t *, uint32_t *, uint32_t);
+
+#define MLIB_BITPACK_TABLE(E) { \
+    E(0),  E(1),  E(2),  E(3),  E(4),  E(5),  E(6),  E(7),  E(8),  E(9),  E(10), \
+    E(11), E(12), E(13), E(14), E(15), E(16), E(17), E(18), E(19), E(20), E(21), \
+    E(22), E(23), E(24), E(25), E(26), E(27), E(28), E(29), E(30), E(31), E(32) }
+
+#if defined(MLIB_SIMD_SSE2)
+/// 4 дорожки SSE2
+struct VecSse2
+{
+    enum { lanes = 4 };
+    typedef __m128i type;
+
+    static MLIB_FORCE_INLINE type load(const uint32_t * p)
+    { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static MLIB_FORCE_INLINE void store(uint32_t * p, type a)
+    { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a); }
+    static MLIB_FORCE_INLINE type set1(uint32_t x)  { return _mm_set1_epi32(static_cast<int>(x)); }
+    static MLIB_FORCE_INLINE type zero()            { return _mm_setzero_si128(); }
+    static MLIB_FORCE_INLINE type andv(type a, type b) { return _mm_and_si128(a, b); }
+    static MLIB_FORCE_INLINE type orv(type a, type b)  { return _mm_or_si128(a, b); }
+    static MLIB_FORCE_INLINE type xorv(type a, type b) { return _mm_xor_si128(a, b); }
+    static MLIB_FORCE_INLINE type add(type a, type b)  { return _mm_add_epi32(a, b); }
+    static MLIB_FORCE_INLINE type sub(type a, type b)  { return _mm_sub_epi32(a, b); }
+    static MLIB_FORCE_INLINE type sll(type a, unsigned n) { return _mm_slli_epi32(a, static_cast<int>(n)); }
+    static MLIB_FORCE_INLINE type srl(type a, unsigned n) { return _mm_srli_epi32(a, static_cast<int>(n)); }
+};
+
+/// 8 дорожек парой регистров SSE2 (если AVX2 недоступен)
+struct VecSse2x2
+{
+    enum { lanes = 8 };
+    struct type { __m128i lo, hi; };
+
+    static MLIB_FORCE_INLINE type make(__m128i lo, __m128i hi)
+    { type r; r.lo = lo; r.hi = hi; return r; }
+    static MLIB_FORCE_INLINE type load(const uint32_t * p)
+    { return make(VecSse2::load(p), VecSse2::load(p + 4)); }
+    static MLIB_FORCE_INLINE void store(uint32_t * p, const type & a)
+    { VecSse2::store(p, a.lo); VecSse2::store(p + 4, a.hi); }
+    static MLIB_FORCE_INLINE type set1(uint32_t x)
+    { return make(VecSse2::set1(x), VecSse2::set1(x)); }
+    static MLIB_FORCE_INLINE type zero()
+    { return make(_mm_setzero_si128(), _mm_setzero_si128()); }
+    static MLIB_FORCE_INLINE type andv(const type & a, const type & b)
+    { return make(_mm_and_si128(a.lo, b.lo), _mm_and_si128(a.hi, b.hi)); }
+    static MLIB_FORCE_INLINE type orv(const type & a, const type & b)
+    { return make(_mm_or_si128(a.lo, b.lo), _mm_or_si128(a.hi, b.hi)); }
+    static MLIB_FORCE_INLINE type xorv(const type & a, const type & b)
+    { return make(_mm_xor_si128(a.lo, b.lo), _mm_xor_si128(a.hi, b.hi)); }
+    static MLIB_FORCE_INLINE type add(const type & a, const type & b)
+    { return make(_mm_add_epi32(a.lo, b.lo), _mm_add_epi32(a.hi, b.hi)); }
+    static MLIB_FORCE_INLINE type sub(const type & a, const type & b)
+    { return make(_mm_sub_epi32(a.lo, b.lo), _mm_sub_epi32(a.hi, b.hi)); }
+    static MLIB_FORCE_INLINE type sll(const type & a, unsigned n)
+    { return make(VecSse2::sll(a.lo, n), VecSse2::sll(a.hi, n)); }
+    static MLIB_FORCE_INLINE type srl(const type & a, unsigned n)
+    { return make(VecSse2::srl(a.lo, n), VecSse2::srl(a.hi, n)); }
+};
+
+#if defined(MLIB_SIMD_AVX2)
+/// 8 дорожек AVX2
+struct VecAvx2
+{
+    enum { lanes = 8 };
+    typedef __m256i type;
+
+    static MLIB_FORCE_INLINE type load(const uint32_t * p)
+    { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static MLIB_FORCE_INLINE void store(uint32_t * p, type a)
+    { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), a); }
+    static MLIB_FORCE_INLINE type set1(uint32_t x)  { return _mm256_set1_epi32(static_cast<int>(x)); }
+    static MLIB_FORCE_INLINE type zero()            { return _mm256_setzero_si256(); }
+    static MLIB_FORCE_INLINE type andv(type a, type b) { return _mm256_and_si256(a, b); }
+    static MLIB_FORCE_INLINE type orv(type a, type b)  { return _mm256_or_si256(a, b); }
+    static MLIB_FORCE_INLINE type xorv(type a, type b) { return _mm256_xor_si256(a, b); }
+    static MLIB_FORCE_INLINE type add(type a, type b)  { return _mm256_add_epi32(a, b); }
+    static MLIB_FORCE_INLINE type sub(type a, type b)  { return _mm256_sub_epi32(a, b); }
+    static MLIB_FORCE_INLINE type sll(type a, unsigned n) { return _mm256_slli_epi32(a, static_cast<int>(n)); }
+    static MLIB_FORCE_INLINE type srl(type a, unsigned n) { return _mm256_srli_epi32(a, static_cast<int>(n)); }
+};
+#endif // MLIB_SIMD_AVX2
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Шаг упаковки K-го числа каждой дорожки
+template <class V, unsigned B, unsigned K>
+struct PackStep
+{
+    typedef typename V::type vec;
+
+    static MLIB_FORCE_INLINE void run(const uint32_t * in, uint32_t * out, vec & acc, const vec & mask)
+    {
+        const unsigned shift = (K * B) % 32;
+        const unsigned word  = (K * B) / 32;
+
+        vec v = V::andv(V::load(in + K * V::lanes), mask);
+        acc = shift ? V::orv(acc, V::sll(v, shift)) : v;
+        if (shift + B >= 32)
+        {
+            V::store(out + word * V::lanes, acc);
+            if (shift + B > 32)
+                acc = V::srl(v, 32 - shift);
+        }
+        PackStep<V, B, K + 1>::run(in, out, acc, mask);
+    }
+};
+
+template <class V, unsigned B>
+struct PackStep<V, B, 32>
+{
+    static MLIB_FORCE_INLINE void run(const uint32_t *, uint32_t *, typename V::type &, const typename V::type &)
+    { ; }
+};
+
+/// Шаг распаковки K-го числа каждой дорожки
+template <class V, unsigned B, unsigned K, class Op>
+struct UnpackStep
+{
+    typedef typename V::type vec;
+
+    static MLIB_FORCE_INLINE void run(const uint32_t * in, uint32_t * out, vec & cur, const vec & mask, Op & op)
+    {
+        const unsigned shift = (K * B) % 32;
+        const unsigned word  = (K * B) / 32;
+
+        if (shift == 0)
+            cur = V::load(in + word * V::lanes);
+        vec v = V::srl(cur, shift);
+        if (shift + B > 32)
+        {
+            cur = V::load(in + (word + 1) * V::lanes);
+            v = V::orv(v, V::sll(cur, 32 - shift));
+        }
+        if (B < 32)
+            v = V::andv(v, mask);
+        V::store(out + K * V::lanes, op(v));
+        UnpackStep<V, B, K + 1, Op>::run(in, out, cur, mask, op);
+    }
+};
+
+template <class V, unsigned B, class Op>
+struct UnpackStep<V, B, 32, Op>
+{
+    static MLIB_FORCE_INLINE void run(const uint32_t *, uint32_t *, typename V::type &, const typename V::type &, Op &)
+    { ; }
+};
+
+/// Распаковка без преобразования
+template <class V>
+struct OpPlain
+{
+    explicit OpPlain(uint32_t) { ; }
+    MLIB_FORCE_INLINE typename V::type operator()(const typename V::type & v) const { return v; }
+};
+
+/// Распаковка с прибавлением опорного значения
+template <class V>
+struct OpFor
+{
+    typename V::type ref;
+    explicit OpFor(uint32_t r) : ref(V::set1(r)) { ; }
+    MLIB_FORCE_INLINE typename V::type operator()(const typename V::type & v) const { return V::add(v, ref); }
+};
+
+/// Распаковка zig-zag разностей с накоплением по дорожкам
+template <class V>
+struct OpDelta
+{
+    typename V::type prev;
+    explicit OpDelta(uint32_t r) : prev(V::set1(r)) { ; }
+    MLIB_FORCE_INLINE typename V::type operator()(const typename V::type & v)
+    {
+        // (v >> 1) ^ -(v & 1)
+        typename V::type d = V::xorv(V::srl(v, 1), V::sub(V::zero(), V::andv(v, V::set1(1))));
+        prev = V::add(prev, d);
+        return prev;
+    }
+};
+
+template <class V, unsigned B>
+void packKernel(const uint32_t * in, uint32_t * out)
+{
+    if (B == 0)
+        return;
+    const typename V::type mask = V::set1(LowMask<B>::value);
+    typename V::type acc = V::zero();
+    PackStep<V, B, 0>::run(in, out, acc, mask);
+}
+
+template <class V, unsigned B, template <class> class Op>
+void unpackKernel(const uint32_t * in, uint32_t * out, uint32_t ref)
+{
+    Op<V> op(ref);
+    if (B == 0)
+    {
+        for (unsigned k = 0; k < 32; ++k)
+            V::store(out + k * V::lanes, op(V::zero()));
+        return;
+    }
+    const typename V::type mask = V::set1(LowMask<B>::value);
+    typename V::type cur = V::zero();
+    UnpackStep<V, B, 0, Op<V> >::run(in, out, cur, mask, op);
+}
+
+template <class V>
+struct Kernels
+{
+    static PackFn pack(uint32_t bits)
+    {
+        #define MLIB_PACK_ENTRY(b) &packKernel<V, b>
+        static const PackFn table[33] = MLIB_BITPACK_TABLE(MLIB_PACK_ENTRY);
+        #undef MLIB_PACK_ENTRY
+        return table[bits];
+    }
+
+    static UnpackFn unpack(uint32_t bits, BitPackMode mode)
+    {
+        #define MLIB_UNPACK_ENTRY(b) &unpackKernel<V, b, OpPlain>
+        static const UnpackFn tablePlain[33] = MLIB_BITPACK_TABLE(MLIB_UNPACK_ENTRY);
+        #undef MLIB_UNPACK_ENTRY
+        #define MLIB_UNPACK_ENTRY(b) &unpackKernel<V, b, OpFor>
+        static const UnpackFn tableFor[33] = MLIB_BITPACK_TABLE(MLIB_UNPACK_ENTRY);
+        #undef MLIB_UNPACK_ENTRY
+        #define MLIB_UNPACK_ENTRY(b) &unpackKernel<V, b, OpDelta>
+        static const UnpackFn tableDelta[33] = MLIB_BITPACK_TABLE(MLIB_UNPACK_ENTRY);
+        #undef MLIB_UNPACK_ENTRY
+
+        switch (mode)
+        {
+            case BitPackFor:    return tableFor[bits];
+            case BitPackDelta:  return tableDelta[bits];
+            default:            return tablePlain[bits];
+        }
+    }
+};
+
+#endif // MLIB_SIMD_SSE2
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Скалярная упаковка блока из L дорожек
+template <unsigned L, unsigned B>
+void packScalar(const uint32_t * in, uint32_t * out)
+{
+    for (unsigned lane = 0; lane < L; ++lane)
+    {
+        uint32_t acc = 0;
+        unsigned shift = 0;
+        unsigned word = 0;
+        for (unsigned k = 0; k < 32; ++k)
+        {
+            const uint32_t v = in[k * L + lane] & LowMask<B>::value;
+            acc = shift ? (acc | (v << shift)) : v;
+            shift += B;
+            if (shift >= 32)
+            {
+                out[word++ * L + lane] = acc;
+                shift -= 32;
+                if (shift)
+                    acc = v >> (B - shift);
+            }
+        }
+    }
+}
+
+/// Скалярная распаковка блока из L дорожек
+template <unsigned L, unsigned B, int Mode>
+void unpackScalar(const uint32_t * in, uint32_t * out, uint32_t ref)
+{
+    for (unsigned lane = 0; lane < L; ++lane)
+    {
+        uint32_t prev = ref;
+        unsigned shift = 0;
+        unsigned word = 0;
+        for (unsigned k = 0; k < 32; ++k)
+        {
+            uint32_t v = 0;
+            if (B != 0)
+            {
+                v = in[word * L + lane] >> shift;
+                if (shift + B > 32)
+                    v |= in[(word + 1) * L + lane] << (32 - shift);
+                v &= LowMask<B>::value;
+                shift += B;
+                word += shift / 32;
+                shift %= 32;
+            }
+            if (Mode == BitPackFor)
+                v += ref;
+            else if (Mode == BitPackDelta)
+                v = prev += (v >> 1) ^ (0u - (v & 1u));
+            out[k * L + lane] = v;
+        }
+    }
+}
+
+template <unsigned L>
+struct ScalarKernels
+{
+    static PackFn pack(uint32_t bits)
+    {
+        #define MLIB_PACK_ENTRY(b) &packScalar<L, b>
+        static const PackFn table[33] = MLIB_BITPACK_TABLE(MLIB_PACK_ENTRY);
+        #undef MLIB_PACK_ENTRY
+        return table[bits];
+    }
+
+    static UnpackFn unpack(uint32_t bits, BitPackMode mode)
+    {
+        #define MLIB_UNPACK_ENTRY(b) &unpackScalar<L, b, BitPackPlain>
+        static const UnpackFn tablePlain[33] = MLIB_BITPACK_TABLE(MLIB_UNPACK_ENTRY);
+        #undef MLIB_UNPACK_ENTRY
+        #define MLIB_UNPACK_ENTRY(b) &unpackScalar<L, b, BitPackFor>
+        static const UnpackFn tableFor[33] = MLIB_BITPACK_TABLE(MLIB_UNPACK_ENTRY);
+        #undef MLIB_UNPACK_ENTRY
+        #define MLIB_UNPACK_ENTRY(b) &unpackScalar<L, b, BitPackDelta>
+        static const UnpackFn tableDelta[33] = MLIB_BITPACK_TABLE(MLIB_UNPACK_ENTRY);
+        #undef MLIB_UNPACK_ENTRY
+
+        switch (mode)
+        {
+            case BitPackFor:    return tableFor[bits];
+            case BitPackDelta:  return tableDelta[bits];
+            default:            return tablePlain[bits];
+        }
+    }
+};
+
+#undef MLIB_BITPACK_TABLE
+
+#if defined(MLIB_SIMD_SSE2)
+typedef Kernels<VecSse2>    Kernels128;
+#else
+typedef ScalarKernels<4>    Kernels128;
+#endif
+
+#if defined(MLIB_SIMD_AVX2)
+typedef Kernels<VecAvx2>    Kernels256;
+#elif defined(MLIB_SIMD_SSE2)
+typedef Kernels<VecSse2x2>  Kernels256;
+#else
+typedef ScalarKernels<8>    Kernels256;
+#endif
+
+inline PackFn packFunction(uint32_t bits, BitPackBlock block)
+{
+    return (block == BitPackBlock256) ? Kernels256::pack(bits) : Kernels128::pack(bits);
+}
+
+inline UnpackFn unpackFunction(uint32_t bits, BitPackMode mode, BitPackBlock block)
+{
+    return (block == BitPackBlock256) ? Kernels256::unpack(bits, mode) : Kernels128::unpack(bits, mode);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Отображение типов на беззнаковые 32-битные числа с сохранением порядка
+inline uint32_t toPacked(uint32_t v) { return v; }
+inline uint32_t toPacked(int32_t v)  { return static_cast<uint32_t>(v) ^ 0x80000000u; }
+inline uint32_t toPacked(uint16_t v) { return v; }
+inline uint32_t toPacked(int16_t v)  { return static_cast<uint16_t>(v) ^ 0x8000u; }
+
+inline void fromPacked(uint32_t v, uint32_t & out) { out = v; }
+inline void fromPacked(uint32_t v, int32_t & out)  { out = static_cast<int32_t>(v ^ 0x80000000u); }
+inline void fromPacked(uint32_t v, uint16_t & out) { out = static_cast<uint16_t>(v); }
+inline void fromPacked(uint32_t v, int16_t & out)  { out = static_cast<int16_t>(static_cast<uint16_t>(v ^ 0x8000u)); }
+
+/// Заголовок блока: разрядность | режим << 8 | количество дорожек << 16
+inline uint32_t blockHeader(uint32_t bits, BitPackMode mode, uint32_t lanes)
+{   return bits | (static_cast<uint32_t>(mode) << 8) | (lanes << 16); }
+
+template <unsigned Size, typename T>
+size_t encode(const T * in, size_t count, uint32_t * out, BitPackMode mode)
+{
+    const unsigned lanes = Size / 32;
+    uint32_t buf[Size];
+    uint32_t res[Size];
+    uint32_t * const begin = out;
+
+    for (size_t pos = 0; pos < count; pos += Size)
+    {
+        const size_t n = (count - pos < Size) ? (count - pos) : Size;
+        if (n == Size)
+        {
+            for (unsigned i = 0; i < Size; ++i)
+                buf[i] = toPacked(in[pos + i]);
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+                buf[i] = toPacked(in[pos + i]);
+            for (size_t i = n; i < Size; ++i)
+                buf[i] = buf[n - 1];
+        }
+
+        uint32_t * const header = out++;
+        const uint32_t * data = buf;
+        uint32_t acc = 0;
+        if (mode == BitPackFor)
+        {
+            uint32_t ref = buf[0];
+            for (unsigned i = 0; i < Size; ++i)
+                ref = (buf[i] < ref) ? buf[i] : ref;
+            for (unsigned i = 0; i < Size; ++i)
+            {
+                res[i] = buf[i] - ref;
+                acc |= res[i];
+            }
+            *out++ = ref;
+            data = res;
+        }
+        else if (mode == BitPackDelta)
+        {
+            const uint32_t ref = buf[0];
+            for (unsigned i = 0; i < lanes; ++i)
+            {
+                res[i] = zigzagEncode(static_cast<int32_t>(buf[i] - ref));
+                acc |= res[i];
+            }
+            for (unsigned i = lanes; i < Size; ++i)
+            {
+                res[i] = zigzagEncode(static_cast<int32_t>(buf[i] - buf[i - lanes]));
+                acc |= res[i];
+            }
+            *out++ = ref;
+            data = res;
+        }
+        else
+        {
+            for (unsigned i = 0; i < Size; ++i)
+                acc |= buf[i];
+        }
+
+        const uint32_t bits = static_cast<uint32_t>(bits::bitWidth(acc));
+        *header = blockHeader(bits, mode, lanes);
+        packFunction(bits, static_cast<BitPackBlock>(Size))(data, out);
+        out += lanes * bits;
+    }
+    return static_cast<size_t>(out - begin);
+}
+
+template <unsigned Size, typename T>
+size_t decode(const uint32_t * in, size_t count, T * out, BitPackMode mode)
+{
+    const unsigned lanes = Size / 32;
+    uint32_t buf[Size];
+    const uint32_t * const begin = in;
+
+    for (size_t pos = 0; pos < count; pos += Size)
+    {
+        const uint32_t header = *in++;
+        const uint32_t bits = header & 0xFF;
+        if (bits > 32 || header != blockHeader(bits, mode, lanes))
+            return 0;
+
+        const uint32_t ref = (mode == BitPackPlain) ? 0 : *in++;
+        unpackFunction(bits, mode, static_cast<BitPackBlock>(Size))(in, buf, ref);
+        in += lanes * bits;
+
+        const size_t n = (count - pos < Size) ? (count - pos) : Size;
+        if (n == Size)
+        {
+            for (unsigned i = 0; i < Size; ++i)
+                fromPacked(buf[i], out[pos + i]);
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+                fromPacked(buf[i], out[pos + i]);
+        }
+    }
+    return static_cast<size_t>(in - begin);
+}
+
+template <typename T>
+inline size_t encode(const T * in, size_t count, uint32_t * out, BitPackMode mode, BitPackBlock block)
+{
+    return (block == BitPackBlock256) ? encode<BitPackBlock256>(in, count, out, mode)
+                                      : encode<BitPackBlock128>(in, count, out, mode);
+}
+
+template <typename T>
+inline size_t decode(const uint32_t * in, size_t count, T * out, BitPackMode mode, BitPackBlock block)
+{
+    return (block == BitPackBlock256) ? decode<BitPackBlock256>(in, count, out, mode)
+                                      : decode<BitPackBlock128>(in, count, out, mode);
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t bitpackWidth(const uint32_t * data, size_t count)
+{
+    uint32_t acc = 0;
+    for (size_t i = 0; i < count; ++i)
+        acc |= data[i];
+    return static_cast<uint32_t>(bits::bitWidth(acc));
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void bitpackBlock(const uint32_t * in, uint32_t * out, uint32_t bits, BitPackBlock block)
+{
+    if (bits <= 32)
+        packFunction(bits, block)(in, out);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void bitunpackBlock(const uint32_t * in, uint32_t * out, uint32_t bits, BitPackBlock block)
+{
+    if (bits <= 32)
+        unpackFunction(bits, BitPackPlain, block)(in, out, 0);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t bitpackEncodeBound(size_t count, BitPackBlock block)
+{
+    const size_t blocks = (count + block - 1) / block;
+    return blocks * (2 + static_cast<size_t>(block));
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t bitpackEncode(const uint32_t * in, size_t count, uint32_t * out, BitPackMode mode, BitPackBlock block)
+{   return encode(in, count, out, mode, block); }
+
+size_t bitpackEncode(const int32_t * in, size_t count, uint32_t * out, BitPackMode mode, BitPackBlock block)
+{   return encode(in, count, out, mode, block); }
+
+size_t bitpackEncode(const uint16_t * in, size_t count, uint32_t * out, BitPackMode mode, BitPackBlock block)
+{   return encode(in, count, out, mode, block); }
+
+size_t bitpackEncode(const int16_t * in, size_t count, uint32_t * out, BitPackMode mode, BitPackBlock block)
+{   return encode(in, count, out, mode, block); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t bitpackDecode(const uint32_t * in, size_t count, uint32_t * out, BitPackMode mode, BitPackBlock block)
+{   return decode(in, count, out, mode, block); }
+
+size_t bitpackDecode(const uint32_t * in, size_t count, int32_t * out, BitPackMode mode, BitPackBlock block)
+{   return decode(in, count, out, mode, block); }
+
+size_t bitpackDecode(const uint32_t * in, size_t count, uint16_t * out, BitPackMode mode, BitPackBlock block)
+{   return decode(in, count, out, mode, block); }
+
+size_t bitpackDecode(const uint32_t * in, size_t count, int16_t * out, BitPackMode mode, BitPackBlock block)
+{   return decode(in, count, out, mode, block); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
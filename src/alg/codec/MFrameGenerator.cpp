@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MFrameGenerator.cpp
+/// @brief Генератор случайных корректных кадров "синхрослово, длина, данные, CRC32"
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MFrameGenerator.h"
+#include "MRandomDistribution.h"
+#include "MFastCRC32.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Запись bytes младших байтов value
+void putField(uint8_t * out, uint32_t value, unsigned bytes, bool bigEndian)
+{
+    for (unsigned i = 0; i < bytes; ++i)
+    {
+        const unsigned shift = 8 * (bigEndian ? bytes - 1 - i : i);
+        out[i] = static_cast<uint8_t>(value >> shift);
+    }
+}
+
+uint32_t getField(const uint8_t * data, unsigned bytes, bool bigEndian)
+{
+    uint32_t value = 0;
+    for (unsigned i = 0; i < bytes; ++i)
+    {
+        const unsigned shift = 8 * (bigEndian ? bytes - 1 - i : i);
+        value |= static_cast<uint32_t>(data[i]) << shift;
+    }
+    return value;
+}
+
+uint32_t frameCrc(const uint8_t * data, size_t size)
+{
+    crc32_t crc;
+    crc32Init(crc);
+    crc32Update(data, static_cast<crc32_t>(size), crc);
+    crc32Result(crc);
+    return static_cast<uint32_t>(crc);
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MFrameGenerator::MFrameGenerator(const MFrameLayout & layout, uint64_t seed)
+    : m_layout(layout)
+    , m_engine(seed)
+    , m_pending(0)
+    , m_hasPending(false)
+{
+    if (m_layout.syncSize > 4)
+        m_layout.syncSize = 4;
+    if (m_layout.lengthSize == 0)
+        m_layout.lengthSize = 1;
+    else if (m_layout.lengthSize == 3 || m_layout.lengthSize > 4)
+        m_layout.lengthSize = 4;
+    if (m_layout.maxPayload > m_layout.maxLength())
+        m_layout.maxPayload = m_layout.maxLength();
+    if (m_layout.minPayload > m_layout.maxPayload)
+        m_layout.minPayload = m_layout.maxPayload;
+}
+
+void MFrameGenerator::seed(uint64_t seed)
+{
+    m_engine.seed(seed);
+    m_hasPending = false;
+}
+
+size_t MFrameGenerator::pendingPayload()
+{
+    if (!m_hasPending)
+    {
+        const uint64_t range = static_cast<uint64_t>(m_layout.maxPayload - m_layout.minPayload) + 1;
+        m_pending = m_layout.minPayload + static_cast<size_t>(uniformBounded(m_engine, range));
+        m_hasPending = true;
+    }
+    return m_pending;
+}
+
+void MFrameGenerator::write(uint8_t * out, size_t payload)
+{
+    const MFrameLayout & l = m_layout;
+    putField(out, l.sync, l.syncSize, true);
+    putField(out + l.syncSize, static_cast<uint32_t>(payload), l.lengthSize, l.bigEndian);
+    uint8_t * data = out + l.headerSize();
+    fillRandom(m_engine, data, payload);
+    const uint32_t crc = l.crcCoversHeader ? frameCrc(out, l.headerSize() + payload) : frameCrc(data, payload);
+    putField(data + payload, crc, 4, l.bigEndian);
+    m_hasPending = false;
+}
+
+size_t MFrameGenerator::next(std::vector<uint8_t> & out)
+{
+    const size_t payload = pendingPayload();
+    const size_t size = m_layout.frameSize(payload);
+    const size_t offset = out.size();
+    out.resize(offset + size);
+    write(&out[offset], payload);
+    return size;
+}
+
+size_t MFrameGenerator::fill(uint8_t * buffer, size_t size, size_t * used)
+{
+    size_t frames = 0, offset = 0;
+    for (;;)
+    {
+        const size_t payload = pendingPayload();
+        const size_t frame = m_layout.frameSize(payload);
+        if (frame > size - offset)
+            break;
+        write(buffer + offset, payload);
+        offset += frame;
+        ++frames;
+    }
+    if (used != 0)
+        *used = offset;
+    return frames;
+}
+
+size_t MFrameGenerator::check(const MFrameLayout & layout, const uint8_t * data, size_t size)
+{
+    if (layout.syncSize > 4 || (layout.lengthSize != 1 && layout.lengthSize != 2 && layout.lengthSize != 4))
+        return 0;
+    const size_t header = layout.headerSize();
+    const uint32_t syncMask = layout.syncSize >= 4 ? 0xFFFFFFFFu : (1u << (8 * layout.syncSize)) - 1;
+    if (size < header + 4 || getField(data, layout.syncSize, true) != (layout.sync & syncMask))
+        return 0;
+    const size_t payload = getField(data + layout.syncSize, layout.lengthSize, layout.bigEndian);
+    if (payload > size - header - 4)
+        return 0;
+    const uint8_t * body = data + header;
+    const uint32_t crc = layout.crcCoversHeader ? frameCrc(data, header + payload) : frameCrc(body, payload);
+    if (getField(body + payload, 4, layout.bigEndian) != crc)
+        return 0;
+    return header + payload + 4;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,450 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MVarInt.cpp
+/// @brief Кодирование целых чисел переменной длины (LEB128, zig-zag, Stream VByte)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MVarInt.h"
+#include "MBitOps.h"
+#include <cstring>
+#if defined(MLIB_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+#if defined(MLIB_SIMD_SSSE3)
+    #include <tmmintrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Чтение 64-битного слова в порядке little-endian
+inline uint64_t loadLe64(const uint8_t * p)
+{
+    uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    w = __builtin_bswap64(w);
+#endif
+    return w;
+}
+
+/// Свойства выходного типа
+template <typename T> struct OutTraits;
+template <> struct OutTraits<uint32_t> { enum { wide = 0, sign = 0 }; typedef uint32_t raw; };
+template <> struct OutTraits<int32_t>  { enum { wide = 0, sign = 1 }; typedef uint32_t raw; };
+template <> struct OutTraits<uint64_t> { enum { wide = 1, sign = 0 }; typedef uint64_t raw; };
+template <> struct OutTraits<int64_t>  { enum { wide = 1, sign = 1 }; typedef uint64_t raw; };
+
+inline uint32_t toRaw(uint32_t v) { return v; }
+inline uint32_t toRaw(int32_t v)  { return zigzagEncode(v); }
+inline uint64_t toRaw(uint64_t v) { return v; }
+inline uint64_t toRaw(int64_t v)  { return zigzagEncode(v); }
+
+inline void fromRaw(uint32_t v, uint32_t & out) { out = v; }
+inline void fromRaw(uint32_t v, int32_t & out)  { out = zigzagDecode(v); }
+inline void fromRaw(uint64_t v, uint64_t & out) { out = v; }
+inline void fromRaw(uint64_t v, int64_t & out)  { out = zigzagDecode(v); }
+
+#if defined(MLIB_SIMD_SSE2)
+/// Zig-zag декодирование 32-битных дорожек
+inline __m128i zigzagDecode128(__m128i v)
+{
+    return _mm_xor_si128(_mm_srli_epi32(v, 1),
+                         _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, _mm_set1_epi32(1))));
+}
+
+/// Запись 4 32-битных дорожек в выходной массив
+template <typename T>
+inline void store4(__m128i q, T * out)
+{
+    if (OutTraits<T>::sign)
+        q = zigzagDecode128(q);
+    if (OutTraits<T>::wide)
+    {
+        const __m128i ext = OutTraits<T>::sign ? _mm_srai_epi32(q, 31) : _mm_setzero_si128();
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),     _mm_unpacklo_epi32(q, ext));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2), _mm_unpackhi_epi32(q, ext));
+    }
+    else
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), q);
+}
+
+/// Запись 8 16-битных дорожек в выходной массив
+template <typename T>
+inline void store8(__m128i v, T * out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    store4(_mm_unpacklo_epi16(v, zero), out);
+    store4(_mm_unpackhi_epi16(v, zero), out + 4);
+}
+
+/// Развертывание 16 однобайтовых чисел
+template <typename T>
+inline void expand16(__m128i v, T * out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    store8(_mm_unpacklo_epi8(v, zero), out);
+    store8(_mm_unpackhi_epi8(v, zero), out + 8);
+}
+#endif // MLIB_SIMD_SSE2
+
+#if defined(MLIB_SIMD_SSSE3)
+/// Таблицы декодирования LEB128 по маске признаков продолжения 8 байтов (Masked VByte).
+/// Для каждой маски: перестановка, размещающая подряд идущие одно- и двухбайтовые числа
+/// по 16-битным дорожкам, количество таких чисел и количество занимаемых ими байтов.
+struct MaskedVByteTables
+{
+    uint8_t shuffle[256][16];
+    uint8_t count[256];
+    uint8_t consumed[256];
+
+    MaskedVByteTables()
+    {
+        for (int mask = 0; mask < 256; ++mask)
+        {
+            int n = 0;
+            int start = 0;
+            for (int k = 0; k < 16; ++k)
+                shuffle[mask][k] = 0x80;
+            for (int k = 0; k < 8; ++k)
+            {
+                if (mask & (1 << k))
+                    continue;
+                if (k - start + 1 > 2)
+                    break;
+                shuffle[mask][2 * n]     = static_cast<uint8_t>(start);
+                shuffle[mask][2 * n + 1] = static_cast<uint8_t>(k > start ? start + 1 : 0x80);
+                ++n;
+                start = k + 1;
+            }
+            count[mask] = static_cast<uint8_t>(n);
+            consumed[mask] = static_cast<uint8_t>(start);
+        }
+    }
+};
+
+inline const MaskedVByteTables & maskedVByteTables()
+{
+    static const MaskedVByteTables tables;
+    return tables;
+}
+#endif // MLIB_SIMD_SSSE3
+
+/// Сжатие групп по 7 бит из 64-битного слова (байты без признака продолжения)
+inline uint64_t compact7(uint64_t w)
+{
+#if defined(MLIB_ISA_BMI2) && defined(MLIB_ARCH_X86_64)
+    return bits::pext(w, static_cast<uint64_t>(0x7F7F7F7F7F7F7F7Full));
+#else
+    return  (w & 0x7Full)
+         | ((w >> 1) & 0x3F80ull)
+         | ((w >> 2) & 0x1FC000ull)
+         | ((w >> 3) & 0xFE00000ull)
+         | ((w >> 4) & 0x7F0000000ull)
+         | ((w >> 5) & 0x3F800000000ull)
+         | ((w >> 6) & 0x1FC0000000000ull)
+         | ((w >> 7) & 0xFE000000000000ull);
+#endif
+}
+
+template <typename T>
+size_t encodeArray(const T * in, size_t count, uint8_t * out)
+{
+    uint8_t * p = out;
+    for (size_t i = 0; i < count; ++i)
+        p += varintEncode(toRaw(in[i]), p);
+    return static_cast<size_t>(p - out);
+}
+
+template <typename T>
+size_t decodeArray(const uint8_t * in, size_t size, T * out, size_t count)
+{
+    typedef typename OutTraits<T>::raw raw_t;
+    const size_t maxBytes = OutTraits<T>::wide ? 8 : cVarIntMaxBytes32;
+    size_t pos = 0;
+    size_t i = 0;
+#if defined(MLIB_SIMD_SSSE3)
+    const MaskedVByteTables & tables = maskedVByteTables();
+#endif
+
+    while (i < count)
+    {
+#if defined(MLIB_SIMD_SSE2)
+        if (count - i >= 16 && size - pos >= 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+            const int mask = _mm_movemask_epi8(v);
+            // Серия из 16 однобайтовых чисел
+            if (mask == 0)
+            {
+                expand16(v, out + i);
+                pos += 16;
+                i += 16;
+                continue;
+            }
+    #if defined(MLIB_SIMD_SSSE3)
+            // До 8 одно- и двухбайтовых чисел за одну перестановку
+            const int low = mask & 0xFF;
+            if (tables.count[low] != 0)
+            {
+                const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.shuffle[low]));
+                const __m128i x = _mm_shuffle_epi8(v, shuffle);
+                const __m128i r = _mm_or_si128(_mm_and_si128(x, _mm_set1_epi16(0x007F)),
+                                               _mm_and_si128(_mm_srli_epi16(x, 1), _mm_set1_epi16(0x3F80)));
+                store8(r, out + i);
+                pos += tables.consumed[low];
+                i += tables.count[low];
+                continue;
+            }
+    #endif
+        }
+#endif
+        if (size - pos >= 8)
+        {
+            uint64_t w = loadLe64(in + pos);
+            const uint64_t stop = ~w & 0x8080808080808080ull;
+            const size_t len = static_cast<size_t>(bits::ctz(stop)) / 8 + 1;
+            if (len <= maxBytes)
+            {
+                if (len < 8)
+                    w &= ~0ull >> (64 - 8 * len);
+                const uint64_t v = compact7(w);
+                if (!OutTraits<T>::wide && (v >> 32) != 0)
+                    return 0;
+                fromRaw(static_cast<raw_t>(v), out[i++]);
+                pos += len;
+                continue;
+            }
+            if (!OutTraits<T>::wide)
+                return 0;
+        }
+
+        raw_t v = 0;
+        const size_t len = varintDecode(in + pos, size - pos, v);
+        if (len == 0)
+            return 0;
+        fromRaw(v, out[i++]);
+        pos += len;
+    }
+    return pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Таблицы Stream VByte: маски перестановки и длина данных для каждого управляющего байта
+struct StreamVByteTables
+{
+    uint8_t shuffle[256][16];
+    uint8_t length[256];
+
+    StreamVByteTables()
+    {
+        for (int c = 0; c < 256; ++c)
+        {
+            int src = 0;
+            for (int k = 0; k < 4; ++k)
+            {
+                const int len = ((c >> (2 * k)) & 3) + 1;
+                for (int b = 0; b < 4; ++b)
+                    shuffle[c][4 * k + b] = static_cast<uint8_t>(b < len ? src + b : 0x80);
+                src += len;
+            }
+            length[c] = static_cast<uint8_t>(src);
+        }
+    }
+};
+
+inline const StreamVByteTables & streamVByteTables()
+{
+    static const StreamVByteTables tables;
+    return tables;
+}
+
+template <typename T>
+size_t svbEncode(const T * in, size_t count, uint8_t * out)
+{
+    const size_t ctrlSize = (count + 3) / 4;
+    uint8_t * ctrl = out;
+    uint8_t * data = out + ctrlSize;
+    std::memset(ctrl, 0, ctrlSize);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t v = toRaw(in[i]);
+        const unsigned code = (v > 0xFFu) + (v > 0xFFFFu) + (v > 0xFFFFFFu);
+        ctrl[i / 4] = static_cast<uint8_t>(ctrl[i / 4] | (code << (2 * (i % 4))));
+        data[0] = static_cast<uint8_t>(v);
+        data[1] = static_cast<uint8_t>(v >> 8);
+        data[2] = static_cast<uint8_t>(v >> 16);
+        data[3] = static_cast<uint8_t>(v >> 24);
+        data += code + 1;
+    }
+    return static_cast<size_t>(data - out);
+}
+
+template <typename T>
+size_t svbDecode(const uint8_t * in, size_t size, T * out, size_t count)
+{
+    const size_t ctrlSize = (count + 3) / 4;
+    if (size < ctrlSize)
+        return 0;
+    const uint8_t * ctrl = in;
+    const uint8_t * data = in + ctrlSize;
+    const uint8_t * end = in + size;
+    size_t i = 0;
+
+#if defined(MLIB_SIMD_SSSE3)
+    const StreamVByteTables & tables = streamVByteTables();
+    for (; i + 4 <= count && end - data >= 16; i += 4)
+    {
+        const uint8_t c = ctrl[i / 4];
+        const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.shuffle[c]));
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)), mask);
+        if (OutTraits<T>::sign)
+            v = zigzagDecode128(v);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), v);
+        data += tables.length[c];
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const size_t code = (ctrl[i / 4] >> (2 * (i % 4))) & 3;
+        const size_t len = code + 1;
+        uint32_t v = 0;
+        if (end - data >= 4)
+        {
+            v = static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8)
+              | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+            v &= 0xFFFFFFFFu >> (8 * (3 - code));
+        }
+        else
+        {
+            if (static_cast<size_t>(end - data) < len)
+                return 0;
+            for (size_t b = 0; b < len; ++b)
+                v |= static_cast<uint32_t>(data[b]) << (8 * b);
+        }
+        fromRaw(v, out[i]);
+        data += len;
+    }
+    return static_cast<size_t>(data - in);
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t varintEncode(uint32_t value, uint8_t * out)
+{
+    size_t n = 0;
+    while (value >= 0x80)
+    {
+        out[n++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+size_t varintEncode(uint64_t value, uint8_t * out)
+{
+    size_t n = 0;
+    while (value >= 0x80)
+    {
+        out[n++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t varintDecode(const uint8_t * in, size_t size, uint32_t & value)
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < size && i < cVarIntMaxBytes32; ++i)
+    {
+        const uint8_t b = in[i];
+        result |= static_cast<uint32_t>(b & 0x7F) << (7 * i);
+        if ((b & 0x80) == 0)
+        {
+            // В пятом байте допустимы только 4 младших бита
+            if (i == cVarIntMaxBytes32 - 1 && b > 0x0F)
+                return 0;
+            value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+size_t varintDecode(const uint8_t * in, size_t size, uint64_t & value)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < size && i < cVarIntMaxBytes64; ++i)
+    {
+        const uint8_t b = in[i];
+        result |= static_cast<uint64_t>(b & 0x7F) << (7 * i);
+        if ((b & 0x80) == 0)
+        {
+            // В десятом байте допустим только 1 младший бит
+            if (i == cVarIntMaxBytes64 - 1 && b > 0x01)
+                return 0;
+            value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t varintEncodeArray(const uint32_t * in, size_t count, uint8_t * out)
+{   return encodeArray(in, count, out); }
+
+size_t varintEncodeArray(const int32_t * in, size_t count, uint8_t * out)
+{   return encodeArray(in, count, out); }
+
+size_t varintEncodeArray(const uint64_t * in, size_t count, uint8_t * out)
+{   return encodeArray(in, count, out); }
+
+size_t varintEncodeArray(const int64_t * in, size_t count, uint8_t * out)
+{   return encodeArray(in, count, out); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t varintDecodeArray(const uint8_t * in, size_t size, uint32_t * out, size_t count)
+{   return decodeArray(in, size, out, count); }
+
+size_t varintDecodeArray(const uint8_t * in, size_t size, int32_t * out, size_t count)
+{   return decodeArray(in, size, out, count); }
+
+size_t varintDecodeArray(const uint8_t * in, size_t size, uint64_t * out, size_t count)
+{   return decodeArray(in, size, out, count); }
+
+size_t varintDecodeArray(const uint8_t * in, size_t size, int64_t * out, size_t count)
+{   return decodeArray(in, size, out, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t streamVByteEncode(const uint32_t * in, size_t count, uint8_t * out)
+{   return svbEncode(in, count, out); }
+
+size_t streamVByteEncode(const int32_t * in, size_t count, uint8_t * out)
+{   return svbEncode(in, count, out); }
+
+size_t streamVByteDecode(const uint8_t * in, size_t size, uint32_t * out, size_t count)
+{   return svbDecode(in, size, out, count); }
+
+size_t streamVByteDecode(const uint8_t * in, size_t size, int32_t * out, size_t count)
+{   return svbDecode(in, size, out, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
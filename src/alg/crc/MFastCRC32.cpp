@@ -90,7 +90,7 @@ const crc32_t crc32FastTable[256] = {
     0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d,
 };
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void updateCrc32(const unsigned char * data, unsigned long int length, crc32_t & crc32)
+void crc32Update(const unsigned char * data, crc32_t length, crc32_t & crc32)
 {
     for (; length--; ++data)
 	{
@@ -98,5 +98,15 @@ void updateCrc32(const unsigned char * data, unsigned long int length, crc32_t &
 	}
 }
 ////////////////////////////////////////////////////////////////////////////////////////////////////
+bool crc32SelfTest()
+{
+    static const unsigned char cCheckData[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    crc32_t crc;
+    crc32Init(crc);
+    crc32Update(cCheckData, sizeof(cCheckData), crc);
+    crc32Result(crc);
+    return crc == cCrc32Check;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
 MLIB_END_NAMESPACE
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MSpatialIndex.cpp
+/// @brief Пространственный индекс точек на плоскости: равномерная сетка в порядке Мортона
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Сортировка - LSD поразрядная по байтам кода, гистограммы всех байтов за один проход.
+/// Обрабатываются только байты, в которые помещается код наибольшей ячейки, и пропускаются
+/// байты, одинаковые у всех ключей.
+///
+/// Остановка поиска k ближайших: все ячейки внутри квадрата колец 0..d просмотрены, точки
+/// вне квадрата не ближе расстояния от запроса до его границы. Расстояние уменьшается на
+/// запас, покрывающий погрешность отнесения точки к ячейке.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MSpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Наибольшее число ячеек сетки по оси
+const double cMaxGrid = 1073741824.0;
+
+template <typename T>
+inline bool isFinite(T v)
+{   return v - v == 0; }
+
+/// Номер ячейки оси для смещения от угла сетки d >= 0
+template <typename T>
+inline uint32_t cellIndex(T d, T invCell, uint32_t n)
+{
+    const uint32_t c = static_cast<uint32_t>(d * invCell);
+    return c < n ? c : n - 1;
+}
+
+/// Вставка в упорядоченный список k ближайших
+template <typename T>
+inline void insertNearest(uint32_t id, T d2, uint32_t * indices, T * dist2, size_t k, size_t & found)
+{
+    if (found == k && !(d2 < dist2[k - 1]))
+        return;
+    size_t j = found < k ? found++ : k - 1;
+    for (; j > 0 && dist2[j - 1] > d2; --j)
+    {
+        dist2[j] = dist2[j - 1];
+        indices[j] = indices[j - 1];
+    }
+    dist2[j] = d2;
+    indices[j] = id;
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename _Ty>
+MSpatialIndex2<_Ty>::MSpatialIndex2(_Ty cellSize)
+    : m_cellSize(cellSize), m_cell(cellSize), m_invCell(0), m_originX(0), m_originY(0),
+      m_gridW(0), m_gridH(0), m_slack(0)
+{}
+
+template <typename _Ty>
+void MSpatialIndex2<_Ty>::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_id.clear();
+    m_cellCode.clear();
+    m_cellStart.clear();
+    m_cellTable.clear();
+    m_gridW = 0;
+    m_gridH = 0;
+}
+
+template <typename _Ty>
+void MSpatialIndex2<_Ty>::rebuild(const _Ty * x, const _Ty * y, size_t count)
+{
+    clear();
+
+    // Границы конечных точек
+    _Ty minX = std::numeric_limits<_Ty>::infinity(), minY = minX;
+    _Ty maxX = -minX, maxY = -minX;
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!isFinite(x[i]) || !isFinite(y[i]))
+            continue;
+        minX = x[i] < minX ? x[i] : minX;
+        maxX = x[i] > maxX ? x[i] : maxX;
+        minY = y[i] < minY ? y[i] : minY;
+        maxY = y[i] > maxY ? y[i] : maxY;
+        ++n;
+    }
+    if (n == 0)
+        return;
+
+    // Размер ячейки: заданный или около двух точек на ячейку, но не больше cMaxGrid ячеек по оси
+    const double w = static_cast<double>(maxX) - minX;
+    const double h = static_cast<double>(maxY) - minY;
+    const double extent = w > h ? w : h;
+    double cell = m_cellSize;
+    if (!(cell > 0))
+    {
+        cell = w * h > 0 ? std::sqrt(2.0 * w * h / static_cast<double>(n))
+                         : 2.0 * extent / static_cast<double>(n);
+        if (!(cell > 0))
+            cell = 1.0;
+    }
+    if (extent / cell >= cMaxGrid)
+        cell = extent / (cMaxGrid - 1.0);
+
+    m_cell = static_cast<_Ty>(cell);
+    m_invCell = static_cast<_Ty>(1.0 / cell);
+    m_originX = minX;
+    m_originY = minY;
+    m_gridW = static_cast<uint32_t>(w / cell) + 1;
+    m_gridH = static_cast<uint32_t>(h / cell) + 1;
+    m_slack = static_cast<_Ty>(cell * 1.0e-3 + (std::fabs(static_cast<double>(minX)) +
+                                                std::fabs(static_cast<double>(minY)) + w + h) *
+                                               std::numeric_limits<_Ty>::epsilon() * 4);
+
+    // Коды ячеек
+    m_keys.resize(n);
+    m_order.resize(n);
+    for (size_t i = 0, j = 0; i < count; ++i)
+    {
+        if (!isFinite(x[i]) || !isFinite(y[i]))
+            continue;
+        m_keys[j] = mortonEncode2(cellIndex<_Ty>(x[i] - m_originX, m_invCell, m_gridW),
+                                  cellIndex<_Ty>(y[i] - m_originY, m_invCell, m_gridH));
+        m_order[j] = static_cast<uint32_t>(i);
+        ++j;
+    }
+
+    // Поразрядная сортировка по байтам, занятым кодами
+    const uint32_t maxCell = m_gridW > m_gridH ? m_gridW - 1 : m_gridH - 1;
+    const int bytes = (2 * bits::bitWidth(maxCell) + 7) / 8;
+    size_t hist[8][256];
+    std::memset(hist, 0, sizeof(hist));
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t key = m_keys[i];
+        for (int b = 0; b < bytes; ++b)
+            ++hist[b][(key >> (8 * b)) & 0xFF];
+    }
+    m_keysTmp.resize(n);
+    m_orderTmp.resize(n);
+    for (int b = 0; b < bytes; ++b)
+    {
+        const unsigned shift = 8 * b;
+        size_t * hb = hist[b];
+        if (hb[(m_keys[0] >> shift) & 0xFF] == n)
+            continue;
+        size_t sum = 0;
+        for (int v = 0; v < 256; ++v)
+        {
+            const size_t c = hb[v];
+            hb[v] = sum;
+            sum += c;
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            const size_t pos = hb[(m_keys[i] >> shift) & 0xFF]++;
+            m_keysTmp[pos] = m_keys[i];
+            m_orderTmp[pos] = m_order[i];
+        }
+        m_keys.swap(m_keysTmp);
+        m_order.swap(m_orderTmp);
+    }
+
+    // Точки в порядке кодов и таблица непустых ячеек
+    m_x.resize(n);
+    m_y.resize(n);
+    m_id.resize(n);
+    for (size_t j = 0; j < n; ++j)
+    {
+        const uint32_t i = m_order[j];
+        m_x[j] = x[i];
+        m_y[j] = y[i];
+        m_id[j] = i;
+        if (j == 0 || m_keys[j] != m_keys[j - 1])
+        {
+            m_cellCode.push_back(m_keys[j]);
+            m_cellStart.push_back(static_cast<uint32_t>(j));
+        }
+    }
+    m_cellStart.push_back(static_cast<uint32_t>(n));
+
+    // Прямая таблица для плотной сетки
+    const uint64_t gridCells = static_cast<uint64_t>(m_gridW) * m_gridH;
+    if (gridCells <= 4 * static_cast<uint64_t>(n) + 1024)
+    {
+        m_cellTable.assign(static_cast<size_t>(gridCells), invalidIndex());
+        for (size_t c = 0; c < m_cellCode.size(); ++c)
+        {
+            uint32_t cx, cy;
+            mortonDecode2(m_cellCode[c], cx, cy);
+            m_cellTable[static_cast<size_t>(cy) * m_gridW + cx] = static_cast<uint32_t>(c);
+        }
+    }
+}
+
+template <typename _Ty>
+bool MSpatialIndex2<_Ty>::cellRange(_Ty a, _Ty b, _Ty origin, uint32_t n, uint32_t & lo, uint32_t & hi) const
+{
+    const _Ty fa = (a - origin) * m_invCell;
+    const _Ty fb = (b - origin) * m_invCell;
+    if (!(fb >= 0) || !(fa < static_cast<_Ty>(n)))
+        return false;
+    lo = fa > 0 ? static_cast<uint32_t>(fa) : 0;
+    hi = fb < static_cast<_Ty>(n) ? static_cast<uint32_t>(fb) : n - 1;
+    lo = lo < n ? lo : n - 1;
+    return true;
+}
+
+template <typename _Ty>
+size_t MSpatialIndex2<_Ty>::findCell(uint32_t cx, uint32_t cy) const
+{
+    if (!m_cellTable.empty())
+    {
+        const uint32_t c = m_cellTable[static_cast<size_t>(cy) * m_gridW + cx];
+        return c != invalidIndex() ? c : m_cellCode.size();
+    }
+    const uint64_t code = mortonEncode2(cx, cy);
+    const std::vector<uint64_t>::const_iterator it =
+        std::lower_bound(m_cellCode.begin(), m_cellCode.end(), code);
+    return it != m_cellCode.end() && *it == code ? static_cast<size_t>(it - m_cellCode.begin())
+                                                 : m_cellCode.size();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename _Ty>
+size_t MSpatialIndex2<_Ty>::queryRadius(_Ty x, _Ty y, _Ty r, std::vector<uint32_t> & out) const
+{
+    uint32_t x0, x1, y0, y1;
+    if (m_id.empty() || !(r >= 0) ||
+        !cellRange(x - r, x + r, m_originX, m_gridW, x0, x1) ||
+        !cellRange(y - r, y + r, m_originY, m_gridH, y0, y1))
+        return 0;
+
+    const size_t before = out.size();
+    const _Ty r2 = r * r;
+    const uint64_t box = static_cast<uint64_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+    const size_t cells = m_cellCode.size();
+    for (size_t c = 0, cx = x0, cy = y0; ; )
+    {
+        // Непустые ячейки подряд, если их меньше, чем ячеек квадрата, иначе - ячейки квадрата
+        size_t cell;
+        if (box > cells)
+        {
+            if (c == cells)
+                break;
+            uint32_t ux, uy;
+            mortonDecode2(m_cellCode[c], ux, uy);
+            cell = ux >= x0 && ux <= x1 && uy >= y0 && uy <= y1 ? c : cells;
+            ++c;
+        }
+        else
+        {
+            if (cy > y1)
+                break;
+            cell = findCell(static_cast<uint32_t>(cx), static_cast<uint32_t>(cy));
+            if (++cx > x1)
+            {
+                cx = x0;
+                ++cy;
+            }
+        }
+        if (cell == cells)
+            continue;
+        for (size_t i = m_cellStart[cell], end = m_cellStart[cell + 1]; i < end; ++i)
+        {
+            const _Ty dx = m_x[i] - x;
+            const _Ty dy = m_y[i] - y;
+            if (dx * dx + dy * dy <= r2)
+                out.push_back(m_id[i]);
+        }
+    }
+    return out.size() - before;
+}
+
+template <typename _Ty>
+size_t MSpatialIndex2<_Ty>::queryKNearest(_Ty x, _Ty y, size_t k, uint32_t * indices, _Ty * dist2) const
+{
+    _Ty local[16];
+    std::vector<_Ty> heap;
+    _Ty * d2 = dist2;
+    if (d2 == 0)
+    {
+        if (k > 16)
+            heap.resize(k);
+        d2 = k > 16 ? &heap[0] : local;
+    }
+    for (size_t j = 0; j < k; ++j)
+    {
+        indices[j] = invalidIndex();
+        d2[j] = std::numeric_limits<_Ty>::infinity();
+    }
+    if (k == 0 || m_id.empty() || !isFinite(x) || !isFinite(y))
+        return 0;
+
+    size_t found = 0;
+    const size_t cells = m_cellCode.size();
+
+    // Ячейка запроса; вне сетки - соседняя с краем сетки
+    const int64_t gx1 = static_cast<int64_t>(m_gridW) - 1;
+    const int64_t gy1 = static_cast<int64_t>(m_gridH) - 1;
+    const _Ty fx = (x - m_originX) * m_invCell;
+    const _Ty fy = (y - m_originY) * m_invCell;
+    const int64_t cx = fx < 0 ? -1 : fx >= static_cast<_Ty>(m_gridW) ? gx1 + 1 : static_cast<int64_t>(fx);
+    const int64_t cy = fy < 0 ? -1 : fy >= static_cast<_Ty>(m_gridH) ? gy1 + 1 : static_cast<int64_t>(fy);
+
+    size_t visited = 0;
+    for (int64_t d = (cx < 0 || cx > gx1 || cy < 0 || cy > gy1) ? 1 : 0; ; ++d)
+    {
+        const int64_t xa = cx - d, xb = cx + d, ya = cy - d, yb = cy + d;
+        const int64_t ca = xa > 0 ? xa : 0, cb = xb < gx1 ? xb : gx1;
+        const int64_t ra = ya + 1 > 0 ? ya + 1 : 0, rb = yb - 1 < gy1 ? yb - 1 : gy1;
+
+        // Клетки кольца в пределах сетки: нижняя и верхняя строки, левый и правый столбцы
+        for (int side = 0; side < 4; ++side)
+        {
+            int64_t u0, u1, v;
+            bool row = side < 2;
+            if (side == 0)      { u0 = ca; u1 = cb; v = ya; }
+            else if (side == 1) { u0 = ca; u1 = cb; v = yb; }
+            else if (side == 2) { u0 = ra; u1 = rb; v = xa; }
+            else                { u0 = ra; u1 = rb; v = xb; }
+            if ((d == 0 && side > 0) || v < 0 || v > (row ? gy1 : gx1))
+                continue;
+            for (int64_t u = u0; u <= u1; ++u)
+            {
+                const size_t cell = row ? findCell(static_cast<uint32_t>(u), static_cast<uint32_t>(v))
+                                        : findCell(static_cast<uint32_t>(v), static_cast<uint32_t>(u));
+                ++visited;
+                if (cell == cells)
+                    continue;
+                for (size_t i = m_cellStart[cell], end = m_cellStart[cell + 1]; i < end; ++i)
+                {
+                    const _Ty dx = m_x[i] - x;
+                    const _Ty dy = m_y[i] - y;
+                    insertNearest(m_id[i], dx * dx + dy * dy, indices, d2, k, found);
+                }
+            }
+        }
+
+        // Вся сетка просмотрена
+        if (xa <= 0 && ya <= 0 && xb >= gx1 && yb >= gy1)
+            break;
+        // Точки вне квадрата колец дальше найденных
+        if (found == k)
+        {
+            const _Ty left = x - (m_originX + static_cast<_Ty>(xa) * m_cell);
+            const _Ty right = m_originX + static_cast<_Ty>(xb + 1) * m_cell - x;
+            const _Ty bottom = y - (m_originY + static_cast<_Ty>(ya) * m_cell);
+            const _Ty top = m_originY + static_cast<_Ty>(yb + 1) * m_cell - y;
+            const _Ty bound = std::min(std::min(left, right), std::min(bottom, top)) - m_slack;
+            if (bound > 0 && bound * bound > d2[k - 1])
+                break;
+        }
+        // Колец больше, чем непустых ячеек - полный перебор
+        if (visited > 2 * cells + 16)
+        {
+            found = 0;
+            for (size_t i = 0; i < m_id.size(); ++i)
+            {
+                const _Ty dx = m_x[i] - x;
+                const _Ty dy = m_y[i] - y;
+                insertNearest(m_id[i], dx * dx + dy * dy, indices, d2, k, found);
+            }
+            break;
+        }
+    }
+    return found;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename _Ty>
+void MSpatialIndex2<_Ty>::queryRadius(const _Ty * x, const _Ty * y, size_t count, _Ty r,
+                                      std::vector<size_t> & offsets, std::vector<uint32_t> & indices) const
+{
+    offsets.resize(count + 1);
+    indices.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        offsets[i] = indices.size();
+        queryRadius(x[i], y[i], r, indices);
+    }
+    offsets[count] = indices.size();
+}
+
+template <typename _Ty>
+void MSpatialIndex2<_Ty>::queryKNearest(const _Ty * x, const _Ty * y, size_t count, size_t k,
+                                        uint32_t * indices, _Ty * dist2) const
+{
+    for (size_t i = 0; i < count; ++i)
+        queryKNearest(x[i], y[i], k, indices + i * k, dist2 != 0 ? dist2 + i * k : 0);
+}
+
+template class MSpatialIndex2<float>;
+template class MSpatialIndex2<double>;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
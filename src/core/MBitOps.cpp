@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MBitOps.cpp
+/// @brief Подсчет битов в массивах
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// AVX2: подсчет по полубайтам через таблицу в регистре (vpshufb) и суммирование vpsadbw
+/// (алгоритм W. Muła). AVX-512: инструкция vpopcntq.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MBitOps.h"
+#include <cstring>
+#if defined(MLIB_SIMD_AVX2) || defined(MLIB_SIMD_AVX512VPOPCNTDQ)
+    #include <immintrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace bits {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Источник данных - один буфер
+struct SourceOne
+{
+    const unsigned char * a;
+
+    inline uint64_t word(size_t pos) const
+    {
+        uint64_t v;
+        std::memcpy(&v, a + pos, sizeof(v));
+        return v;
+    }
+    inline unsigned char byte(size_t pos) const { return a[pos]; }
+#if defined(MLIB_SIMD_AVX2)
+    inline __m256i load256(size_t pos) const
+    { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + pos)); }
+#endif
+#if defined(MLIB_SIMD_AVX512VPOPCNTDQ)
+    inline __m512i load512(size_t pos) const
+    { return _mm512_loadu_si512(a + pos); }
+#endif
+};
+
+/// Источник данных - исключающее ИЛИ двух буферов
+struct SourceXor
+{
+    const unsigned char * a;
+    const unsigned char * b;
+
+    inline uint64_t word(size_t pos) const
+    {
+        uint64_t va, vb;
+        std::memcpy(&va, a + pos, sizeof(va));
+        std::memcpy(&vb, b + pos, sizeof(vb));
+        return va ^ vb;
+    }
+    inline unsigned char byte(size_t pos) const { return static_cast<unsigned char>(a[pos] ^ b[pos]); }
+#if defined(MLIB_SIMD_AVX2)
+    inline __m256i load256(size_t pos) const
+    {
+        return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + pos)),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + pos)));
+    }
+#endif
+#if defined(MLIB_SIMD_AVX512VPOPCNTDQ)
+    inline __m512i load512(size_t pos) const
+    { return _mm512_xor_si512(_mm512_loadu_si512(a + pos), _mm512_loadu_si512(b + pos)); }
+#endif
+};
+
+template <class Source>
+uint64_t countBits(const Source & src, size_t size)
+{
+    uint64_t total = 0;
+    size_t pos = 0;
+
+#if defined(MLIB_SIMD_AVX512VPOPCNTDQ)
+    __m512i acc512 = _mm512_setzero_si512();
+    for (; pos + 64 <= size; pos += 64)
+        acc512 = _mm512_add_epi64(acc512, _mm512_popcnt_epi64(src.load512(pos)));
+    uint64_t sums[8];
+    _mm512_storeu_si512(sums, acc512);
+    for (int i = 0; i < 8; ++i)
+        total += sums[i];
+#elif defined(MLIB_SIMD_AVX2)
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i acc = _mm256_setzero_si256();
+    while (pos + 32 <= size)
+    {
+        // Счетчики байтов (не более 8 на итерацию) переполнятся не раньше чем через 31 итерацию
+        __m256i bytes = _mm256_setzero_si256();
+        for (int i = 0; i < 31 && pos + 32 <= size; ++i, pos += 32)
+        {
+            const __m256i v = src.load256(pos);
+            const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low));
+            const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+            bytes = _mm256_add_epi8(bytes, _mm256_add_epi8(lo, hi));
+        }
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    uint64_t sums[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), acc);
+    total += sums[0] + sums[1] + sums[2] + sums[3];
+#endif
+
+    for (; pos + 8 <= size; pos += 8)
+        total += static_cast<uint64_t>(popcount(src.word(pos)));
+    for (; pos < size; ++pos)
+        total += static_cast<uint64_t>(popcount(src.byte(pos)));
+    return total;
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t popcountBuffer(const void * data, size_t size)
+{
+    SourceOne src = { static_cast<const unsigned char *>(data) };
+    return countBits(src, size);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t hammingDistance(const void * a, const void * b, size_t size)
+{
+    SourceXor src = { static_cast<const unsigned char *>(a), static_cast<const unsigned char *>(b) };
+    return countBits(src, size);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace bits
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
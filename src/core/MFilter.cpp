@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MFilter.cpp
+/// @brief Потоковые фильтры: КИХ, скользящее среднее, скользящие минимум и максимум
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// КИХ: буфер = [история N - 1 отсчет | порция входа L отсчетов], коэффициенты хранятся в
+/// обратном порядке hr[j] = h[N - 1 - j], тогда y[n] = Σ hr[j] buf[n + j] - непрерывные
+/// загрузки со сдвигом j. После порции последние N - 1 отсчетов переносятся в начало буфера.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MFilter.h"
+#include "MMathKernels.h"
+#include <algorithm>
+#include <cstring>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+using namespace detail;
+
+/// Порция входа КИХ-фильтра
+const size_t cFirChunk = 1024;
+
+/// out[n] = Σ hr[j] buf[n + j], n = begin .. count - 1
+template <class Vec>
+size_t firBlock(const typename Vec::T * hr, size_t taps, const typename Vec::T * buf,
+                typename Vec::T * out, size_t begin, size_t count)
+{
+    typedef typename Vec::V V;
+
+    size_t n = begin;
+    // Четыре регистра результата на один размноженный коэффициент
+    for (; n + 4 * Vec::Width <= count; n += 4 * Vec::Width)
+    {
+        V a0 = Vec::set1(0), a1 = a0, a2 = a0, a3 = a0;
+        const typename Vec::T * p = buf + n;
+        for (size_t j = 0; j < taps; ++j, ++p)
+        {
+            const V h = Vec::set1(hr[j]);
+            a0 = Vec::fmadd(h, Vec::load(p), a0);
+            a1 = Vec::fmadd(h, Vec::load(p + Vec::Width), a1);
+            a2 = Vec::fmadd(h, Vec::load(p + 2 * Vec::Width), a2);
+            a3 = Vec::fmadd(h, Vec::load(p + 3 * Vec::Width), a3);
+        }
+        Vec::store(out + n, a0);
+        Vec::store(out + n + Vec::Width, a1);
+        Vec::store(out + n + 2 * Vec::Width, a2);
+        Vec::store(out + n + 3 * Vec::Width, a3);
+    }
+    for (; n + Vec::Width <= count; n += Vec::Width)
+    {
+        V a = Vec::set1(0);
+        for (size_t j = 0; j < taps; ++j)
+            a = Vec::fmadd(Vec::set1(hr[j]), Vec::load(buf + n + j), a);
+        Vec::store(out + n, a);
+    }
+    return n;
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// MFirFilter
+
+template <typename _Ty>
+MFirFilter<_Ty>::MFirFilter(const _Ty * taps, size_t count)
+    : m_taps(taps, taps + count),
+      m_buffer(count - 1 + cFirChunk, _Ty(0))
+{
+    std::reverse(m_taps.begin(), m_taps.end());
+}
+
+template <typename _Ty>
+void MFirFilter<_Ty>::reset()
+{   std::fill(m_buffer.begin(), m_buffer.end(), _Ty(0)); }
+
+template <typename _Ty>
+void MFirFilter<_Ty>::process(const _Ty * in, _Ty * out, size_t count)
+{
+    typedef typename VecBest<_Ty>::type Vec;
+
+    const size_t taps = m_taps.size();
+    const size_t hist = taps - 1;
+    _Ty * buf = &m_buffer[0];
+    for (size_t pos = 0; pos < count; pos += cFirChunk)
+    {
+        const size_t len = count - pos < cFirChunk ? count - pos : cFirChunk;
+        // Вход копируется до записи выхода, поэтому in == out допустимо
+        std::memcpy(buf + hist, in + pos, len * sizeof(_Ty));
+        const size_t n = firBlock<Vec>(&m_taps[0], taps, buf, out + pos, 0, len);
+        firBlock<Vec1<_Ty> >(&m_taps[0], taps, buf, out + pos, n, len);
+        std::memmove(buf, buf + len, hist * sizeof(_Ty));
+    }
+}
+
+template class MFirFilter<float>;
+template class MFirFilter<double>;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// MMovingAverage
+
+template <typename _Ty>
+MMovingAverage<_Ty>::MMovingAverage(size_t window)
+    : m_ring(window, _Ty(0)), m_pos(0), m_filled(0), m_sum(0.0)
+{}
+
+template <typename _Ty>
+void MMovingAverage<_Ty>::reset()
+{
+    m_pos = 0;
+    m_filled = 0;
+    m_sum = 0.0;
+}
+
+template <typename _Ty>
+void MMovingAverage<_Ty>::wrap()
+{
+    m_pos = 0;
+    double s = 0.0;
+    for (size_t i = 0; i < m_ring.size(); ++i)
+        s += m_ring[i];
+    m_sum = s;
+}
+
+template <typename _Ty>
+void MMovingAverage<_Ty>::process(const _Ty * in, _Ty * out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = process(in[i]);
+}
+
+template class MMovingAverage<float>;
+template class MMovingAverage<double>;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// MMovingExtremum
+
+template <typename _Ty, bool _IsMax>
+MMovingExtremum<_Ty, _IsMax>::MMovingExtremum(size_t window)
+    : m_values(window), m_index(window), m_head(0), m_size(0), m_count(0)
+{}
+
+template <typename _Ty, bool _IsMax>
+void MMovingExtremum<_Ty, _IsMax>::reset()
+{
+    m_head = 0;
+    m_size = 0;
+    m_count = 0;
+}
+
+template <typename _Ty, bool _IsMax>
+_Ty MMovingExtremum<_Ty, _IsMax>::process(_Ty x)
+{
+    const size_t cap = m_values.size();
+
+    // Выход из окна самого старого элемента очереди
+    if (m_size > 0 && m_index[m_head] + cap <= m_count)
+    {
+        m_head = m_head + 1 == cap ? 0 : m_head + 1;
+        --m_size;
+    }
+    // Снятие с хвоста элементов, которые x делает ненужными
+    while (m_size > 0)
+    {
+        size_t tail = m_head + m_size - 1;
+        if (tail >= cap)
+            tail -= cap;
+        if (_IsMax ? m_values[tail] > x : m_values[tail] < x)
+            break;
+        --m_size;
+    }
+    size_t pos = m_head + m_size;
+    if (pos >= cap)
+        pos -= cap;
+    m_values[pos] = x;
+    m_index[pos] = m_count++;
+    ++m_size;
+    return m_values[m_head];
+}
+
+template <typename _Ty, bool _IsMax>
+void MMovingExtremum<_Ty, _IsMax>::process(const _Ty * in, _Ty * out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = process(in[i]);
+}
+
+template class MMovingExtremum<float, false>;
+template class MMovingExtremum<float, true>;
+template class MMovingExtremum<double, false>;
+template class MMovingExtremum<double, true>;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
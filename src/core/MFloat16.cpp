@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MFloat16.cpp
+/// @brief Массовое преобразование float <-> float16_t / bfloat16_t
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// SSE2-вариант binary16 - векторная запись скалярного алгоритма (F. Giesen):
+/// денормализованные числа округляются сложением во float, нормализованные - целочисленно.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MFloat16.h"
+#if defined(MLIB_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+#if defined(MLIB_SIMD_AVX2) || defined(MLIB_SIMD_F16C)
+    #include <immintrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static_assert(sizeof(float16_t) == 2 && sizeof(bfloat16_t) == 2, "16-bit storage types expected");
+
+namespace {
+
+#if defined(MLIB_SIMD_SSE2)
+/// Выбор по маске: mask ? a : b
+inline __m128i select128(__m128i mask, __m128i a, __m128i b)
+{   return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+
+/// Упаковка младших 16 бит восьми 32-битных дорожек
+inline __m128i pack16(__m128i lo, __m128i hi)
+{
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+                           _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+}
+
+/// float -> binary16 (результат в младших 16 битах дорожек)
+inline __m128i floatToHalf4(__m128 value)
+{
+    const __m128i f = _mm_castps_si128(value);
+    const __m128i sign = _mm_and_si128(f, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    const __m128i absf = _mm_xor_si128(f, sign);
+
+    // Денормализованные числа
+    const __m128i magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i sub = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(absf), _mm_castsi128_ps(magic))),
+                                      magic);
+    // Нормализованные числа: округление к ближайшему четному
+    const __m128i odd = _mm_and_si128(_mm_srli_epi32(absf, 13), _mm_set1_epi32(1));
+    const __m128i rebias = _mm_sub_epi32(_mm_add_epi32(absf, odd), _mm_set1_epi32((127 - 15) << 23));
+    const __m128i norm = _mm_srli_epi32(_mm_add_epi32(rebias, _mm_set1_epi32(0xFFF)), 13);
+    // Переполнение, бесконечность, NaN
+    const __m128i isNan = _mm_cmpgt_epi32(absf, _mm_set1_epi32(0x7F800000));
+    const __m128i payload = _mm_or_si128(_mm_set1_epi32(0x200),
+                                         _mm_and_si128(_mm_srli_epi32(absf, 13), _mm_set1_epi32(0x3FF)));
+    const __m128i special = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(isNan, payload));
+
+    const __m128i isSub = _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), absf);
+    const __m128i isRegular = _mm_cmpgt_epi32(_mm_set1_epi32(0x47800000), absf);
+    const __m128i h = select128(isRegular, select128(isSub, sub, norm), special);
+    return _mm_or_si128(h, _mm_srli_epi32(sign, 16));
+}
+
+/// binary16 (младшие 16 бит дорожек) -> float
+inline __m128 halfToFloat4(__m128i h)
+{
+    const __m128i expmant = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+    const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, expmant), 16);
+    // Умножение на 2^112 переводит порядок и нормализует денормализованные числа
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expmant, 13)),
+                                     _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+    const __m128i isInfNan = _mm_cmpgt_epi32(expmant, _mm_set1_epi32(0x7BFF));
+    const __m128i infNan = _mm_and_si128(isInfNan, _mm_set1_epi32(255 << 23));
+    // Сигнальный NaN становится тихим (как vcvtph2ps)
+    const __m128i quiet = _mm_and_si128(_mm_cmpgt_epi32(expmant, _mm_set1_epi32(0x7C00)),
+                                        _mm_set1_epi32(0x400000));
+    return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(_mm_or_si128(sign, infNan), quiet)));
+}
+
+/// float -> bfloat16 (результат в старших 16 битах дорожек)
+inline __m128i floatToBfloat4(__m128 value)
+{
+    const __m128i f = _mm_castps_si128(value);
+    const __m128i absf = _mm_and_si128(f, _mm_set1_epi32(0x7FFFFFFF));
+    const __m128i isNan = _mm_cmpgt_epi32(absf, _mm_set1_epi32(0x7F800000));
+    const __m128i odd = _mm_and_si128(_mm_srli_epi32(f, 16), _mm_set1_epi32(1));
+    const __m128i rounded = _mm_add_epi32(_mm_add_epi32(f, _mm_set1_epi32(0x7FFF)), odd);
+    return select128(isNan, _mm_or_si128(f, _mm_set1_epi32(0x400000)), rounded);
+}
+#endif // MLIB_SIMD_SSE2
+
+#if defined(MLIB_SIMD_AVX2)
+/// float -> bfloat16 (результат в старших 16 битах дорожек)
+inline __m256i floatToBfloat8(__m256 value)
+{
+    const __m256i f = _mm256_castps_si256(value);
+    const __m256i absf = _mm256_and_si256(f, _mm256_set1_epi32(0x7FFFFFFF));
+    const __m256i isNan = _mm256_cmpgt_epi32(absf, _mm256_set1_epi32(0x7F800000));
+    const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(f, 16), _mm256_set1_epi32(1));
+    const __m256i rounded = _mm256_add_epi32(_mm256_add_epi32(f, _mm256_set1_epi32(0x7FFF)), odd);
+    return _mm256_blendv_epi8(rounded, _mm256_or_si256(f, _mm256_set1_epi32(0x400000)), isNan);
+}
+#endif // MLIB_SIMD_AVX2
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void toFloat16(const float * in, float16_t * out, size_t count)
+{
+    uint16_t * dst = reinterpret_cast<uint16_t *>(out);
+    size_t i = 0;
+#if defined(MLIB_SIMD_F16C)
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#elif defined(MLIB_SIMD_SSE2)
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                         pack16(floatToHalf4(_mm_loadu_ps(in + i)), floatToHalf4(_mm_loadu_ps(in + i + 4))));
+#endif
+    for (; i < count; ++i)
+        dst[i] = float16_t::fromFloat(in[i]);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void fromFloat16(const float16_t * in, float * out, size_t count)
+{
+    const uint16_t * src = reinterpret_cast<const uint16_t *>(in);
+    size_t i = 0;
+#if defined(MLIB_SIMD_F16C)
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))));
+#elif defined(MLIB_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_ps(out + i,     halfToFloat4(_mm_unpacklo_epi16(h, zero)));
+        _mm_storeu_ps(out + i + 4, halfToFloat4(_mm_unpackhi_epi16(h, zero)));
+    }
+#endif
+    for (; i < count; ++i)
+        out[i] = float16_t::toFloat(src[i]);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void toBfloat16(const float * in, bfloat16_t * out, size_t count)
+{
+    uint16_t * dst = reinterpret_cast<uint16_t *>(out);
+    size_t i = 0;
+#if defined(MLIB_SIMD_AVX2)
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i lo = _mm256_srai_epi32(floatToBfloat8(_mm256_loadu_ps(in + i)), 16);
+        const __m256i hi = _mm256_srai_epi32(floatToBfloat8(_mm256_loadu_ps(in + i + 8)), 16);
+        // packs работает внутри 128-битных половин, восстанавливаем порядок
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                            _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8));
+    }
+#endif
+#if defined(MLIB_SIMD_SSE2)
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i lo = _mm_srai_epi32(floatToBfloat4(_mm_loadu_ps(in + i)), 16);
+        const __m128i hi = _mm_srai_epi32(floatToBfloat4(_mm_loadu_ps(in + i + 4)), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packs_epi32(lo, hi));
+    }
+#endif
+    for (; i < count; ++i)
+        dst[i] = bfloat16_t::fromFloat(in[i]);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void fromBfloat16(const bfloat16_t * in, float * out, size_t count)
+{
+    const uint16_t * src = reinterpret_cast<const uint16_t *>(in);
+    size_t i = 0;
+#if defined(MLIB_SIMD_AVX2)
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+        _mm256_storeu_ps(out + i, _mm256_castsi256_ps(_mm256_slli_epi32(h, 16)));
+    }
+#elif defined(MLIB_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_ps(out + i,     _mm_castsi128_ps(_mm_unpacklo_epi16(zero, h)));
+        _mm_storeu_ps(out + i + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(zero, h)));
+    }
+#endif
+    for (; i < count; ++i)
+        out[i] = bfloat16_t::toFloat(src[i]);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
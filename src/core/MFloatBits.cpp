@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MFloatBits.cpp
+/// @brief Битовое представление чисел с плавающей точкой (binary32/binary64)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Векторные проверки возвращают битовую маску дорожек (movemask), дальнейшая обработка
+/// (счетчик, досрочный выход) общая для всех наборов инструкций.
+/// NaN/Inf определяются как x * 0 != x * 0 (результат NaN только для нечисловых x).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MFloatBits.h"
+#include "MBitOps.h"
+#if defined(MLIB_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+#if defined(MLIB_SIMD_AVX2)
+    #include <immintrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+inline bool isNonFinite(float value)
+{
+    binary32 f;
+    f.f = value;
+    return (f.u & 0x7F800000u) == 0x7F800000u;
+}
+
+inline bool isNonFinite(double value)
+{
+    binary64 f;
+    f.f = value;
+    return (f.u & 0x7FF0000000000000ull) == 0x7FF0000000000000ull;
+}
+
+/// Векторные операции для типа T (Width = 1 - векторизации нет)
+template <typename T> struct Vec;
+
+#if defined(MLIB_SIMD_AVX2)
+template <> struct Vec<float>
+{
+    enum { Width = 8 };
+
+    static inline int nonFinite(const float * p)
+    {
+        const __m256 z = _mm256_mul_ps(_mm256_loadu_ps(p), _mm256_setzero_ps());
+        return _mm256_movemask_ps(_mm256_cmp_ps(z, z, _CMP_UNORD_Q));
+    }
+
+    static inline __m256i ordered(__m256 v)
+    {
+        const __m256i i = _mm256_castps_si256(v);
+        const __m256i m = _mm256_srai_epi32(i, 31);
+        return _mm256_sub_epi32(_mm256_xor_si256(i, _mm256_srli_epi32(m, 1)), m);
+    }
+
+    /// Маска дорожек, отличающихся более чем на maxUlps
+    static inline int outside(__m256 a, __m256 b, uint32_t maxUlps)
+    {
+        const __m256i oa = ordered(a);
+        const __m256i ob = ordered(b);
+        const __m256i d = _mm256_sub_epi32(_mm256_max_epi32(oa, ob), _mm256_min_epi32(oa, ob));
+        const __m256i bias = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+        const __m256i far = _mm256_cmpgt_epi32(_mm256_xor_si256(d, bias),
+                                               _mm256_set1_epi32(static_cast<int>(maxUlps ^ 0x80000000u)));
+        return _mm256_movemask_ps(_mm256_or_ps(_mm256_castsi256_ps(far), _mm256_cmp_ps(a, b, _CMP_UNORD_Q)));
+    }
+
+    static inline int outside(const float * a, const float * b, uint32_t maxUlps)
+    {   return outside(_mm256_loadu_ps(a), _mm256_loadu_ps(b), maxUlps); }
+
+    static inline int outside(const float * a, float b, uint32_t maxUlps)
+    {   return outside(_mm256_loadu_ps(a), _mm256_set1_ps(b), maxUlps); }
+};
+
+template <> struct Vec<double>
+{
+    enum { Width = 4 };
+
+    static inline int nonFinite(const double * p)
+    {
+        const __m256d z = _mm256_mul_pd(_mm256_loadu_pd(p), _mm256_setzero_pd());
+        return _mm256_movemask_pd(_mm256_cmp_pd(z, z, _CMP_UNORD_Q));
+    }
+
+    static inline __m256i ordered(__m256d v)
+    {
+        const __m256i i = _mm256_castpd_si256(v);
+        const __m256i m = _mm256_cmpgt_epi64(_mm256_setzero_si256(), i);
+        return _mm256_sub_epi64(_mm256_xor_si256(i, _mm256_srli_epi64(m, 1)), m);
+    }
+
+    static inline int outside(__m256d a, __m256d b, uint64_t maxUlps)
+    {
+        const __m256i oa = ordered(a);
+        const __m256i ob = ordered(b);
+        const __m256i gt = _mm256_cmpgt_epi64(oa, ob);
+        const __m256i d = _mm256_sub_epi64(_mm256_blendv_epi8(ob, oa, gt), _mm256_blendv_epi8(oa, ob, gt));
+        const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+        const __m256i far = _mm256_cmpgt_epi64(_mm256_xor_si256(d, bias),
+                                               _mm256_set1_epi64x(static_cast<long long>(maxUlps ^ 0x8000000000000000ull)));
+        return _mm256_movemask_pd(_mm256_or_pd(_mm256_castsi256_pd(far), _mm256_cmp_pd(a, b, _CMP_UNORD_Q)));
+    }
+
+    static inline int outside(const double * a, const double * b, uint64_t maxUlps)
+    {   return outside(_mm256_loadu_pd(a), _mm256_loadu_pd(b), maxUlps); }
+
+    static inline int outside(const double * a, double b, uint64_t maxUlps)
+    {   return outside(_mm256_loadu_pd(a), _mm256_set1_pd(b), maxUlps); }
+};
+#elif defined(MLIB_SIMD_SSE2)
+template <> struct Vec<float>
+{
+    enum { Width = 4 };
+
+    static inline int nonFinite(const float * p)
+    {
+        const __m128 z = _mm_mul_ps(_mm_loadu_ps(p), _mm_setzero_ps());
+        return _mm_movemask_ps(_mm_cmpunord_ps(z, z));
+    }
+
+    static inline __m128i ordered(__m128 v)
+    {
+        const __m128i i = _mm_castps_si128(v);
+        const __m128i m = _mm_srai_epi32(i, 31);
+        return _mm_sub_epi32(_mm_xor_si128(i, _mm_srli_epi32(m, 1)), m);
+    }
+
+    static inline int outside(__m128 a, __m128 b, uint32_t maxUlps)
+    {
+        const __m128i oa = ordered(a);
+        const __m128i ob = ordered(b);
+        const __m128i gt = _mm_cmpgt_epi32(oa, ob);
+        // |oa - ob| = (oa - ob) для gt, иначе (ob - oa)
+        const __m128i diff = _mm_sub_epi32(oa, ob);
+        const __m128i d = _mm_sub_epi32(_mm_xor_si128(diff, _mm_xor_si128(gt, _mm_set1_epi32(-1))),
+                                        _mm_xor_si128(gt, _mm_set1_epi32(-1)));
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i far = _mm_cmpgt_epi32(_mm_xor_si128(d, bias),
+                                            _mm_set1_epi32(static_cast<int>(maxUlps ^ 0x80000000u)));
+        return _mm_movemask_ps(_mm_or_ps(_mm_castsi128_ps(far), _mm_cmpunord_ps(a, b)));
+    }
+
+    static inline int outside(const float * a, const float * b, uint32_t maxUlps)
+    {   return outside(_mm_loadu_ps(a), _mm_loadu_ps(b), maxUlps); }
+
+    static inline int outside(const float * a, float b, uint32_t maxUlps)
+    {   return outside(_mm_loadu_ps(a), _mm_set1_ps(b), maxUlps); }
+};
+
+template <> struct Vec<double>
+{
+    enum { Width = 2 };
+
+    static inline int nonFinite(const double * p)
+    {
+        const __m128d z = _mm_mul_pd(_mm_loadu_pd(p), _mm_setzero_pd());
+        return _mm_movemask_pd(_mm_cmpunord_pd(z, z));
+    }
+
+    // Сравнение 64-битных целых в SSE2 нет, расстояние в ULP считается скалярно
+    static inline int outside(const double * a, const double * b, uint64_t maxUlps)
+    {   return (isEqualUlps(a[0], b[0], maxUlps) ? 0 : 1) | (isEqualUlps(a[1], b[1], maxUlps) ? 0 : 2); }
+
+    static inline int outside(const double * a, double b, uint64_t maxUlps)
+    {   return (isEqualUlps(a[0], b, maxUlps) ? 0 : 1) | (isEqualUlps(a[1], b, maxUlps) ? 0 : 2); }
+};
+#else
+template <typename T> struct Vec
+{
+    enum { Width = 1 };
+
+    static inline int nonFinite(const T * p)
+    {   return isNonFinite(*p) ? 1 : 0; }
+
+    template <typename U>
+    static inline int outside(const T * a, const T * b, U maxUlps)
+    {   return isEqualUlps(*a, *b, maxUlps) ? 0 : 1; }
+
+    template <typename U>
+    static inline int outside(const T * a, T b, U maxUlps)
+    {   return isEqualUlps(*a, b, maxUlps) ? 0 : 1; }
+};
+#endif
+
+template <typename T>
+bool anyNonFiniteImpl(const T * data, size_t count)
+{
+    typedef Vec<T> V;
+    size_t i = 0;
+    for (; i + 4 * V::Width <= count; i += 4 * V::Width)
+    {
+        if (V::nonFinite(data + i) | V::nonFinite(data + i + V::Width)
+          | V::nonFinite(data + i + 2 * V::Width) | V::nonFinite(data + i + 3 * V::Width))
+            return true;
+    }
+    for (; i < count; ++i)
+    {
+        if (isNonFinite(data[i]))
+            return true;
+    }
+    return false;
+}
+
+template <typename T>
+size_t countNonFiniteImpl(const T * data, size_t count)
+{
+    typedef Vec<T> V;
+    size_t total = 0;
+    size_t i = 0;
+    for (; i + V::Width <= count; i += V::Width)
+        total += static_cast<size_t>(bits::popcount(static_cast<unsigned int>(V::nonFinite(data + i))));
+    for (; i < count; ++i)
+        total += isNonFinite(data[i]) ? 1 : 0;
+    return total;
+}
+
+/// Эталон - массив
+template <typename T>
+struct RefArray
+{
+    const T * p;
+    inline const T * at(size_t i) const { return p + i; }
+    inline T value(size_t i) const { return p[i]; }
+};
+
+/// Эталон - одно значение
+template <typename T>
+struct RefValue
+{
+    T v;
+    inline T at(size_t) const { return v; }
+    inline T value(size_t) const { return v; }
+};
+
+template <typename T, class Ref, typename U>
+bool allWithinUlpsImpl(const T * data, const Ref & reference, size_t count, U maxUlps)
+{
+    typedef Vec<T> V;
+    size_t i = 0;
+    for (; i + 2 * V::Width <= count; i += 2 * V::Width)
+    {
+        if (V::outside(data + i, reference.at(i), maxUlps)
+          | V::outside(data + i + V::Width, reference.at(i + V::Width), maxUlps))
+            return false;
+    }
+    for (; i < count; ++i)
+    {
+        if (!isEqualUlps(data[i], reference.value(i), maxUlps))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool anyNonFinite(const float * data, size_t count)     { return anyNonFiniteImpl(data, count); }
+bool anyNonFinite(const double * data, size_t count)    { return anyNonFiniteImpl(data, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t countNonFinite(const float * data, size_t count) { return countNonFiniteImpl(data, count); }
+size_t countNonFinite(const double * data, size_t count){ return countNonFiniteImpl(data, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool allWithinUlps(const float * data, const float * reference, size_t count, uint32_t maxUlps)
+{
+    RefArray<float> ref = { reference };
+    return allWithinUlpsImpl(data, ref, count, maxUlps);
+}
+
+bool allWithinUlps(const double * data, const double * reference, size_t count, uint64_t maxUlps)
+{
+    RefArray<double> ref = { reference };
+    return allWithinUlpsImpl(data, ref, count, maxUlps);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool allWithinUlps(const float * data, float reference, size_t count, uint32_t maxUlps)
+{
+    RefValue<float> ref = { reference };
+    return allWithinUlpsImpl(data, ref, count, maxUlps);
+}
+
+bool allWithinUlps(const double * data, double reference, size_t count, uint64_t maxUlps)
+{
+    RefValue<double> ref = { reference };
+    return allWithinUlpsImpl(data, ref, count, maxUlps);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MGeoCoord.cpp
+/// @brief Преобразования координат WGS-84: геодезические, ECEF, местные ENU
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Прямое: N = a / √(1 - e² sin²φ), x = (N + h) cosφ cosλ, y = (N + h) cosφ sinλ,
+/// z = (N (1 - e²) + h) sinφ.
+///
+/// Обратное (Боуринг): p = √(x² + y²), приведенная широта β: tgβ = (b/a) tgφ, начальное
+/// приближение tgβ = z a / (p b); итерация tgφ = (z + e'² b sin³β) / (p - e² a cos³β).
+/// Углы хранятся парами (sin, cos), полученными нормировкой вектора (числитель, знаменатель).
+/// Высота h = p cosφ + z sinφ - a √(1 - e² sin²φ) устойчива при любой широте.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGeoCoord.h"
+#include "MMathKernels.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace geo {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+using namespace math::detail;
+
+/// Граница углов рабочего диапазона sin/cos
+inline double angleLimit() { return 16777216.0; }
+
+/// Маска дорожек, где хотя бы одно значение - NaN или не меньше границы по модулю
+/// (limitAB - для a и b, limitC - для c; высота ограничена только конечностью)
+template <class Vec>
+inline typename Vec::M invalid(typename Vec::V a, typename Vec::V b, typename Vec::V c,
+                               double limitAB, double limitC = std::numeric_limits<double>::infinity())
+{
+    const typename Vec::V ab = Vec::set1(limitAB);
+    return Vec::or_(Vec::or_(Vec::nlt(Vec::abs(a), ab), Vec::nlt(Vec::abs(b), ab)),
+                    Vec::nlt(Vec::abs(c), Vec::set1(limitC)));
+}
+
+template <class Vec>
+inline void toEcef(typename Vec::V lat, typename Vec::V lon, typename Vec::V h,
+                   typename Vec::V & x, typename Vec::V & y, typename Vec::V & z)
+{
+    typedef typename Vec::V V;
+
+    V sp, cp, sl, cl;
+    sinCosKernel<Vec, math::AccuracyHigh>(lat, sp, cp);
+    sinCosKernel<Vec, math::AccuracyHigh>(lon, sl, cl);
+    const V w = Vec::sqrt(Vec::sub(Vec::set1(1), Vec::mul(Vec::set1(cWgs84E2()), Vec::mul(sp, sp))));
+    const V n = Vec::div(Vec::set1(cWgs84A()), w);
+    const V r = Vec::mul(Vec::add(n, h), cp);
+    x = Vec::mul(r, cl);
+    y = Vec::mul(r, sl);
+    z = Vec::mul(Vec::fmadd(n, Vec::set1(1 - cWgs84E2()), h), sp);
+}
+
+template <class Vec>
+inline void fromEcef(typename Vec::V x, typename Vec::V y, typename Vec::V z,
+                     typename Vec::V & lat, typename Vec::V & lon, typename Vec::V & h)
+{
+    typedef typename Vec::V V;
+
+    const double a = cWgs84A();
+    const double b = cWgs84B();
+    const double e2 = cWgs84E2();
+    const V one = Vec::set1(1);
+    const V ep2b = Vec::set1(e2 / (1 - e2) * b);
+    const V e2a = Vec::set1(e2 * a);
+    const V va = Vec::set1(a);
+    const V vb = Vec::set1(b);
+
+    const V p = Vec::sqrt(Vec::fmadd(x, x, Vec::mul(y, y)));
+
+    // Начальное приближение приведенной широты
+    V u = Vec::mul(z, va);
+    V v = Vec::mul(p, vb);
+    V r = Vec::sqrt(Vec::fmadd(u, u, Vec::mul(v, v)));
+    V sb = Vec::div(u, r);
+    V cb = Vec::div(v, r);
+
+    V num, den;
+    for (int k = 0; k < 2; ++k)
+    {
+        num = Vec::fmadd(ep2b, Vec::mul(sb, Vec::mul(sb, sb)), z);
+        den = Vec::sub(p, Vec::mul(e2a, Vec::mul(cb, Vec::mul(cb, cb))));
+        if (k == 1)
+            break;
+        u = Vec::mul(vb, num);
+        v = Vec::mul(va, den);
+        r = Vec::sqrt(Vec::fmadd(u, u, Vec::mul(v, v)));
+        sb = Vec::div(u, r);
+        cb = Vec::div(v, r);
+    }
+
+    lat = arcTanKernel<Vec, math::AccuracyHigh>(num, den);
+    lon = arcTanKernel<Vec, math::AccuracyHigh>(y, x);
+    const V rp = Vec::sqrt(Vec::fmadd(num, num, Vec::mul(den, den)));
+    const V sp = Vec::div(num, rp);
+    const V cp = Vec::div(den, rp);
+    const V w = Vec::sqrt(Vec::sub(one, Vec::mul(Vec::set1(e2), Vec::mul(sp, sp))));
+    h = Vec::sub(Vec::fmadd(p, cp, Vec::mul(z, sp)), Vec::mul(va, w));
+}
+
+/// Поворот: out = m * in
+template <class Vec>
+inline void rotate(const math::MMat3d & m, typename Vec::V a, typename Vec::V b, typename Vec::V c,
+                   typename Vec::V & x, typename Vec::V & y, typename Vec::V & z)
+{
+    x = Vec::fmadd(Vec::set1(m(0, 0)), a, Vec::fmadd(Vec::set1(m(0, 1)), b, Vec::mul(Vec::set1(m(0, 2)), c)));
+    y = Vec::fmadd(Vec::set1(m(1, 0)), a, Vec::fmadd(Vec::set1(m(1, 1)), b, Vec::mul(Vec::set1(m(1, 2)), c)));
+    z = Vec::fmadd(Vec::set1(m(2, 0)), a, Vec::fmadd(Vec::set1(m(2, 1)), b, Vec::mul(Vec::set1(m(2, 2)), c)));
+}
+
+/// Поворот транспонированной матрицей: out = m^T * in
+template <class Vec>
+inline void rotateBack(const math::MMat3d & m, typename Vec::V a, typename Vec::V b, typename Vec::V c,
+                       typename Vec::V & x, typename Vec::V & y, typename Vec::V & z)
+{
+    x = Vec::fmadd(Vec::set1(m(0, 0)), a, Vec::fmadd(Vec::set1(m(1, 0)), b, Vec::mul(Vec::set1(m(2, 0)), c)));
+    y = Vec::fmadd(Vec::set1(m(0, 1)), a, Vec::fmadd(Vec::set1(m(1, 1)), b, Vec::mul(Vec::set1(m(2, 1)), c)));
+    z = Vec::fmadd(Vec::set1(m(0, 2)), a, Vec::fmadd(Vec::set1(m(1, 2)), b, Vec::mul(Vec::set1(m(2, 2)), c)));
+}
+
+//--------------------------------------------------------------------------------------------------
+// Преобразования (три входа -> три выхода)
+
+struct OpToEcef
+{
+    template <class Vec>
+    inline typename Vec::M operator()(typename Vec::V lat, typename Vec::V lon, typename Vec::V h,
+                                      typename Vec::V & x, typename Vec::V & y, typename Vec::V & z) const
+    {
+        toEcef<Vec>(lat, lon, h, x, y, z);
+        return invalid<Vec>(lat, lon, h, angleLimit());
+    }
+};
+
+struct OpFromEcef
+{
+    template <class Vec>
+    inline typename Vec::M operator()(typename Vec::V x, typename Vec::V y, typename Vec::V z,
+                                      typename Vec::V & lat, typename Vec::V & lon, typename Vec::V & h) const
+    {
+        fromEcef<Vec>(x, y, z, lat, lon, h);
+        return invalid<Vec>(x, y, z, std::numeric_limits<double>::infinity());
+    }
+};
+
+struct OpEcefToEnu
+{
+    const MEnuFrame & frame;
+
+    template <class Vec>
+    inline typename Vec::M operator()(typename Vec::V x, typename Vec::V y, typename Vec::V z,
+                                      typename Vec::V & e, typename Vec::V & n, typename Vec::V & u) const
+    {
+        const math::MVec3d & o = frame.origin();
+        rotate<Vec>(frame.rotation(), Vec::sub(x, Vec::set1(o.x)), Vec::sub(y, Vec::set1(o.y)),
+                    Vec::sub(z, Vec::set1(o.z)), e, n, u);
+        return invalid<Vec>(x, y, z, std::numeric_limits<double>::infinity());
+    }
+};
+
+struct OpEnuToEcef
+{
+    const MEnuFrame & frame;
+
+    template <class Vec>
+    inline typename Vec::M operator()(typename Vec::V e, typename Vec::V n, typename Vec::V u,
+                                      typename Vec::V & x, typename Vec::V & y, typename Vec::V & z) const
+    {
+        const math::MVec3d & o = frame.origin();
+        rotateBack<Vec>(frame.rotation(), e, n, u, x, y, z);
+        x = Vec::add(x, Vec::set1(o.x));
+        y = Vec::add(y, Vec::set1(o.y));
+        z = Vec::add(z, Vec::set1(o.z));
+        return invalid<Vec>(e, n, u, std::numeric_limits<double>::infinity());
+    }
+};
+
+struct OpGeodeticToEnu
+{
+    const MEnuFrame & frame;
+
+    template <class Vec>
+    inline typename Vec::M operator()(typename Vec::V lat, typename Vec::V lon, typename Vec::V h,
+                                      typename Vec::V & e, typename Vec::V & n, typename Vec::V & u) const
+    {
+        typename Vec::V x, y, z;
+        toEcef<Vec>(lat, lon, h, x, y, z);
+        const OpEcefToEnu op = { frame };
+        op.template operator()<Vec>(x, y, z, e, n, u);
+        return invalid<Vec>(lat, lon, h, angleLimit());
+    }
+};
+
+struct OpEnuToGeodetic
+{
+    const MEnuFrame & frame;
+
+    template <class Vec>
+    inline typename Vec::M operator()(typename Vec::V e, typename Vec::V n, typename Vec::V u,
+                                      typename Vec::V & lat, typename Vec::V & lon, typename Vec::V & h) const
+    {
+        typename Vec::V x, y, z;
+        const OpEnuToEcef op = { frame };
+        op.template operator()<Vec>(e, n, u, x, y, z);
+        fromEcef<Vec>(x, y, z, lat, lon, h);
+        return invalid<Vec>(e, n, u, std::numeric_limits<double>::infinity());
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+// Проход по массивам
+
+template <class Vec, class Op>
+size_t transformBlock(const Op & op, const double * a, const double * b, const double * c,
+                      double * x, double * y, double * z, size_t begin, size_t count)
+{
+    typedef typename Vec::V V;
+
+    const V nan = Vec::set1(std::numeric_limits<double>::quiet_NaN());
+
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+    {
+        V vx, vy, vz;
+        const typename Vec::M bad = op.template operator()<Vec>(Vec::load(a + i), Vec::load(b + i),
+                                                                 Vec::load(c + i), vx, vy, vz);
+        Vec::store(x + i, Vec::select(bad, nan, vx));
+        Vec::store(y + i, Vec::select(bad, nan, vy));
+        Vec::store(z + i, Vec::select(bad, nan, vz));
+    }
+    return i;
+}
+
+template <class Op>
+inline void transform(const Op & op, const double * a, const double * b, const double * c,
+                      double * x, double * y, double * z, size_t count)
+{
+    const size_t i = transformBlock<VecBest<double>::type>(op, a, b, c, x, y, z, 0, count);
+    transformBlock<Vec1<double> >(op, a, b, c, x, y, z, i, count);
+}
+
+/// float - через буферы double
+template <class Op>
+void transform(const Op & op, const float * a, const float * b, const float * c,
+               float * x, float * y, float * z, size_t count)
+{
+    const size_t Chunk = 256;
+    double in[3][Chunk];
+    double out[3][Chunk];
+    for (size_t pos = 0; pos < count; pos += Chunk)
+    {
+        const size_t n = count - pos < Chunk ? count - pos : Chunk;
+        for (size_t j = 0; j < n; ++j)
+        {
+            in[0][j] = a[pos + j];
+            in[1][j] = b[pos + j];
+            in[2][j] = c[pos + j];
+        }
+        transform(op, in[0], in[1], in[2], out[0], out[1], out[2], n);
+        for (size_t j = 0; j < n; ++j)
+        {
+            x[pos + j] = static_cast<float>(out[0][j]);
+            y[pos + j] = static_cast<float>(out[1][j]);
+            z[pos + j] = static_cast<float>(out[2][j]);
+        }
+    }
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MEnuFrame::MEnuFrame(double lat, double lon, double height)
+    : m_lat(lat), m_lon(lon), m_height(height)
+{
+    const double sp = std::sin(lat), cp = std::cos(lat);
+    const double sl = std::sin(lon), cl = std::cos(lon);
+    const double n = cWgs84A() / std::sqrt(1.0 - cWgs84E2() * sp * sp);
+    m_origin = math::MVec3d((n + height) * cp * cl,
+                            (n + height) * cp * sl,
+                            (n * (1.0 - cWgs84E2()) + height) * sp);
+    m_rotation = math::MMat3d(-sl,       cl,      0.0,
+                              -sp * cl, -sp * sl, cp,
+                               cp * cl,  cp * sl, sp);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void geodeticToEcef(const float * lat, const float * lon, const float * height,
+                    float * x, float * y, float * z, size_t count)
+{   transform(OpToEcef(), lat, lon, height, x, y, z, count); }
+
+void geodeticToEcef(const double * lat, const double * lon, const double * height,
+                    double * x, double * y, double * z, size_t count)
+{   transform(OpToEcef(), lat, lon, height, x, y, z, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void ecefToGeodetic(const float * x, const float * y, const float * z,
+                    float * lat, float * lon, float * height, size_t count)
+{   transform(OpFromEcef(), x, y, z, lat, lon, height, count); }
+
+void ecefToGeodetic(const double * x, const double * y, const double * z,
+                    double * lat, double * lon, double * height, size_t count)
+{   transform(OpFromEcef(), x, y, z, lat, lon, height, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void ecefToEnu(const MEnuFrame & frame, const float * x, const float * y, const float * z,
+               float * e, float * n, float * u, size_t count)
+{
+    const OpEcefToEnu op = { frame };
+    transform(op, x, y, z, e, n, u, count);
+}
+
+void ecefToEnu(const MEnuFrame & frame, const double * x, const double * y, const double * z,
+               double * e, double * n, double * u, size_t count)
+{
+    const OpEcefToEnu op = { frame };
+    transform(op, x, y, z, e, n, u, count);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void enuToEcef(const MEnuFrame & frame, const float * e, const float * n, const float * u,
+               float * x, float * y, float * z, size_t count)
+{
+    const OpEnuToEcef op = { frame };
+    transform(op, e, n, u, x, y, z, count);
+}
+
+void enuToEcef(const MEnuFrame & frame, const double * e, const double * n, const double * u,
+               double * x, double * y, double * z, size_t count)
+{
+    const OpEnuToEcef op = { frame };
+    transform(op, e, n, u, x, y, z, count);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void geodeticToEnu(const MEnuFrame & frame, const float * lat, const float * lon, const float * height,
+                   float * e, float * n, float * u, size_t count)
+{
+    const OpGeodeticToEnu op = { frame };
+    transform(op, lat, lon, height, e, n, u, count);
+}
+
+void geodeticToEnu(const MEnuFrame & frame, const double * lat, const double * lon, const double * height,
+                   double * e, double * n, double * u, size_t count)
+{
+    const OpGeodeticToEnu op = { frame };
+    transform(op, lat, lon, height, e, n, u, count);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void enuToGeodetic(const MEnuFrame & frame, const float * e, const float * n, const float * u,
+                   float * lat, float * lon, float * height, size_t count)
+{
+    const OpEnuToGeodetic op = { frame };
+    transform(op, e, n, u, lat, lon, height, count);
+}
+
+void enuToGeodetic(const MEnuFrame & frame, const double * e, const double * n, const double * u,
+                   double * lat, double * lon, double * height, size_t count)
+{
+    const OpEnuToGeodetic op = { frame };
+    transform(op, e, n, u, lat, lon, height, count);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace geo
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
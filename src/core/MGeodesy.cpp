@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MGeodesy.cpp
+/// @brief Расстояние и начальный азимут по дуге большого круга (сфера), пакетные функции
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// dlat = lat2 - lat1, dlon = lon2 - lon1, sin(dlon) и cos(dlon) - через половинный угол:
+///   haversine:   a = sin^2(dlat/2) + cos(lat1) cos(lat2) sin^2(dlon/2), d = 2 atan2(√a, √(1 - a))
+///   cosines:     c = sin(lat1) sin(lat2) + cos(lat1) cos(lat2) cos(dlon), d = atan2(√(1 - c^2), c)
+///   equirect:    x = dlon cos((lat1 + lat2)/2), y = dlat, d = √(x^2 + y^2), азимут atan2(x, y)
+///   азимут:      atan2(sin(dlon) cos(lat2), cos(lat1) sin(lat2) - sin(lat1) cos(lat2) cos(dlon)),
+///                знаменатель в виде sin(dlat) + 2 sin(lat1) cos(lat2) sin^2(dlon/2) - без потери
+///                точности для близких точек
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MGeodesy.h"
+#include "MMathKernels.h"
+#include <algorithm>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace geo {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+using namespace math::detail;
+
+enum { OutDist = 1, OutBear = 2 };
+
+/// Первая точка - одна для всех, sin/cos широты вычисляются один раз
+template <typename T>
+struct SourceOne
+{
+    T lat, lon, sinLat, cosLat;
+
+    inline T latAt(size_t) const { return lat; }
+    inline T lonAt(size_t) const { return lon; }
+
+    template <class Vec>
+    inline void load(size_t, typename Vec::V & vlat, typename Vec::V & vlon) const
+    {
+        vlat = Vec::set1(lat);
+        vlon = Vec::set1(lon);
+    }
+
+    template <class Vec>
+    inline void sinCos(typename Vec::V, typename Vec::V & s, typename Vec::V & c) const
+    {
+        s = Vec::set1(sinLat);
+        c = Vec::set1(cosLat);
+    }
+};
+
+/// Первая точка - из массивов
+template <typename T>
+struct SourceArray
+{
+    const T * lat;
+    const T * lon;
+
+    inline T latAt(size_t i) const { return lat[i]; }
+    inline T lonAt(size_t i) const { return lon[i]; }
+
+    template <class Vec>
+    inline void load(size_t i, typename Vec::V & vlat, typename Vec::V & vlon) const
+    {
+        vlat = Vec::load(lat + i);
+        vlon = Vec::load(lon + i);
+    }
+
+    template <class Vec>
+    inline void sinCos(typename Vec::V vlat, typename Vec::V & s, typename Vec::V & c) const
+    {   sinCosKernel<Vec, math::AccuracyHigh>(vlat, s, c); }
+};
+
+/// Граница координат, при которой все промежуточные углы остаются в рабочем диапазоне sin/cos
+inline float coordLimit(float)   { return 2048.0f; }
+inline double coordLimit(double) { return 16777216.0; }
+
+/// Одна пара точек функциями std (координаты вне рабочего диапазона, Inf, NaN)
+template <typename T, int Method>
+void geoScalar(T lat1, T lon1, T lat2, T lon2, T & dist, T & bear)
+{
+    const T dlat = lat2 - lat1;
+    const T dlon = lon2 - lon1;
+    if (Method == GeoEquirectangular)
+    {
+        const T w = dlon - math::c2pi<T>() * std::floor(dlon / math::c2pi<T>() + static_cast<T>(0.5));
+        const T x = w * std::cos((lat1 + lat2) / 2);
+        dist = std::sqrt(x * x + dlat * dlat);
+        bear = std::atan2(x, dlat);
+    }
+    else
+    {
+        const T s1 = std::sin(lat1), c1 = std::cos(lat1);
+        const T s2 = std::sin(lat2), c2 = std::cos(lat2);
+        if (Method == GeoHaversine)
+        {
+            const T sl = std::sin(dlat / 2), sn = std::sin(dlon / 2);
+            const T a = std::min(std::max(sl * sl + c1 * c2 * sn * sn, T(0)), T(1));
+            dist = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+        }
+        else
+        {
+            const T c = std::min(std::max(s1 * s2 + c1 * c2 * std::cos(dlon), T(-1)), T(1));
+            dist = std::atan2(std::sqrt((1 - c) * (1 + c)), c);
+        }
+        const T sn = std::sin(dlon / 2);
+        bear = std::atan2(std::sin(dlon) * c2, std::sin(dlat) + 2 * s1 * c2 * sn * sn);
+    }
+    if (bear < 0)
+        bear += math::c2pi<T>();
+}
+
+template <class Vec, int Method, int Out, class Source>
+size_t geoBlock(const Source & src, const typename Vec::T * lat, const typename Vec::T * lon,
+                typename Vec::T * distOut, typename Vec::T * bearOut, typename Vec::T radius,
+                size_t begin, size_t count)
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+
+    const V limit = Vec::set1(coordLimit(T()));
+    const V zero = Vec::set1(0);
+    const V one = Vec::set1(1);
+    const V half = Vec::set1(static_cast<T>(0.5));
+    const V twoPi = Vec::set1(math::c2pi<T>());
+    const V vradius = Vec::set1(radius);
+
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+    {
+        V lat1, lon1;
+        src.template load<Vec>(i, lat1, lon1);
+        const V lat2 = Vec::load(lat + i);
+        const V lon2 = Vec::load(lon + i);
+        if (Vec::any(Vec::or_(Vec::or_(Vec::nlt(Vec::abs(lat1), limit), Vec::nlt(Vec::abs(lon1), limit)),
+                              Vec::or_(Vec::nlt(Vec::abs(lat2), limit), Vec::nlt(Vec::abs(lon2), limit)))))
+        {
+            for (size_t j = i; j < i + Vec::Width; ++j)
+            {
+                T d, b;
+                geoScalar<T, Method>(src.latAt(j), src.lonAt(j), lat[j], lon[j], d, b);
+                if (Out & OutDist)
+                    distOut[j] = d * radius;
+                if (Out & OutBear)
+                    bearOut[j] = b;
+            }
+            continue;
+        }
+
+        const V dlat = Vec::sub(lat2, lat1);
+        const V dlon = Vec::sub(lon2, lon1);
+        V dist = zero, bear = zero, unused;
+        if (Method == GeoEquirectangular)
+        {
+            // Разность долгот в [-ПИ, ПИ]
+            const V w = Vec::sub(dlon, Vec::mul(twoPi, Vec::floor(Vec::fmadd(dlon, Vec::set1(1 / math::c2pi<T>()), half))));
+            V cm;
+            sinCosKernel<Vec, math::AccuracyHigh>(Vec::mul(Vec::add(lat1, lat2), half), unused, cm);
+            const V x = Vec::mul(w, cm);
+            dist = Vec::sqrt(Vec::fmadd(x, x, Vec::mul(dlat, dlat)));
+            if (Out & OutBear)
+                bear = arcTanKernel<Vec, math::AccuracyHigh>(x, dlat);
+        }
+        else
+        {
+            V s1, c1, s2, c2, sh, ch;
+            src.template sinCos<Vec>(lat1, s1, c1);
+            sinCosKernel<Vec, math::AccuracyHigh>(lat2, s2, c2);
+            sinCosKernel<Vec, math::AccuracyHigh>(Vec::mul(dlon, half), sh, ch);
+            const V cc = Vec::mul(c1, c2);
+            // cos(dlon) = 1 - 2 sin^2(dlon/2), sin(dlon) = 2 sin(dlon/2) cos(dlon/2)
+            const V cosDlon = Vec::sub(one, Vec::mul(Vec::set1(2), Vec::mul(sh, sh)));
+            V sl = zero, cl = zero;
+            if (Method == GeoHaversine || (Out & OutBear))
+                sinCosKernel<Vec, math::AccuracyHigh>(Vec::mul(dlat, half), sl, cl);
+            if (Out & OutDist)
+            {
+                if (Method == GeoHaversine)
+                {
+                    V a = Vec::fmadd(sl, sl, Vec::mul(cc, Vec::mul(sh, sh)));
+                    a = Vec::min(Vec::max(a, zero), one);
+                    dist = Vec::mul(Vec::set1(2), arcTanKernel<Vec, math::AccuracyHigh>(Vec::sqrt(a), Vec::sqrt(Vec::sub(one, a))));
+                }
+                else
+                {
+                    V c = Vec::fmadd(cc, cosDlon, Vec::mul(s1, s2));
+                    c = Vec::min(Vec::max(c, Vec::set1(-1)), one);
+                    dist = arcTanKernel<Vec, math::AccuracyHigh>(Vec::sqrt(Vec::mul(Vec::sub(one, c), Vec::add(one, c))), c);
+                }
+            }
+            if (Out & OutBear)
+            {
+                const V y = Vec::mul(Vec::mul(Vec::set1(2), Vec::mul(sh, ch)), c2);
+                // cos(lat1) sin(lat2) - sin(lat1) cos(lat2) cos(dlon) без вычитания близких величин
+                const V x = Vec::mul(Vec::set1(2), Vec::fmadd(sl, cl, Vec::mul(Vec::mul(s1, c2), Vec::mul(sh, sh))));
+                bear = arcTanKernel<Vec, math::AccuracyHigh>(y, x);
+            }
+        }
+
+        if (Out & OutDist)
+            Vec::store(distOut + i, Vec::mul(dist, vradius));
+        if (Out & OutBear)
+            Vec::store(bearOut + i, Vec::add(bear, Vec::ifThen(Vec::lt(bear, zero), twoPi)));
+    }
+    return i;
+}
+
+template <typename T, int Method, int Out, class Source>
+inline void geoRun(const Source & src, const T * lat, const T * lon, T * distOut, T * bearOut,
+                   size_t count, T radius)
+{
+    const size_t i = geoBlock<typename VecBest<T>::type, Method, Out>(src, lat, lon, distOut, bearOut,
+                                                                       radius, 0, count);
+    geoBlock<Vec1<T>, Method, Out>(src, lat, lon, distOut, bearOut, radius, i, count);
+}
+
+template <typename T, int Out, class Source>
+inline void geoAny(const Source & src, const T * lat, const T * lon, T * distOut, T * bearOut,
+                   size_t count, GeoMethod method, T radius)
+{
+    switch (method)
+    {
+    case GeoSphericalCosines: geoRun<T, GeoSphericalCosines, Out>(src, lat, lon, distOut, bearOut, count, radius); break;
+    case GeoEquirectangular:  geoRun<T, GeoEquirectangular, Out>(src, lat, lon, distOut, bearOut, count, radius);  break;
+    default:                  geoRun<T, GeoHaversine, Out>(src, lat, lon, distOut, bearOut, count, radius);        break;
+    }
+}
+
+template <typename T>
+inline SourceOne<T> one(T lat, T lon)
+{
+    SourceOne<T> src = { lat, lon, 0, 0 };
+    sinCosKernel<Vec1<T>, math::AccuracyHigh>(lat, src.sinLat, src.cosLat);
+    return src;
+}
+
+template <typename T>
+inline SourceArray<T> array(const T * lat, const T * lon)
+{
+    SourceArray<T> src = { lat, lon };
+    return src;
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void distance(float lat0, float lon0, const float * lat, const float * lon, float * out, size_t count,
+              GeoMethod method, float radius)
+{   geoAny<float, OutDist>(one(lat0, lon0), lat, lon, out, 0, count, method, radius); }
+
+void distance(double lat0, double lon0, const double * lat, const double * lon, double * out, size_t count,
+              GeoMethod method, double radius)
+{   geoAny<double, OutDist>(one(lat0, lon0), lat, lon, out, 0, count, method, radius); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void bearing(float lat0, float lon0, const float * lat, const float * lon, float * out, size_t count,
+             GeoMethod method)
+{   geoAny<float, OutBear>(one(lat0, lon0), lat, lon, 0, out, count, method, 1.0f); }
+
+void bearing(double lat0, double lon0, const double * lat, const double * lon, double * out, size_t count,
+             GeoMethod method)
+{   geoAny<double, OutBear>(one(lat0, lon0), lat, lon, 0, out, count, method, 1.0); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void distanceBearing(float lat0, float lon0, const float * lat, const float * lon,
+                     float * distOut, float * bearOut, size_t count, GeoMethod method, float radius)
+{   geoAny<float, OutDist | OutBear>(one(lat0, lon0), lat, lon, distOut, bearOut, count, method, radius); }
+
+void distanceBearing(double lat0, double lon0, const double * lat, const double * lon,
+                     double * distOut, double * bearOut, size_t count, GeoMethod method, double radius)
+{   geoAny<double, OutDist | OutBear>(one(lat0, lon0), lat, lon, distOut, bearOut, count, method, radius); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void distance(const float * lat1, const float * lon1, const float * lat2, const float * lon2,
+              float * out, size_t count, GeoMethod method, float radius)
+{   geoAny<float, OutDist>(array(lat1, lon1), lat2, lon2, out, 0, count, method, radius); }
+
+void distance(const double * lat1, const double * lon1, const double * lat2, const double * lon2,
+              double * out, size_t count, GeoMethod method, double radius)
+{   geoAny<double, OutDist>(array(lat1, lon1), lat2, lon2, out, 0, count, method, radius); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void bearing(const float * lat1, const float * lon1, const float * lat2, const float * lon2,
+             float * out, size_t count, GeoMethod method)
+{   geoAny<float, OutBear>(array(lat1, lon1), lat2, lon2, 0, out, count, method, 1.0f); }
+
+void bearing(const double * lat1, const double * lon1, const double * lat2, const double * lon2,
+             double * out, size_t count, GeoMethod method)
+{   geoAny<double, OutBear>(array(lat1, lon1), lat2, lon2, 0, out, count, method, 1.0); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void distanceBearing(const float * lat1, const float * lon1, const float * lat2, const float * lon2,
+                     float * distOut, float * bearOut, size_t count, GeoMethod method, float radius)
+{   geoAny<float, OutDist | OutBear>(array(lat1, lon1), lat2, lon2, distOut, bearOut, count, method, radius); }
+
+void distanceBearing(const double * lat1, const double * lon1, const double * lat2, const double * lon2,
+                     double * distOut, double * bearOut, size_t count, GeoMethod method, double radius)
+{   geoAny<double, OutDist | OutBear>(array(lat1, lon1), lat2, lon2, distOut, bearOut, count, method, radius); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace geo
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
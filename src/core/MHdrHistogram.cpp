@@ -0,0 +1,462 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MHdrHistogram.cpp
+/// @brief Гистограмма задержек с заданной относительной точностью (HdrHistogram)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MHdrHistogram.h"
+#include <algorithm>
+#include <cmath>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Признак формата encode(): "MHD" и версия 1
+const uint8_t cCookie[4] = { 'M', 'H', 'D', 1 };
+
+void putVarint(std::vector<uint8_t> & out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t *& data, const uint8_t * end, uint64_t & value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (data == end)
+            return false;
+        const uint8_t b = *data++;
+        value |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+/// ZigZag: знак в младшем бите, малые по модулю числа - короткие
+inline uint64_t zigzag(int64_t value)
+{   return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+
+inline int64_t unzigzag(uint64_t value)
+{   return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+std::atomic<uint64_t> s_recorderIds(0);
+
+/// Признак потока для выбора копии счетчиков. Признаки не удаляются: при завершении
+/// потока признак освобождается и достается следующему новому потоку вместе со всеми
+/// копиями, которые были за ним закреплены
+struct ThreadToken
+{
+    std::atomic<bool> owned;
+    ThreadToken * next;
+};
+
+std::atomic<ThreadToken *> s_tokens(0);
+thread_local ThreadToken * s_token = 0;
+
+/// Метка s_token после освобождения: копии, закрепленные за признаком, могут уже
+/// принадлежать другому потоку
+char s_releasedTag;
+
+inline ThreadToken * released()
+{   return reinterpret_cast<ThreadToken *>(&s_releasedTag); }
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MHdrHistogram::MHdrHistogram(uint64_t lowest, uint64_t highest, int digits)
+    : m_total(0)
+    , m_min(~static_cast<uint64_t>(0))
+    , m_max(0)
+{
+    m_digits = std::min(std::max(digits, 1), 5);
+    uint64_t largestSingleUnit = 2;
+    for (int i = 0; i < m_digits; ++i)
+        largestSingleUnit *= 10;
+    const int k = bits::bitWidth(largestSingleUnit - 1);  // 2^k >= 2 * 10^digits
+
+    // Верхняя корзина должна помещаться в 64 бита
+    m_lowest = std::min(std::max<uint64_t>(lowest, 1), static_cast<uint64_t>(1) << (62 - k));
+    m_highest = std::max(highest, 2 * m_lowest);
+    m_unitMagnitude = bits::bitWidth(m_lowest) - 1;
+    m_subBucketHalfMagnitude = k - 1;
+    m_subBucketHalf = static_cast<uint64_t>(1) << (k - 1);
+    m_subBucketMask = ((static_cast<uint64_t>(1) << k) - 1) << m_unitMagnitude;
+    m_clzBase = 64 - m_unitMagnitude - k;
+
+    uint64_t smallestUntrackable = static_cast<uint64_t>(1) << (k + m_unitMagnitude);
+    size_t buckets = 1;
+    while (smallestUntrackable <= m_highest)
+    {
+        if (smallestUntrackable > (~static_cast<uint64_t>(0) >> 1))
+        {
+            ++buckets;
+            break;
+        }
+        smallestUntrackable <<= 1;
+        ++buckets;
+    }
+    m_counts.assign((buckets + 1) << (k - 1), 0);
+}
+
+uint64_t MHdrHistogram::valueAt(size_t i) const
+{
+    int bucket = static_cast<int>(i >> m_subBucketHalfMagnitude) - 1;
+    uint64_t sub = (i & (m_subBucketHalf - 1)) + m_subBucketHalf;
+    if (bucket < 0)
+    {
+        sub -= m_subBucketHalf;
+        bucket = 0;
+    }
+    return sub << (bucket + m_unitMagnitude);
+}
+
+uint64_t MHdrHistogram::unitsAt(uint64_t value) const
+{
+    const int bucket = m_clzBase - bits::clz(value | m_subBucketMask);
+    return static_cast<uint64_t>(1) << (m_unitMagnitude + bucket);
+}
+
+uint64_t MHdrHistogram::lowestEquivalent(uint64_t value) const
+{
+    const int bucket = m_clzBase - bits::clz(value | m_subBucketMask);
+    return (value >> (bucket + m_unitMagnitude)) << (bucket + m_unitMagnitude);
+}
+
+uint64_t MHdrHistogram::highestEquivalent(uint64_t value) const
+{   return lowestEquivalent(value) + unitsAt(value) - 1; }
+
+bool MHdrHistogram::sameLayout(const MHdrHistogram & other) const
+{
+    return m_unitMagnitude == other.m_unitMagnitude && m_subBucketHalfMagnitude == other.m_subBucketHalfMagnitude
+        && m_highest == other.m_highest && m_counts.size() == other.m_counts.size();
+}
+
+bool MHdrHistogram::recordCorrected(uint64_t value, uint64_t interval)
+{
+    if (!record(value))
+        return false;
+    if (interval == 0)
+        return true;
+    for (uint64_t missing = value; missing > interval; )
+    {
+        missing -= interval;
+        if (missing < interval)
+            break;
+        record(missing);
+    }
+    return true;
+}
+
+uint64_t MHdrHistogram::add(const MHdrHistogram & other)
+{
+    if (other.m_total == 0)
+        return 0;
+    if (sameLayout(other))
+    {
+        for (size_t i = 0; i < m_counts.size(); ++i)
+            m_counts[i] += other.m_counts[i];
+        m_total += other.m_total;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+        return 0;
+    }
+
+    // record() сдвигает границы к нижним границам интервалов other, точные - восстанавливаются
+    const uint64_t savedMin = m_min, savedMax = m_max;
+    uint64_t skipped = 0;
+    for (size_t i = 0; i < other.m_counts.size(); ++i)
+    {
+        const uint64_t count = other.m_counts[i];
+        if (count != 0 && !record(other.valueAt(i), count))
+            skipped += count;
+    }
+    if (skipped != other.m_total)
+    {
+        m_min = std::min(savedMin, other.m_min);
+        if (other.m_max <= m_highest)
+            m_max = std::max(savedMax, other.m_max);
+    }
+    return skipped;
+}
+
+void MHdrHistogram::reset()
+{
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_total = 0;
+    m_min = ~static_cast<uint64_t>(0);
+    m_max = 0;
+}
+
+double MHdrHistogram::mean() const
+{
+    if (m_total == 0)
+        return 0.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < m_counts.size(); ++i)
+    {
+        if (m_counts[i] != 0)
+        {
+            const uint64_t value = valueAt(i);
+            sum += (value + unitsAt(value) / 2) * static_cast<double>(m_counts[i]);
+        }
+    }
+    return sum / m_total;
+}
+
+double MHdrHistogram::stddev() const
+{
+    if (m_total == 0)
+        return 0.0;
+    const double m = mean();
+    double sum = 0.0;
+    for (size_t i = 0; i < m_counts.size(); ++i)
+    {
+        if (m_counts[i] != 0)
+        {
+            const uint64_t value = valueAt(i);
+            const double d = (value + unitsAt(value) / 2) - m;
+            sum += d * d * static_cast<double>(m_counts[i]);
+        }
+    }
+    return std::sqrt(sum / m_total);
+}
+
+uint64_t MHdrHistogram::valueAtPercentile(double percentile) const
+{
+    if (m_total == 0)
+        return 0;
+    if (percentile <= 0.0)
+        return m_min;
+    percentile = std::min(percentile, 100.0);
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(percentile / 100.0 * m_total + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_counts.size(); ++i)
+    {
+        seen += m_counts[i];
+        if (seen >= target)
+            return std::min(highestEquivalent(valueAt(i)), m_max);
+    }
+    return m_max;
+}
+
+uint64_t MHdrHistogram::countAtValue(uint64_t value) const
+{   return value <= m_highest ? m_counts[index(value)] : 0; }
+
+std::vector<uint8_t> MHdrHistogram::encode() const
+{
+    std::vector<uint8_t> out(cCookie, cCookie + 4);
+    putVarint(out, m_lowest);
+    putVarint(out, m_highest);
+    putVarint(out, static_cast<uint64_t>(m_digits));
+    putVarint(out, (min)());
+    putVarint(out, m_max);
+
+    size_t used = m_counts.size();
+    while (used != 0 && m_counts[used - 1] == 0)
+        --used;
+    putVarint(out, used);
+    for (size_t i = 0; i < used; )
+    {
+        if (m_counts[i] == 0)
+        {
+            size_t run = 1;
+            while (m_counts[i + run] == 0)      // за последним учтенным - ненулевой
+                ++run;
+            putVarint(out, zigzag(-static_cast<int64_t>(run)));
+            i += run;
+        }
+        else
+        {
+            putVarint(out, zigzag(static_cast<int64_t>(m_counts[i])));
+            ++i;
+        }
+    }
+    return out;
+}
+
+bool MHdrHistogram::decode(const uint8_t * data, size_t size, MHdrHistogram & out)
+{
+    const uint8_t * end = data + size;
+    if (size < 4 || !std::equal(cCookie, cCookie + 4, data))
+        return false;
+    data += 4;
+    uint64_t lowest, highest, digits, minValue, maxValue, used;
+    if (!getVarint(data, end, lowest) || !getVarint(data, end, highest) || !getVarint(data, end, digits)
+        || !getVarint(data, end, minValue) || !getVarint(data, end, maxValue) || !getVarint(data, end, used)
+        || digits < 1 || digits > 5)
+        return false;
+
+    MHdrHistogram h(lowest, highest, static_cast<int>(digits));
+    if (h.m_lowest != lowest || h.m_highest != highest || used > h.m_counts.size())
+        return false;
+    for (size_t i = 0; i < used; )
+    {
+        uint64_t raw;
+        if (!getVarint(data, end, raw))
+            return false;
+        const int64_t value = unzigzag(raw);
+        if (value < 0)
+        {
+            const uint64_t run = static_cast<uint64_t>(-value);
+            if (run > used - i)
+                return false;
+            i += static_cast<size_t>(run);
+        }
+        else
+        {
+            h.m_counts[i++] = static_cast<uint64_t>(value);
+            h.m_total += static_cast<uint64_t>(value);
+        }
+    }
+    if (data != end || (h.m_total != 0 && (minValue > maxValue || maxValue > h.m_highest)))
+        return false;
+    if (h.m_total != 0)
+    {
+        h.m_min = minValue;
+        h.m_max = maxValue;
+    }
+    out = h;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+thread_local MHdrRecorder::Slot MHdrRecorder::s_cache[MHdrRecorder::cCacheSlots];
+
+struct MHdrRecorder::ThreadRelease
+{
+    ~ThreadRelease()
+    {
+        if (s_token != 0)
+            s_token->owned.store(false, std::memory_order_release);
+        s_token = released();
+        for (size_t i = 0; i < cCacheSlots; ++i)
+        {
+            s_cache[i].id = 0;
+            s_cache[i].shard = 0;
+        }
+    }
+};
+
+/// Освобожденный признак завершившегося потока или новый
+const void * MHdrRecorder::threadToken()
+{
+    if (s_token != 0)
+        return s_token != released() ? s_token : 0;
+    static thread_local ThreadRelease release;
+    MLIB_UNISED(release);
+
+    for (ThreadToken * t = s_tokens.load(std::memory_order_acquire); t != 0; t = t->next)
+    {
+        bool expected = false;
+        if (t->owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            return s_token = t;
+    }
+    ThreadToken * t = new ThreadToken;
+    t->owned.store(true, std::memory_order_relaxed);
+    t->next = s_tokens.load(std::memory_order_relaxed);
+    while (!s_tokens.compare_exchange_weak(t->next, t, std::memory_order_release, std::memory_order_relaxed))
+        ;
+    return s_token = t;
+}
+
+MHdrRecorder::MHdrRecorder(uint64_t lowest, uint64_t highest, int digits)
+    : m_layout(lowest, highest, digits)
+    , m_length(m_layout.m_counts.size())
+    , m_id(s_recorderIds.fetch_add(1, std::memory_order_relaxed) + 1)
+    , m_shards(0)
+{
+    std::vector<uint64_t>().swap(m_layout.m_counts);
+}
+
+MHdrRecorder::~MHdrRecorder()
+{
+    Shard * s = m_shards.load(std::memory_order_acquire);
+    while (s != 0)
+    {
+        Shard * next = s->next;
+        delete[] s->counts;
+        delete s;
+        s = next;
+    }
+}
+
+MHdrRecorder::Shard * MHdrRecorder::attach()
+{
+    const void * self = threadToken();
+    if (self == 0)
+        return 0;
+    Shard * s = m_shards.load(std::memory_order_acquire);
+    while (s != 0 && s->owner.load(std::memory_order_relaxed) != self)
+        s = s->next;
+    if (s == 0)
+    {
+        s = new Shard;
+        s->counts = new std::atomic<uint64_t>[m_length];
+        for (size_t i = 0; i < m_length; ++i)
+            s->counts[i].store(0, std::memory_order_relaxed);
+        s->min.store(~static_cast<uint64_t>(0), std::memory_order_relaxed);
+        s->max.store(0, std::memory_order_relaxed);
+        s->owner.store(self, std::memory_order_relaxed);
+        s->next = m_shards.load(std::memory_order_relaxed);
+        while (!m_shards.compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+    Slot & slot = s_cache[m_id % cCacheSlots];
+    slot.id = m_id;
+    slot.shard = s;
+    return s;
+}
+
+MHdrHistogram MHdrRecorder::snapshot() const
+{
+    MHdrHistogram h(m_layout.m_lowest, m_layout.m_highest, m_layout.m_digits);
+    for (const Shard * s = m_shards.load(std::memory_order_acquire); s != 0; s = s->next)
+    {
+        for (size_t i = 0; i < m_length; ++i)
+        {
+            const uint64_t count = s->counts[i].load(std::memory_order_relaxed);
+            h.m_counts[i] += count;
+            h.m_total += count;
+        }
+        h.m_min = std::min(h.m_min, s->min.load(std::memory_order_relaxed));
+        h.m_max = std::max(h.m_max, s->max.load(std::memory_order_relaxed));
+    }
+    return h;
+}
+
+void MHdrRecorder::reset()
+{
+    for (Shard * s = m_shards.load(std::memory_order_acquire); s != 0; s = s->next)
+    {
+        for (size_t i = 0; i < m_length; ++i)
+            s->counts[i].store(0, std::memory_order_relaxed);
+        s->min.store(~static_cast<uint64_t>(0), std::memory_order_relaxed);
+        s->max.store(0, std::memory_order_relaxed);
+    }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -21,3 +21,25 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "MMath.h"
 ////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#if MLIB_SUPPORT_CPP11
+// Проверки math::cexpr при компиляции: остатки с частным в тысячи бит (глубина рекурсии)
+// точно совпадают с std::fmod
+static_assert(math::cexpr::fmod(1.7e308, 3.0) == 2.0, "cexpr::fmod");
+static_assert(math::cexpr::fmod(1e308, 1e-308) == 3.498445546245627e-309, "cexpr::fmod");
+static_assert(math::cexpr::fmod(1.2345678912345e300, 0.1) == 0.02368979431364343, "cexpr::fmod");
+static_assert(math::cexpr::fmod(-1.7976931348623157e308, 5e-324) == 0.0, "cexpr::fmod");
+static_assert(math::mod2Pi(1e300) == 5.559758606652565, "mod2Pi");
+static_assert(math::modPi(-1e300) == 0.7234267005270212, "modPi");
+// Большие целые степени - через exp(y ln x), без накопления погрешности умножений
+static_assert(math::cexpr::pow(1.0000001, 1e7) == 2.7182816941320818, "cexpr::pow");
+static_assert(math::cexpr::pow(0.9999999999, 3e9) == 0.7408182022819335, "cexpr::pow");
+static_assert(math::cexpr::pow(1.0000001, 1e15) == std::numeric_limits<double>::infinity(), "cexpr::pow");
+// Сокращение аргумента точно до |x| < 2^30, дальше sin/cos/tan при компиляции не считаются
+static_assert(math::cexpr::sin(1e9) == 0.5458434494486996, "cexpr::sin");
+static_assert(math::cexpr::cos(1e9) == 0.8378871813639024, "cexpr::cos");
+#endif // MLIB_SUPPORT_CPP11
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
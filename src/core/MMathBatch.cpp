@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MMathBatch.cpp
+/// @brief Пакетные (над массивами) версии математических функций MMath.h
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Вычислительные ядра написаны один раз над набором операций Vec (MMathKernels.h): Vec1
+/// (скаляр), SSE2, AVX2, AVX-512F для float и double. Хвост массива обрабатывается тем же
+/// ядром с Vec1, поэтому результат не зависит от положения элемента в массиве и от наличия
+/// SIMD (кроме различий от FMA).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMathBatch.h"
+#include "MMathKernels.h"
+#include "MTypes.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+using namespace detail;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Сокращение радиан
+
+/// Разложение 2ПИ на старшую часть (C1, k * C1 точно) и остаток (C2)
+inline float splitHigh(float value)
+{
+    binary32 f;
+    f.f = value;
+    f.u &= 0xFFFFF000u;
+    return f.f;
+}
+
+inline double splitHigh(double value)
+{
+    binary64 f;
+    f.f = value;
+    f.u &= ~((static_cast<uint64_t>(1) << 27) - 1);
+    return f.f;
+}
+
+inline float reduceLimit(float)   { return 16384.0f; }
+inline double reduceLimit(double) { return 67108864.0; }
+
+template <class Vec, bool Half>
+size_t reduceBlock(const typename Vec::T * in, typename Vec::T * out, size_t begin, size_t count)
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+
+    const T twoPi = c2pi<T>();
+    const T twoPiHigh = splitHigh(twoPi);
+    const V c = Vec::set1(twoPi);
+    const V c1 = Vec::set1(twoPiHigh);
+    const V c2 = Vec::set1(twoPi - twoPiHigh);
+    const V inv = Vec::set1(static_cast<T>(1) / twoPi);
+    const V pi = Vec::set1(cPi<T>());
+    const V negPi = Vec::set1(-cPi<T>());
+    const V zero = Vec::set1(0);
+    const V shift = Vec::set1(Half ? static_cast<T>(0.5) : static_cast<T>(0));
+    const V limit = Vec::set1(reduceLimit(T()));
+
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+    {
+        const V x = Vec::load(in + i);
+        // Вне рабочего диапазона, Inf, NaN - скалярные функции MMath.h
+        if (Vec::any(Vec::nlt(Vec::abs(x), limit)))
+        {
+            for (size_t j = i; j < i + Vec::Width; ++j)
+                out[j] = Half ? modPi(in[j]) : mod2Pi(in[j]);
+            continue;
+        }
+
+        const V k = Vec::floor(Vec::add(Vec::mul(x, inv), shift));
+        V y = Vec::sub(Vec::sub(x, Vec::mul(k, c1)), Vec::mul(k, c2));
+        if (Half)
+        {
+            y = Vec::add(y, Vec::ifThen(Vec::le(y, negPi), c));
+            y = Vec::sub(y, Vec::ifThen(Vec::lt(pi, y), c));
+        }
+        else
+        {
+            y = Vec::add(y, Vec::ifThen(Vec::lt(y, zero), c));
+            y = Vec::sub(y, Vec::ifThen(Vec::le(c, y), c));
+        }
+        Vec::store(out + i, y);
+    }
+    return i;
+}
+
+template <typename T, bool Half>
+inline void reduce(const T * in, T * out, size_t count)
+{
+    const size_t i = reduceBlock<typename VecBest<T>::type, Half>(in, out, 0, count);
+    reduceBlock<Vec1<T>, Half>(in, out, i, count);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Синус и косинус
+
+enum { OutSin = 1, OutCos = 2 };
+
+template <class Vec, int Accuracy, int Out>
+size_t sinCosBlock(const typename Vec::T * in, typename Vec::T * sinOut, typename Vec::T * cosOut,
+                   size_t begin, size_t count)
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+
+    const V limit = Vec::set1(HalfPiSplit<T>::limit());
+
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+    {
+        const V x = Vec::load(in + i);
+        if (Vec::any(Vec::nlt(Vec::abs(x), limit)))
+        {
+            for (size_t j = i; j < i + Vec::Width; ++j)
+            {
+                if (Out & OutSin)
+                    sinOut[j] = std::sin(in[j]);
+                if (Out & OutCos)
+                    cosOut[j] = std::cos(in[j]);
+            }
+            continue;
+        }
+
+        V s, c;
+        sinCosKernel<Vec, Accuracy>(x, s, c);
+        if (Out & OutSin)
+            Vec::store(sinOut + i, s);
+        if (Out & OutCos)
+            Vec::store(cosOut + i, c);
+    }
+    return i;
+}
+
+template <typename T, int Accuracy, int Out>
+inline void sinCosRun(const T * in, T * sinOut, T * cosOut, size_t count)
+{
+    const size_t i = sinCosBlock<typename VecBest<T>::type, Accuracy, Out>(in, sinOut, cosOut, 0, count);
+    sinCosBlock<Vec1<T>, Accuracy, Out>(in, sinOut, cosOut, i, count);
+}
+
+template <typename T, int Out>
+inline void sinCosAny(const T * in, T * sinOut, T * cosOut, size_t count, MathAccuracy accuracy)
+{
+    switch (accuracy)
+    {
+    case AccuracyLow:    sinCosRun<T, AccuracyLow, Out>(in, sinOut, cosOut, count);    break;
+    case AccuracyMedium: sinCosRun<T, AccuracyMedium, Out>(in, sinOut, cosOut, count); break;
+    default:             sinCosRun<T, AccuracyHigh, Out>(in, sinOut, cosOut, count);   break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Арктангенс
+
+template <class Vec, int Accuracy>
+size_t arcTanBlock(const typename Vec::T * y, const typename Vec::T * x, typename Vec::T * out,
+                   size_t begin, size_t count)
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+
+    const V inf = Vec::set1(std::numeric_limits<T>::infinity());
+
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+    {
+        const V vy = Vec::load(y + i);
+        const V vx = Vec::load(x + i);
+        // Inf и NaN - std::atan2
+        if (Vec::any(Vec::or_(Vec::nlt(Vec::abs(vx), inf), Vec::nlt(Vec::abs(vy), inf))))
+        {
+            for (size_t j = i; j < i + Vec::Width; ++j)
+                out[j] = std::atan2(y[j], x[j]);
+            continue;
+        }
+        Vec::store(out + i, arcTanKernel<Vec, Accuracy>(vy, vx));
+    }
+    return i;
+}
+
+template <typename T, int Accuracy>
+inline void arcTanRun(const T * y, const T * x, T * out, size_t count)
+{
+    const size_t i = arcTanBlock<typename VecBest<T>::type, Accuracy>(y, x, out, 0, count);
+    arcTanBlock<Vec1<T>, Accuracy>(y, x, out, i, count);
+}
+
+template <typename T>
+inline void arcTanAny(const T * y, const T * x, T * out, size_t count, MathAccuracy accuracy)
+{
+    switch (accuracy)
+    {
+    case AccuracyLow:    arcTanRun<T, AccuracyLow>(y, x, out, count);    break;
+    case AccuracyMedium: arcTanRun<T, AccuracyMedium>(y, x, out, count); break;
+    default:             arcTanRun<T, AccuracyHigh>(y, x, out, count);   break;
+    }
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void mod2Pi(const float * in, float * out, size_t count)    { reduce<float, false>(in, out, count); }
+void mod2Pi(const double * in, double * out, size_t count)  { reduce<double, false>(in, out, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void modPi(const float * in, float * out, size_t count)     { reduce<float, true>(in, out, count); }
+void modPi(const double * in, double * out, size_t count)   { reduce<double, true>(in, out, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void sin(const float * in, float * out, size_t count, MathAccuracy accuracy)
+{   sinCosAny<float, OutSin>(in, out, 0, count, accuracy); }
+
+void sin(const double * in, double * out, size_t count, MathAccuracy accuracy)
+{   sinCosAny<double, OutSin>(in, out, 0, count, accuracy); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void cos(const float * in, float * out, size_t count, MathAccuracy accuracy)
+{   sinCosAny<float, OutCos>(in, 0, out, count, accuracy); }
+
+void cos(const double * in, double * out, size_t count, MathAccuracy accuracy)
+{   sinCosAny<double, OutCos>(in, 0, out, count, accuracy); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void sinCos(const float * in, float * sinOut, float * cosOut, size_t count, MathAccuracy accuracy)
+{   sinCosAny<float, OutSin | OutCos>(in, sinOut, cosOut, count, accuracy); }
+
+void sinCos(const double * in, double * sinOut, double * cosOut, size_t count, MathAccuracy accuracy)
+{   sinCosAny<double, OutSin | OutCos>(in, sinOut, cosOut, count, accuracy); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void arcTan(const float * y, const float * x, float * out, size_t count, MathAccuracy accuracy)
+{   arcTanAny(y, x, out, count, accuracy); }
+
+void arcTan(const double * y, const double * x, double * out, size_t count, MathAccuracy accuracy)
+{   arcTanAny(y, x, out, count, accuracy); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
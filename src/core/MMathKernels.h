@@ -0,0 +1,561 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MMathKernels.h
+/// @brief Векторные ядра математических функций (внутренний заголовок модуля core)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Наборы операций Vec (Vec1 - скаляр, SSE2, AVX2, AVX-512F для float и double) и ядра
+/// sin/cos/arcTan над регистрами. Используются пакетными функциями MMathBatch.cpp и
+/// геодезическими функциями MGeodesy.cpp; проверка диапазона аргументов - на вызывающей стороне.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef MMATHKERNELS_H
+#define MMATHKERNELS_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMathBatch.h"
+#include <limits>
+#if defined(MLIB_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+#if defined(MLIB_SIMD_SSE41)
+    #include <smmintrin.h>
+#endif
+#if defined(MLIB_SIMD_AVX2) || defined(MLIB_SIMD_AVX512F)
+    #include <immintrin.h>
+#endif
+#if defined(MLIB_SIMD_AVX512F) && defined(MLIB_GCC) && !defined(__clang__) && (__GNUC__ < 13)
+    // Ложные предупреждения о _mm512_undefined_*() в интринсиках AVX-512 (GCC bug 105593)
+    #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+namespace detail {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Наборы операций
+//
+// V - вектор значений, M - маска дорожек (результат сравнения).
+// nlt(a, b) - "не меньше", истинно и для NaN. fmadd(a, b, c) = a * b + c.
+// ifThen(m, a) = m ? a : 0, negIf(m, a) = m ? -a : a, signbit(a) - маска отрицательных (с учетом -0).
+
+template <typename Ty>
+struct Vec1
+{
+    typedef Ty T;
+    typedef Ty V;
+    typedef bool M;
+    enum { Width = 1 };
+
+    static inline V set1(T a)                   { return a; }
+    static inline V load(const T * p)           { return *p; }
+    static inline void store(T * p, V a)        { *p = a; }
+    static inline V add(V a, V b)               { return a + b; }
+    static inline V sub(V a, V b)               { return a - b; }
+    static inline V mul(V a, V b)               { return a * b; }
+    static inline V div(V a, V b)               { return a / b; }
+    static inline V fmadd(V a, V b, V c)        { return a * b + c; }
+    static inline V min(V a, V b)               { return a < b ? a : b; }
+    static inline V max(V a, V b)               { return a > b ? a : b; }
+    static inline V abs(V a)                    { return std::fabs(a); }
+    static inline V sqrt(V a)                   { return std::sqrt(a); }
+    static inline V floor(V a)                  { return std::floor(a); }
+    static inline M lt(V a, V b)                { return a < b; }
+    static inline M le(V a, V b)                { return a <= b; }
+    static inline M eq(V a, V b)                { return a == b; }
+    static inline M nlt(V a, V b)               { return !(a < b); }
+    static inline M or_(M a, M b)               { return a || b; }
+    static inline bool any(M a)                 { return a; }
+    static inline V ifThen(M m, V a)            { return m ? a : static_cast<T>(0); }
+    static inline V select(M m, V a, V b)       { return m ? a : b; }
+    static inline V negIf(M m, V a)             { return m ? -a : a; }
+    static inline M signbit(V a)                { return std::signbit(a); }
+};
+
+#if defined(MLIB_SIMD_AVX512F)
+struct VecF
+{
+    typedef float T;
+    typedef __m512 V;
+    typedef __mmask16 M;
+    enum { Width = 16 };
+
+    static inline V set1(T a)                   { return _mm512_set1_ps(a); }
+    static inline V load(const T * p)           { return _mm512_loadu_ps(p); }
+    static inline void store(T * p, V a)        { _mm512_storeu_ps(p, a); }
+    static inline V add(V a, V b)               { return _mm512_add_ps(a, b); }
+    static inline V sub(V a, V b)               { return _mm512_sub_ps(a, b); }
+    static inline V mul(V a, V b)               { return _mm512_mul_ps(a, b); }
+    static inline V div(V a, V b)               { return _mm512_div_ps(a, b); }
+    static inline V fmadd(V a, V b, V c)        { return _mm512_fmadd_ps(a, b, c); }
+    static inline V min(V a, V b)               { return _mm512_min_ps(a, b); }
+    static inline V max(V a, V b)               { return _mm512_max_ps(a, b); }
+    static inline V abs(V a)                    { return _mm512_abs_ps(a); }
+    static inline V sqrt(V a)                   { return _mm512_sqrt_ps(a); }
+    static inline V floor(V a)                  { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+    static inline M lt(V a, V b)                { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static inline M le(V a, V b)                { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+    static inline M eq(V a, V b)                { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static inline M nlt(V a, V b)               { return _mm512_cmp_ps_mask(a, b, _CMP_NLT_UQ); }
+    static inline M or_(M a, M b)               { return static_cast<M>(a | b); }
+    static inline bool any(M a)                 { return a != 0; }
+    static inline V ifThen(M m, V a)            { return _mm512_maskz_mov_ps(m, a); }
+    static inline V select(M m, V a, V b)       { return _mm512_mask_blend_ps(m, b, a); }
+    static inline V negIf(M m, V a)
+    {
+        const __m512i s = _mm512_maskz_mov_epi32(m, _mm512_set1_epi32(static_cast<int>(0x80000000u)));
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), s));
+    }
+    static inline M signbit(V a)                { return _mm512_cmplt_epi32_mask(_mm512_castps_si512(a), _mm512_setzero_si512()); }
+};
+
+struct VecD
+{
+    typedef double T;
+    typedef __m512d V;
+    typedef __mmask8 M;
+    enum { Width = 8 };
+
+    static inline V set1(T a)                   { return _mm512_set1_pd(a); }
+    static inline V load(const T * p)           { return _mm512_loadu_pd(p); }
+    static inline void store(T * p, V a)        { _mm512_storeu_pd(p, a); }
+    static inline V add(V a, V b)               { return _mm512_add_pd(a, b); }
+    static inline V sub(V a, V b)               { return _mm512_sub_pd(a, b); }
+    static inline V mul(V a, V b)               { return _mm512_mul_pd(a, b); }
+    static inline V div(V a, V b)               { return _mm512_div_pd(a, b); }
+    static inline V fmadd(V a, V b, V c)        { return _mm512_fmadd_pd(a, b, c); }
+    static inline V min(V a, V b)               { return _mm512_min_pd(a, b); }
+    static inline V max(V a, V b)               { return _mm512_max_pd(a, b); }
+    static inline V abs(V a)                    { return _mm512_abs_pd(a); }
+    static inline V sqrt(V a)                   { return _mm512_sqrt_pd(a); }
+    static inline V floor(V a)                  { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+    static inline M lt(V a, V b)                { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static inline M le(V a, V b)                { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static inline M eq(V a, V b)                { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static inline M nlt(V a, V b)               { return _mm512_cmp_pd_mask(a, b, _CMP_NLT_UQ); }
+    static inline M or_(M a, M b)               { return static_cast<M>(a | b); }
+    static inline bool any(M a)                 { return a != 0; }
+    static inline V ifThen(M m, V a)            { return _mm512_maskz_mov_pd(m, a); }
+    static inline V select(M m, V a, V b)       { return _mm512_mask_blend_pd(m, b, a); }
+    static inline V negIf(M m, V a)
+    {
+        const __m512i s = _mm512_maskz_mov_epi64(m, _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull)));
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), s));
+    }
+    static inline M signbit(V a)                { return _mm512_cmplt_epi64_mask(_mm512_castpd_si512(a), _mm512_setzero_si512()); }
+};
+#elif defined(MLIB_SIMD_AVX2)
+struct VecF
+{
+    typedef float T;
+    typedef __m256 V;
+    typedef __m256 M;
+    enum { Width = 8 };
+
+    static inline V set1(T a)                   { return _mm256_set1_ps(a); }
+    static inline V load(const T * p)           { return _mm256_loadu_ps(p); }
+    static inline void store(T * p, V a)        { _mm256_storeu_ps(p, a); }
+    static inline V add(V a, V b)               { return _mm256_add_ps(a, b); }
+    static inline V sub(V a, V b)               { return _mm256_sub_ps(a, b); }
+    static inline V mul(V a, V b)               { return _mm256_mul_ps(a, b); }
+    static inline V div(V a, V b)               { return _mm256_div_ps(a, b); }
+    static inline V fmadd(V a, V b, V c)
+    {
+    #if defined(MLIB_SIMD_FMA)
+        return _mm256_fmadd_ps(a, b, c);
+    #else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+    #endif
+    }
+    static inline V min(V a, V b)               { return _mm256_min_ps(a, b); }
+    static inline V max(V a, V b)               { return _mm256_max_ps(a, b); }
+    static inline V abs(V a)                    { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static inline V sqrt(V a)                   { return _mm256_sqrt_ps(a); }
+    static inline V floor(V a)                  { return _mm256_floor_ps(a); }
+    static inline M lt(V a, V b)                { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline M le(V a, V b)                { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static inline M eq(V a, V b)                { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static inline M nlt(V a, V b)               { return _mm256_cmp_ps(a, b, _CMP_NLT_UQ); }
+    static inline M or_(M a, M b)               { return _mm256_or_ps(a, b); }
+    static inline bool any(M a)                 { return _mm256_movemask_ps(a) != 0; }
+    static inline V ifThen(M m, V a)            { return _mm256_and_ps(m, a); }
+    static inline V select(M m, V a, V b)       { return _mm256_blendv_ps(b, a, m); }
+    static inline V negIf(M m, V a)             { return _mm256_xor_ps(a, _mm256_and_ps(m, _mm256_set1_ps(-0.0f))); }
+    static inline M signbit(V a)                { return _mm256_castsi256_ps(_mm256_srai_epi32(_mm256_castps_si256(a), 31)); }
+};
+
+struct VecD
+{
+    typedef double T;
+    typedef __m256d V;
+    typedef __m256d M;
+    enum { Width = 4 };
+
+    static inline V set1(T a)                   { return _mm256_set1_pd(a); }
+    static inline V load(const T * p)           { return _mm256_loadu_pd(p); }
+    static inline void store(T * p, V a)        { _mm256_storeu_pd(p, a); }
+    static inline V add(V a, V b)               { return _mm256_add_pd(a, b); }
+    static inline V sub(V a, V b)               { return _mm256_sub_pd(a, b); }
+    static inline V mul(V a, V b)               { return _mm256_mul_pd(a, b); }
+    static inline V div(V a, V b)               { return _mm256_div_pd(a, b); }
+    static inline V fmadd(V a, V b, V c)
+    {
+    #if defined(MLIB_SIMD_FMA)
+        return _mm256_fmadd_pd(a, b, c);
+    #else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+    #endif
+    }
+    static inline V min(V a, V b)               { return _mm256_min_pd(a, b); }
+    static inline V max(V a, V b)               { return _mm256_max_pd(a, b); }
+    static inline V abs(V a)                    { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static inline V sqrt(V a)                   { return _mm256_sqrt_pd(a); }
+    static inline V floor(V a)                  { return _mm256_floor_pd(a); }
+    static inline M lt(V a, V b)                { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static inline M le(V a, V b)                { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static inline M eq(V a, V b)                { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static inline M nlt(V a, V b)               { return _mm256_cmp_pd(a, b, _CMP_NLT_UQ); }
+    static inline M or_(M a, M b)               { return _mm256_or_pd(a, b); }
+    static inline bool any(M a)                 { return _mm256_movemask_pd(a) != 0; }
+    static inline V ifThen(M m, V a)            { return _mm256_and_pd(m, a); }
+    static inline V select(M m, V a, V b)       { return _mm256_blendv_pd(b, a, m); }
+    static inline V negIf(M m, V a)             { return _mm256_xor_pd(a, _mm256_and_pd(m, _mm256_set1_pd(-0.0))); }
+    static inline M signbit(V a)
+    {   return _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_setzero_si256(), _mm256_castpd_si256(a))); }
+};
+#elif defined(MLIB_SIMD_SSE2)
+struct VecF
+{
+    typedef float T;
+    typedef __m128 V;
+    typedef __m128 M;
+    enum { Width = 4 };
+
+    static inline V set1(T a)                   { return _mm_set1_ps(a); }
+    static inline V load(const T * p)           { return _mm_loadu_ps(p); }
+    static inline void store(T * p, V a)        { _mm_storeu_ps(p, a); }
+    static inline V add(V a, V b)               { return _mm_add_ps(a, b); }
+    static inline V sub(V a, V b)               { return _mm_sub_ps(a, b); }
+    static inline V mul(V a, V b)               { return _mm_mul_ps(a, b); }
+    static inline V div(V a, V b)               { return _mm_div_ps(a, b); }
+    static inline V fmadd(V a, V b, V c)        { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static inline V min(V a, V b)               { return _mm_min_ps(a, b); }
+    static inline V max(V a, V b)               { return _mm_max_ps(a, b); }
+    static inline V abs(V a)                    { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static inline V sqrt(V a)                   { return _mm_sqrt_ps(a); }
+    static inline M lt(V a, V b)                { return _mm_cmplt_ps(a, b); }
+    static inline M le(V a, V b)                { return _mm_cmple_ps(a, b); }
+    static inline M eq(V a, V b)                { return _mm_cmpeq_ps(a, b); }
+    static inline M nlt(V a, V b)               { return _mm_cmpnlt_ps(a, b); }
+    static inline M or_(M a, M b)               { return _mm_or_ps(a, b); }
+    static inline bool any(M a)                 { return _mm_movemask_ps(a) != 0; }
+    static inline V ifThen(M m, V a)            { return _mm_and_ps(m, a); }
+    static inline V select(M m, V a, V b)       { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static inline V negIf(M m, V a)             { return _mm_xor_ps(a, _mm_and_ps(m, _mm_set1_ps(-0.0f))); }
+    static inline M signbit(V a)                { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(a), 31)); }
+
+    /// Округление вниз (для значений, представимых int32)
+    static inline V floor(V a)
+    {
+    #if defined(MLIB_SIMD_SSE41)
+        return _mm_floor_ps(a);
+    #else
+        const V t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+    #endif
+    }
+};
+
+struct VecD
+{
+    typedef double T;
+    typedef __m128d V;
+    typedef __m128d M;
+    enum { Width = 2 };
+
+    static inline V set1(T a)                   { return _mm_set1_pd(a); }
+    static inline V load(const T * p)           { return _mm_loadu_pd(p); }
+    static inline void store(T * p, V a)        { _mm_storeu_pd(p, a); }
+    static inline V add(V a, V b)               { return _mm_add_pd(a, b); }
+    static inline V sub(V a, V b)               { return _mm_sub_pd(a, b); }
+    static inline V mul(V a, V b)               { return _mm_mul_pd(a, b); }
+    static inline V div(V a, V b)               { return _mm_div_pd(a, b); }
+    static inline V fmadd(V a, V b, V c)        { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static inline V min(V a, V b)               { return _mm_min_pd(a, b); }
+    static inline V max(V a, V b)               { return _mm_max_pd(a, b); }
+    static inline V abs(V a)                    { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static inline V sqrt(V a)                   { return _mm_sqrt_pd(a); }
+    static inline M lt(V a, V b)                { return _mm_cmplt_pd(a, b); }
+    static inline M le(V a, V b)                { return _mm_cmple_pd(a, b); }
+    static inline M eq(V a, V b)                { return _mm_cmpeq_pd(a, b); }
+    static inline M nlt(V a, V b)               { return _mm_cmpnlt_pd(a, b); }
+    static inline M or_(M a, M b)               { return _mm_or_pd(a, b); }
+    static inline bool any(M a)                 { return _mm_movemask_pd(a) != 0; }
+    static inline V ifThen(M m, V a)            { return _mm_and_pd(m, a); }
+    static inline V select(M m, V a, V b)       { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static inline V negIf(M m, V a)             { return _mm_xor_pd(a, _mm_and_pd(m, _mm_set1_pd(-0.0))); }
+    static inline M signbit(V a)
+    {
+        const __m128i s = _mm_srai_epi32(_mm_castpd_si128(a), 31);
+        return _mm_castsi128_pd(_mm_shuffle_epi32(s, _MM_SHUFFLE(3, 3, 1, 1)));
+    }
+
+    static inline V floor(V a)
+    {
+    #if defined(MLIB_SIMD_SSE41)
+        return _mm_floor_pd(a);
+    #else
+        const V t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(a));
+        return _mm_sub_pd(t, _mm_and_pd(_mm_cmpgt_pd(t, a), _mm_set1_pd(1.0)));
+    #endif
+    }
+};
+#endif
+
+/// Лучший доступный набор операций для типа T
+#if defined(MLIB_SIMD_SSE2)
+template <typename T> struct VecBest;
+template <> struct VecBest<float>  { typedef VecF type; };
+template <> struct VecBest<double> { typedef VecD type; };
+#else
+template <typename T> struct VecBest { typedef Vec1<T> type; };
+#endif
+
+/// Вычисление полинома по схеме Горнера (коэффициенты от старшего к младшему)
+template <class Vec, int N>
+inline typename Vec::V horner(typename Vec::V z, const typename Vec::T * c)
+{
+    typename Vec::V p = Vec::set1(c[0]);
+    for (int i = 1; i < N; ++i)
+        p = Vec::fmadd(p, z, Vec::set1(c[i]));
+    return p;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Синус и косинус
+//
+// x = j * ПИ/2 + r, |r| <= ПИ/4 (ПИ/2 разложено на три части, Cody-Waite),
+// sin(r) = r + r * z * S(z), cos(r) = 1 + z * C(z), z = r^2, выбор и знак - по четверти j.
+
+/// Коэффициенты полиномов S и C
+template <typename T, int Accuracy> struct SinCosCoef;
+
+template <typename T> struct SinCosCoef<T, AccuracyLow>
+{
+    enum { NS = 2, NC = 2 };
+    static const T * s() { static const T c[NS] = { 8.15298479947318e-3, -1.6662833480231962e-1 }; return c; }
+    static const T * c() { static const T c[NC] = { 4.0488883915985235e-2, -4.997762873834717e-1 }; return c; }
+};
+
+template <typename T> struct SinCosCoef<T, AccuracyMedium>
+{
+    enum { NS = 2, NC = 3 };
+    static const T * s() { return SinCosCoef<T, AccuracyLow>::s(); }
+    static const T * c() { static const T c[NC] = { -1.3597814333500978e-3, 4.165629396042996e-2, -4.9999894772182557e-1 }; return c; }
+};
+
+template <> struct SinCosCoef<float, AccuracyHigh>
+{
+    enum { NS = 3, NC = 4 };
+    static const float * s() { static const float c[NS] = { -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f }; return c; }
+    static const float * c() { static const float c[NC] = { 2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f, -0.5f }; return c; }
+};
+
+template <> struct SinCosCoef<double, AccuracyHigh>
+{
+    enum { NS = 6, NC = 7 };
+    static const double * s()
+    {
+        static const double c[NS] = { 1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+                                      -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1 };
+        return c;
+    }
+    static const double * c()
+    {
+        static const double c[NC] = { -1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+                                      2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2, -0.5 };
+        return c;
+    }
+};
+
+/// Разложение ПИ/2 и граница рабочего диапазона
+template <typename T> struct HalfPiSplit;
+template <> struct HalfPiSplit<float>
+{
+    static float p1()    { return 1.5703125f; }
+    static float p2()    { return 4.837512969970703125e-4f; }
+    static float p3()    { return 7.54978995489188216e-8f; }
+    static float limit() { return 8192.0f; }
+};
+template <> struct HalfPiSplit<double>
+{
+    static double p1()    { return 1.57079625129699707031e0; }
+    static double p2()    { return 7.54978941586159635335e-8; }
+    static double p3()    { return 5.39030285815811905290e-15; }
+    static double limit() { return 67108864.0; }
+};
+
+/// sin и cos x, |x| < HalfPiSplit<T>::limit()
+template <class Vec, int Accuracy>
+inline void sinCosKernel(typename Vec::V x, typename Vec::V & sinOut, typename Vec::V & cosOut)
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+    typedef typename Vec::M M;
+    typedef SinCosCoef<T, Accuracy> Coef;
+    typedef HalfPiSplit<T> Split;
+
+    const V half = Vec::set1(static_cast<T>(0.5));
+
+    const V j = Vec::floor(Vec::fmadd(x, Vec::set1(static_cast<T>(1) / cHalfPi<T>()), half));
+    const V r = Vec::sub(Vec::sub(Vec::sub(x, Vec::mul(j, Vec::set1(Split::p1()))),
+                                  Vec::mul(j, Vec::set1(Split::p2()))),
+                         Vec::mul(j, Vec::set1(Split::p3())));
+    const V z = Vec::mul(r, r);
+
+    const V s = Vec::fmadd(Vec::mul(r, z), horner<Vec, Coef::NS>(z, Coef::s()), r);
+    const V c = Vec::fmadd(z, horner<Vec, Coef::NC>(z, Coef::c()), Vec::set1(1));
+
+    // Четверть: q = j mod 4, нечетная - sin и cos меняются местами
+    const V jh = Vec::mul(j, half);
+    const M odd = Vec::lt(Vec::floor(jh), jh);
+    const V q = Vec::sub(j, Vec::mul(Vec::set1(4), Vec::floor(Vec::mul(j, Vec::set1(static_cast<T>(0.25))))));
+
+    sinOut = Vec::negIf(Vec::le(Vec::set1(2), q), Vec::select(odd, c, s));
+    cosOut = Vec::negIf(Vec::eq(Vec::abs(Vec::sub(q, Vec::set1(static_cast<T>(1.5)))), half),
+                        Vec::select(odd, s, c));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Арктангенс
+//
+// a = min(|x|, |y|) / max(|x|, |y|) в [0, 1], atan(a) по полиному, затем восстановление
+// октанта: ПИ/2 - r, ПИ - r, знак y.
+// Low/Medium: нечетный полином от a на [0, 1].
+// High: при a > tan(ПИ/8) (0.66 для double) t = (a - 1) / (a + 1), atan(a) = ПИ/4 + atan(t);
+// float - полином, double - дробно-рациональная функция (Cephes).
+
+template <typename T, int Accuracy> struct AtanCoef;
+
+template <typename T> struct AtanCoef<T, AccuracyLow>
+{
+    enum { N = 4 };
+    static const T * p()
+    {
+        static const T c[N] = { -3.8985320362845924e-2, 1.4626273490040995e-1, -3.2117429615759097e-1, 9.99213756046242e-1 };
+        return c;
+    }
+};
+
+template <typename T> struct AtanCoef<T, AccuracyMedium>
+{
+    enum { N = 6 };
+    static const T * p()
+    {
+        static const T c[N] = { -1.171877503855074e-2, 5.2646473884098356e-2, -1.1642572351918881e-1,
+                                1.935401000130241e-1, -3.3262278985230526e-1, 9.999772179177244e-1 };
+        return c;
+    }
+};
+
+template <class Vec, int Accuracy>
+struct AtanCore
+{
+    typedef typename Vec::V V;
+
+    /// atan(a), a в [0, 1]
+    static inline V eval(V a)
+    {
+        typedef AtanCoef<typename Vec::T, Accuracy> Coef;
+        return Vec::mul(a, horner<Vec, Coef::N>(Vec::mul(a, a), Coef::p()));
+    }
+};
+
+template <class Vec, bool IsFloat = sizeof(typename Vec::T) == sizeof(float)>
+struct AtanHigh;
+
+template <class Vec>
+struct AtanHigh<Vec, true>
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+
+    static inline V eval(V a)
+    {
+        static const T c[4] = { 8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f };
+        const typename Vec::M big = Vec::lt(Vec::set1(static_cast<T>(0.4142135623730950)), a);
+        const V one = Vec::set1(1);
+        const V t = Vec::select(big, Vec::div(Vec::sub(a, one), Vec::add(a, one)), a);
+        const V z = Vec::mul(t, t);
+        const V r = Vec::fmadd(Vec::mul(t, z), horner<Vec, 4>(z, c), t);
+        return Vec::add(r, Vec::ifThen(big, Vec::set1(static_cast<T>(0.78539816339744830962))));
+    }
+};
+
+template <class Vec>
+struct AtanHigh<Vec, false>
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+
+    static inline V eval(V a)
+    {
+        static const T p[5] = { -8.750608600031904122785e-1, -1.615753718733365076637e1, -7.500855792314704667340e1,
+                                -1.228866684490136173410e2, -6.485021904942025371773e1 };
+        static const T q[6] = { 1.0, 2.485846490142306297962e1, 1.650270098316988542046e2,
+                                4.328810604912902668951e2, 4.853903996359136964868e2, 1.945506571482613964425e2 };
+        const typename Vec::M big = Vec::lt(Vec::set1(static_cast<T>(0.66)), a);
+        const V one = Vec::set1(1);
+        const V t = Vec::select(big, Vec::div(Vec::sub(a, one), Vec::add(a, one)), a);
+        const V z = Vec::mul(t, t);
+        const V w = Vec::div(Vec::mul(z, horner<Vec, 5>(z, p)), horner<Vec, 6>(z, q));
+        const V r = Vec::fmadd(t, w, t);
+        // ПИ/4 с поправкой младших разрядов
+        return Vec::add(r, Vec::ifThen(big, Vec::add(Vec::set1(static_cast<T>(0.78539816339744830962)),
+                                                     Vec::set1(static_cast<T>(3.061616997868382943065e-17)))));
+    }
+};
+
+template <class Vec>
+struct AtanCore<Vec, AccuracyHigh> : public AtanHigh<Vec>
+{};
+
+/// atan2(y, x) для конечных x, y
+template <class Vec, int Accuracy>
+inline typename Vec::V arcTanKernel(typename Vec::V y, typename Vec::V x)
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+
+    const V ax = Vec::abs(x);
+    const V ay = Vec::abs(y);
+    const V hi = Vec::max(ax, ay);
+    const V lo = Vec::min(ax, ay);
+    const V a = Vec::div(lo, Vec::select(Vec::eq(hi, Vec::set1(0)), Vec::set1(1), hi));
+
+    V r = AtanCore<Vec, Accuracy>::eval(a);
+    r = Vec::select(Vec::lt(ax, ay), Vec::sub(Vec::set1(cHalfPi<T>()), r), r);
+    r = Vec::select(Vec::signbit(x), Vec::sub(Vec::set1(cPi<T>()), r), r);
+    return Vec::negIf(Vec::signbit(y), r);
+}
+
+} // namespace detail
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#endif // MMATHKERNELS_H
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MMatrix.cpp
+/// @brief Пакетное умножение матрицы на массивы точек (SoA)
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Матрица приводится к строкам аффинного вида (до 4 строк по 4 элемента, недостающие -
+/// нули), элементы размножаются по регистрам до цикла. Один шаг цикла - Width точек:
+/// загрузка координат, по одной цепочке FMA на координату результата, сохранение.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MMatrix.h"
+#include "MMathKernels.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+using namespace detail;
+
+/// Коэффициенты преобразования: out_i = a[i][0] x + a[i][1] y + a[i][2] z + a[i][3]
+template <typename T>
+struct Affine
+{
+    T a[4][4];
+    bool projective;    ///< Делить ли на 4-ю строку (w)
+};
+
+template <class Vec>
+size_t transformBlock2(const Affine<typename Vec::T> & m, const typename Vec::T * x, const typename Vec::T * y,
+                       typename Vec::T * ox, typename Vec::T * oy, size_t begin, size_t count)
+{
+    typedef typename Vec::V V;
+
+    const V m00 = Vec::set1(m.a[0][0]), m01 = Vec::set1(m.a[0][1]);
+    const V m10 = Vec::set1(m.a[1][0]), m11 = Vec::set1(m.a[1][1]);
+
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+    {
+        const V vx = Vec::load(x + i);
+        const V vy = Vec::load(y + i);
+        Vec::store(ox + i, Vec::fmadd(m00, vx, Vec::mul(m01, vy)));
+        Vec::store(oy + i, Vec::fmadd(m10, vx, Vec::mul(m11, vy)));
+    }
+    return i;
+}
+
+template <class Vec, bool Projective>
+size_t transformBlock3(const Affine<typename Vec::T> & m,
+                       const typename Vec::T * x, const typename Vec::T * y, const typename Vec::T * z,
+                       typename Vec::T * ox, typename Vec::T * oy, typename Vec::T * oz,
+                       size_t begin, size_t count)
+{
+    typedef typename Vec::V V;
+
+    V c[4][4];
+    for (int r = 0; r < 4; ++r)
+        for (int k = 0; k < 4; ++k)
+            c[r][k] = Vec::set1(m.a[r][k]);
+    const V one = Vec::set1(1);
+
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+    {
+        const V vx = Vec::load(x + i);
+        const V vy = Vec::load(y + i);
+        const V vz = Vec::load(z + i);
+        V r[3];
+        for (int k = 0; k < 3; ++k)
+            r[k] = Vec::fmadd(c[k][0], vx, Vec::fmadd(c[k][1], vy, Vec::fmadd(c[k][2], vz, c[k][3])));
+        if (Projective)
+        {
+            const V w = Vec::fmadd(c[3][0], vx, Vec::fmadd(c[3][1], vy, Vec::fmadd(c[3][2], vz, c[3][3])));
+            const V rw = Vec::div(one, w);
+            for (int k = 0; k < 3; ++k)
+                r[k] = Vec::mul(r[k], rw);
+        }
+        Vec::store(ox + i, r[0]);
+        Vec::store(oy + i, r[1]);
+        Vec::store(oz + i, r[2]);
+    }
+    return i;
+}
+
+template <typename T>
+inline void transform2(const Affine<T> & m, const T * x, const T * y, T * ox, T * oy, size_t count)
+{
+    const size_t i = transformBlock2<typename VecBest<T>::type>(m, x, y, ox, oy, 0, count);
+    transformBlock2<Vec1<T> >(m, x, y, ox, oy, i, count);
+}
+
+template <typename T>
+inline void transform3(const Affine<T> & m, const T * x, const T * y, const T * z,
+                       T * ox, T * oy, T * oz, size_t count)
+{
+    if (m.projective)
+    {
+        const size_t i = transformBlock3<typename VecBest<T>::type, true>(m, x, y, z, ox, oy, oz, 0, count);
+        transformBlock3<Vec1<T>, true>(m, x, y, z, ox, oy, oz, i, count);
+    }
+    else
+    {
+        const size_t i = transformBlock3<typename VecBest<T>::type, false>(m, x, y, z, ox, oy, oz, 0, count);
+        transformBlock3<Vec1<T>, false>(m, x, y, z, ox, oy, oz, i, count);
+    }
+}
+
+template <typename T>
+inline Affine<T> affine(const MMat2<T> & m)
+{
+    Affine<T> r = {};
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j)
+            r.a[i][j] = m(i, j);
+    return r;
+}
+
+template <typename T>
+inline Affine<T> affine(const MMat3<T> & m, const MVec3<T> & t)
+{
+    Affine<T> r = {};
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+            r.a[i][j] = m(i, j);
+        r.a[i][3] = t[i];
+    }
+    r.a[3][3] = 1;
+    return r;
+}
+
+template <typename T>
+inline Affine<T> affine(const MMat4<T> & m)
+{
+    Affine<T> r = {};
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            r.a[i][j] = m(i, j);
+    r.projective = !m.isAffine();
+    return r;
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void transform(const MMat2<float> & m, const float * x, const float * y,
+               float * ox, float * oy, size_t count)
+{   transform2(affine(m), x, y, ox, oy, count); }
+
+void transform(const MMat2<double> & m, const double * x, const double * y,
+               double * ox, double * oy, size_t count)
+{   transform2(affine(m), x, y, ox, oy, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void transform(const MMat3<float> & m, const float * x, const float * y, const float * z,
+               float * ox, float * oy, float * oz, size_t count)
+{   transform3(affine(m, MVec3<float>()), x, y, z, ox, oy, oz, count); }
+
+void transform(const MMat3<double> & m, const double * x, const double * y, const double * z,
+               double * ox, double * oy, double * oz, size_t count)
+{   transform3(affine(m, MVec3<double>()), x, y, z, ox, oy, oz, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void transform(const MMat3<float> & m, const MVec3<float> & t,
+               const float * x, const float * y, const float * z,
+               float * ox, float * oy, float * oz, size_t count)
+{   transform3(affine(m, t), x, y, z, ox, oy, oz, count); }
+
+void transform(const MMat3<double> & m, const MVec3<double> & t,
+               const double * x, const double * y, const double * z,
+               double * ox, double * oy, double * oz, size_t count)
+{   transform3(affine(m, t), x, y, z, ox, oy, oz, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void transform(const MMat4<float> & m, const float * x, const float * y, const float * z,
+               float * ox, float * oy, float * oz, size_t count)
+{   transform3(affine(m), x, y, z, ox, oy, oz, count); }
+
+void transform(const MMat4<double> & m, const double * x, const double * y, const double * z,
+               double * ox, double * oy, double * oz, size_t count)
+{   transform3(affine(m), x, y, z, ox, oy, oz, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MProfiler.cpp
+/// @brief Профилировщик зон кода с деревом вызовов
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Узлы дерева потока не перемещаются и не удаляются. Новый узел полностью заполняется
+/// и только затем публикуется (release) в начале списка вложенных узлов родителя, поэтому
+/// отчет (acquire) видит либо старый список, либо новый с готовым узлом. Итоги узла
+/// пишет только поток-владелец, отдельными атомарными словами без read-modify-write.
+///
+/// Деревья завершившихся потоков остаются в списке (их итоги попадают в отчет) и
+/// передаются новым потокам, поэтому пул с пересоздаваемыми потоками не накапливает память.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MProfiler.h"
+#include "MTscTimeMeter.h"
+#include <algorithm>
+#include <cstdio>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace profiler {
+namespace detail {
+
+std::atomic<bool> enabled(true);
+
+struct Node
+{
+    const MProfileSite * site;
+    Node * parent;
+    std::atomic<Node *> child;          ///< Первый вложенный узел
+    std::atomic<Node *> sibling;        ///< Следующий узел того же родителя
+    uint64_t start;                     ///< Отсчет входа (узел не бывает открыт дважды)
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> total;        ///< Такты
+    std::atomic<uint64_t> min;
+    std::atomic<uint64_t> max;
+
+    void clear()
+    {
+        count.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        min.store(~static_cast<uint64_t>(0), std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    }
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::Node;
+
+/// Узлов в блоке памяти дерева
+const size_t cChunkNodes = 64;
+
+/// Дерево вызовов одного потока
+struct ThreadTree
+{
+    Node root;                          ///< Фиктивный корень, внешние зоны - его вложенные узлы
+    Node * current;                     ///< Открытая зона (или корень)
+    std::vector<Node *> chunks;         ///< Блоки узлов, используются только владельцем
+    size_t used;                        ///< Занято узлов в последнем блоке
+    bool hardware;                      ///< Отсчеты - TSC, иначе steady_clock
+    std::atomic<bool> owned;            ///< Дерево принадлежит работающему потоку
+    ThreadTree * next;                  ///< Список всех деревьев
+
+    ThreadTree() : current(&root), used(cChunkNodes), hardware(tsc::calibration().hardware),
+                   owned(true), next(0)
+    {
+        root.site = 0;
+        root.parent = 0;
+        root.child.store(0, std::memory_order_relaxed);
+        root.sibling.store(0, std::memory_order_relaxed);
+        root.start = 0;
+        root.clear();
+    }
+
+    Node * create(Node * parent, const MProfileSite & site)
+    {
+        if (used == cChunkNodes)
+        {
+            chunks.push_back(new Node[cChunkNodes]);
+            used = 0;
+        }
+        Node * n = chunks.back() + used++;
+        n->site = &site;
+        n->parent = parent;
+        n->child.store(0, std::memory_order_relaxed);
+        n->sibling.store(parent->child.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        n->start = 0;
+        n->clear();
+        parent->child.store(n, std::memory_order_release);
+        return n;
+    }
+};
+
+std::atomic<ThreadTree *> s_trees(0);
+thread_local ThreadTree * s_tree = 0;
+
+/// Метка s_tree после возврата дерева: зоны, открытые позже в деструкторах thread_local
+/// объектов, не учитываются (дерево может уже принадлежать другому потоку)
+char s_releasedTag;
+
+inline ThreadTree * released()
+{   return reinterpret_cast<ThreadTree *>(&s_releasedTag); }
+
+/// Возврат дерева в общий список при завершении потока
+struct TreeRelease
+{
+    ~TreeRelease()
+    {
+        if (s_tree != 0)
+        {
+            s_tree->current = &s_tree->root;
+            s_tree->owned.store(false, std::memory_order_release);
+        }
+        s_tree = released();
+    }
+};
+
+/// Дерево для текущего потока: свободное дерево завершившегося потока или новое
+ThreadTree * attach()
+{
+    static thread_local TreeRelease release;
+    MLIB_UNISED(release);
+
+    for (ThreadTree * t = s_trees.load(std::memory_order_acquire); t != 0; t = t->next)
+    {
+        bool expected = false;
+        if (t->owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            return s_tree = t;
+    }
+    ThreadTree * t = new ThreadTree;
+    t->next = s_trees.load(std::memory_order_relaxed);
+    while (!s_trees.compare_exchange_weak(t->next, t, std::memory_order_release, std::memory_order_relaxed))
+        ;
+    return s_tree = t;
+}
+
+MLIB_FORCE_INLINE uint64_t stamp(bool hardware)
+{   return hardware ? tsc::read() : tsc::clockNsecs(); }
+
+/// Узел объединенного дерева
+struct Aggregate
+{
+    const MProfileSite * site;
+    uint64_t count, total, min, max;
+    std::vector<Aggregate> children;
+
+    explicit Aggregate(const MProfileSite * s) : site(s), count(0), total(0),
+                                                 min(~static_cast<uint64_t>(0)), max(0) {}
+};
+
+void merge(Aggregate & dst, const Node * src)
+{
+    for (const Node * n = src->child.load(std::memory_order_acquire); n != 0;
+         n = n->sibling.load(std::memory_order_acquire))
+    {
+        size_t i = 0;
+        while (i < dst.children.size() && dst.children[i].site != n->site)
+            ++i;
+        if (i == dst.children.size())
+            dst.children.push_back(Aggregate(n->site));
+        Aggregate & a = dst.children[i];
+        a.count += n->count.load(std::memory_order_relaxed);
+        a.total += n->total.load(std::memory_order_relaxed);
+        a.min = std::min(a.min, n->min.load(std::memory_order_relaxed));
+        a.max = std::max(a.max, n->max.load(std::memory_order_relaxed));
+        merge(a, n);
+    }
+}
+
+bool greaterTotal(const Aggregate & a, const Aggregate & b)
+{   return a.total > b.total; }
+
+/// Запись в порядке обхода в глубину; false - ни у узла, ни у вложенных нет вызовов
+bool flatten(Aggregate & a, unsigned depth, uint64_t mult, std::vector<MProfileRecord> & out)
+{
+    std::sort(a.children.begin(), a.children.end(), greaterTotal);
+    const size_t at = out.size();
+    MProfileRecord r;
+    r.site = a.site;
+    r.depth = depth;
+    r.count = a.count;
+    r.total = tsc::toNsecs(a.total, mult);
+    r.min = a.count != 0 ? tsc::toNsecs(a.min, mult) : 0;
+    r.max = tsc::toNsecs(a.max, mult);
+    out.push_back(r);
+
+    uint64_t nested = 0;
+    bool any = a.count != 0;
+    for (size_t i = 0; i < a.children.size(); ++i)
+    {
+        nested += a.children[i].total;
+        any = flatten(a.children[i], depth + 1, mult, out) || any;
+    }
+    if (!any)
+    {
+        out.resize(at);
+        return false;
+    }
+    out[at].self = a.total > nested ? tsc::toNsecs(a.total - nested, mult) : 0;
+    return true;
+}
+
+void clearTree(Node * node)
+{
+    for (Node * n = node->child.load(std::memory_order_acquire); n != 0;
+         n = n->sibling.load(std::memory_order_acquire))
+    {
+        n->clear();
+        clearTree(n);
+    }
+}
+
+} // namespace
+
+namespace detail {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Node * enter(const MProfileSite & site)
+{
+    ThreadTree * t = s_tree;
+    if (t == 0)
+        t = attach();
+    else if (t == released())
+        return 0;
+    Node * parent = t->current;
+    Node * n = parent->child.load(std::memory_order_relaxed);
+    while (n != 0 && n->site != &site)
+        n = n->sibling.load(std::memory_order_relaxed);
+    if (n == 0)
+        n = t->create(parent, site);
+    t->current = n;
+    n->start = stamp(t->hardware);
+    return n;
+}
+
+void leave(Node * node)
+{
+    ThreadTree * t = s_tree;
+    if (t == released())
+        return;
+    const uint64_t time = stamp(t->hardware) - node->start;
+    node->count.store(node->count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    node->total.store(node->total.load(std::memory_order_relaxed) + time, std::memory_order_relaxed);
+    if (time < node->min.load(std::memory_order_relaxed))
+        node->min.store(time, std::memory_order_relaxed);
+    if (time > node->max.load(std::memory_order_relaxed))
+        node->max.store(time, std::memory_order_relaxed);
+    t->current = node->parent;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace detail
+
+std::vector<MProfileRecord> collect()
+{
+    Aggregate root(0);
+    for (ThreadTree * t = s_trees.load(std::memory_order_acquire); t != 0; t = t->next)
+        merge(root, &t->root);
+
+    std::vector<MProfileRecord> records;
+    const uint64_t mult = tsc::calibration().mult;
+    std::sort(root.children.begin(), root.children.end(), greaterTotal);
+    for (size_t i = 0; i < root.children.size(); ++i)
+        flatten(root.children[i], 0, mult, records);
+    return records;
+}
+
+std::string report()
+{
+    const std::vector<MProfileRecord> records = collect();
+    std::string text;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-40s %10s %12s %12s %10s %10s %10s\n",
+                  "zone", "calls", "total ms", "self ms", "avg us", "min us", "max us");
+    text += line;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const MProfileRecord & r = records[i];
+        const int indent = static_cast<int>(2 * std::min(r.depth, 16u));
+        const double avg = r.count != 0 ? static_cast<double>(r.total) / r.count / 1e+3 : 0.0;
+        std::snprintf(line, sizeof(line), "%*s%-*.*s %10llu %12.3f %12.3f %10.3f %10.3f %10.3f\n",
+                      indent, "", 40 - indent, 40 - indent, r.site->name,
+                      static_cast<unsigned long long>(r.count), r.total / 1e+6, r.self / 1e+6,
+                      avg, r.min / 1e+3, r.max / 1e+3);
+        text += line;
+    }
+    return text;
+}
+
+void reset()
+{
+    for (ThreadTree * t = s_trees.load(std::memory_order_acquire); t != 0; t = t->next)
+        clearTree(&t->root);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace profiler
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MRandom.cpp
+/// @brief Генераторы псевдослучайных чисел: начальное значение из источника энтропии
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MRandomEngine.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#if defined(MLIB_OS_WIN)
+    #include <random>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Чтение 64 бит из системного источника, false - источник недоступен
+bool systemEntropy(uint64_t & value)
+{
+#if defined(MLIB_OS_WIN)
+    try
+    {
+        std::random_device rd;
+        value = (static_cast<uint64_t>(rd()) << 32) | rd();
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+#else
+    std::FILE * f = std::fopen("/dev/urandom", "rb");
+    if (f == 0)
+        return false;
+    std::setvbuf(f, 0, _IONBF, 0);
+    const bool ok = std::fread(&value, sizeof(value), 1, f) == 1;
+    std::fclose(f);
+    return ok;
+#endif
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t randomSeed()
+{
+    uint64_t value;
+    if (systemEntropy(value))
+        return value;
+
+    // Запасной вариант: разные значения для каждого вызова, потока и запуска
+    static std::atomic<uint64_t> counter(0);
+    const uint64_t ticks = static_cast<uint64_t>(
+        std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    MSplitMix64 mix(ticks ^ (static_cast<uint64_t>(std::time(0)) << 32)
+                    ^ (counter.fetch_add(1) * 0x9E3779B97F4A7C15ull)
+                    ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&value)));
+    mix();
+    return mix();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,690 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MRandomDistribution.cpp
+/// @brief Распределения случайных чисел: таблицы зиккурата и пакетная генерация xoshiro256**
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MRandomDistribution.h"
+#if defined(MLIB_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(MLIB_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+// Таблицы рассчитаны заранее с двойной точностью. Параметры подобраны так, чтобы площади
+// всех слоев были равны V и верхний слой заканчивался в x = 0:
+//   нормальное       f(x) = exp(-x^2 / 2), N = 128, R = 3.4426198558966519, V = 9.9125630353364708e-3
+//   экспоненциальное f(x) = exp(-x),       N = 256, R = 7.6971174701310492, V = 3.9496598225815588e-3
+
+const double cZigguratNormalX[129] = {
+    3.7130862467403625, 3.4426198558966519, 3.2230849845786183, 3.0832288582142136,
+    2.9786962526450167, 2.8943440070186703, 2.8231253505459661, 2.7611693723841535,
+    2.706113573118722, 2.656406411258192, 2.6109722484286126, 2.5690336259216386,
+    2.5300096723854661, 2.4934545220919504, 2.4590181774083497, 2.4264206455302113,
+    2.3954342780074671, 2.3658713701139873, 2.3375752413355304, 2.310413683695002,
+    2.2842740596736566, 2.2590595738653296, 2.2346863955870568, 2.2110814088747275,
+    2.1881804320720204, 2.1659267937448408, 2.1442701823562613, 2.1231657086697902,
+    2.1025731351849992, 2.0824562379877252, 2.0627822745039639, 2.0435215366506703,
+    2.0246469733729344, 2.0061338699589673, 1.9879595741230611, 1.9701032608497138,
+    1.9525457295488893, 1.9352692282919006, 1.9182573008597323, 1.9014946531003178,
+    1.8849670357028696, 1.8686611409895424, 1.8525645117230873, 1.8366654602533841,
+    1.820952996591005, 1.8054167642140486, 1.790046982594619, 1.7748343955807693,
+    1.759770224894232, 1.7448461281083767, 1.7300541605582438, 1.7153867407081167,
+    1.7008366185643011, 1.6863968467734864, 1.6720607540918524, 1.6578219209482077,
+    1.6436741568569828, 1.6296114794646783, 1.6156280950371329, 1.601718380215277,
+    1.5878768648844008, 1.5740982160167498, 1.5603772223598409, 1.5467087798535037,
+    1.5330878776675563, 1.5195095847593709, 1.5059690368565504, 1.4924614237746154,
+    1.4789819769830981, 1.465525957335795, 1.4520886428822168, 1.4386653166774617,
+    1.4252512545068619, 1.4118417124397606, 1.3984319141236068, 1.3850170377251492,
+    1.3715922024197327, 1.3581524543224233, 1.3446927517457135, 1.331207949657677,
+    1.3176927832013434, 1.3041418501204221, 1.2905495919178736, 1.2769102735517002,
+    1.2632179614460288, 1.2494664995643343, 1.2356494832544818, 1.2217602305309632,
+    1.2077917504067581, 1.1937367078237726, 1.1795873846544611, 1.1653356361550473,
+    1.1509728421389764, 1.136489852003076, 1.1218769225722545, 1.1071236475235358,
+    1.0922188768965542, 1.077150624881938, 1.0619059636836199, 1.0464709007525808,
+    1.0308302360564561, 1.0149673952393001, 0.99886423348064424, 0.98250080350276114,
+    0.96585507938813142, 0.94890262549791282, 0.93161619660135453, 0.91396525100880266,
+    0.89591535256623933, 0.87742742909771665, 0.85845684317805171, 0.83895221428120825,
+    0.81885390668331848, 0.79809206062627558, 0.77658398787614913, 0.7542306644345107,
+    0.73091191062188199, 0.70647961131360881, 0.680747918645905, 0.65347863871504319,
+    0.62435859730908905, 0.59296294244197889, 0.5586921783755191, 0.52065603872514621,
+    0.47743783725378924, 0.42654798630330681, 0.3628714310284204, 0.27232086470466699,
+    0
+};
+
+const double cZigguratNormalF[129] = {
+    0.0010143525641286182, 0.0026696290839025067, 0.0055489952208164755, 0.0086244844129304728,
+    0.01183947865798232, 0.015167298010672054, 0.018592102737165824, 0.022103304616111614,
+    0.025693291936149637, 0.029356317440253871, 0.033087886146505201, 0.036884388786968814,
+    0.040742868074790647, 0.04466086220087246, 0.048636295860284097, 0.052667401903503212,
+    0.056752663481538616, 0.060890770348566402, 0.065080585213631914, 0.069321117394180273,
+    0.073611501884754918, 0.077950982514654696, 0.08233889824295744, 0.08677467189554304,
+    0.091257800827634739, 0.095787849122578164, 0.10036444102954555, 0.1049872554103545,
+    0.10965602101581767, 0.11437051244988816, 0.11913054670871843, 0.12393598020398153,
+    0.12878670619710383, 0.13368265258464754, 0.13862377998585093, 0.14361008009193285,
+    0.14864157424369684, 0.15371831220958646, 0.15884037114093499, 0.16400785468492765,
+    0.16922089223892461, 0.17447963833240221, 0.17978427212496204, 0.18513499701071343,
+    0.19053204032091375, 0.19597565311811044, 0.20146611007620321, 0.20700370944187377,
+    0.21258877307373608, 0.21822164655637052, 0.22390269938713378, 0.22963232523430266,
+    0.23541094226572762, 0.24123899354775125, 0.24711694751469665, 0.25304529850976576,
+    0.25902456739871071, 0.26505530225816193, 0.27113807914102528, 0.27727350292189773,
+    0.28346220822601242, 0.28970486044581045, 0.2960021568498557, 0.30235482778947964,
+    0.30876363800925183, 0.31522938806815742, 0.32175291587920862, 0.32833509837615238,
+    0.33497685331697102, 0.34167914123501347, 0.34844296754987231, 0.35526938485154697,
+    0.36215949537303305, 0.36911445366827494, 0.3761354695144542, 0.3832238110598834,
+    0.39038080824138927, 0.39760785649804231, 0.40490642081148814, 0.41227804010702435,
+    0.41972433205403797, 0.42724699830956214, 0.43484783025466167, 0.44252871528024634,
+    0.45029164368692665, 0.45813871627287162, 0.46607215269457064, 0.47409430069824926,
+    0.48220764633483842, 0.4904148252893214, 0.49871863547658407, 0.50712205108130437,
+    0.51562823824987181, 0.52424057267899249, 0.53296265938998733, 0.54179835503172391,
+    0.55075179312105504, 0.55982741271069458, 0.5690299910747213, 0.57836468112670203,
+    0.58783705444182022, 0.59745315095181184, 0.60721953663260442, 0.61714337082656201,
+    0.62723248525781405, 0.63749547734314438, 0.64794182111855037, 0.65858200005865319,
+    0.66942766735770565, 0.6804918410064138, 0.69178914344603537, 0.70333609902581695,
+    0.71515150742047662, 0.72725691835450545, 0.73967724368333776, 0.75244155918570343,
+    0.76558417390923561, 0.77914608594170276, 0.7931770117838588, 0.80773829469612068,
+    0.82290721139526157, 0.83878360531064677, 0.85550060788506377, 0.873243048926853,
+    0.89228165080230215, 0.91304364799203741, 0.93628268170837037, 0.96359969315576677,
+    1
+};
+
+const double cZigguratExpX[257] = {
+    8.6971174701310492, 7.6971174701310492, 6.9410336293772117, 6.4783784938325688,
+    6.1441646657724718, 5.882144315795399, 5.6664101674540328, 5.4828906275260616,
+    5.3230905057543971, 5.1814872813014992, 5.0542884899813032, 4.9387770859012496,
+    4.8329397410251111, 4.7352429966017402, 4.6444918854200843, 4.5597370617073505,
+    4.480211746528421, 4.4052876934735714, 4.3344436803172712, 4.267242480277365,
+    4.2033137137351835, 4.1423408656640506, 4.0840513104082969, 4.0282085446479359,
+    3.9746060666737879, 3.9230625001354889, 3.8734176703995082, 3.8255294185223359,
+    3.779270992411667, 3.7345288940397965, 3.6912010902374179, 3.6491955157608529,
+    3.6084288131289086, 3.5688252656483366, 3.5303158891293429, 3.4928376547740592,
+    3.4563328211327597, 3.4207483572511195, 3.3860354424603005, 3.352149030900109,
+    3.3190474709707476, 3.2866921715990682, 3.255047308570449, 3.2240795652862633,
+    3.1937579032122394, 3.164053358025972, 3.1349388580844395, 3.1063890623398236,
+    3.0783802152540893, 3.0508900166154542, 3.0238975044556757, 2.9973829495161297,
+    2.9713277599210888, 2.9457143948950448, 2.9205262865127399, 2.8957477686001409,
+    2.8713640120155355, 2.8473609656351879, 2.8237253024500344, 2.8004443702507369,
+    2.7775061464397557, 2.7548991965623437, 2.7326126361946992, 2.7106360958679279,
+    2.6889596887418028, 2.6675739807732657, 2.6464699631518078, 2.6256390267977872,
+    2.6050729387408342, 2.5847638202141394, 2.5647041263169039, 2.5448866271118686,
+    2.5253043900378263, 2.5059507635285923, 2.4868193617402081, 2.4679040502973635,
+    2.4491989329782484, 2.4306983392644184, 2.4123968126888693, 2.394289099921457,
+    2.3763701405361397, 2.3586350574093364, 2.3410791477030335, 2.3236978743901955,
+    2.3064868582835789, 2.2894418705322686, 2.2725588255531539, 2.2558337743672183,
+    2.2392628983129081, 2.2228425031110359, 2.206569013257663, 2.1904389667232191,
+    2.1744490099377738, 2.1585958930438851, 2.1428764653998411, 2.1272876713173674,
+    2.1118265460190413, 2.0964902118017141, 2.0812758743932243, 2.0661808194905746,
+    2.0512024094685839, 2.0363380802487687, 2.0215853383189253, 2.0069417578945177,
+    1.992404978213576, 1.9779727009573598, 1.9636426877895476, 1.9494127580071843,
+    1.9352807862970509, 1.9212447005915274, 1.9073024800183869, 1.8934521529393076,
+    1.8796917950722107, 1.8660195276928273, 1.8524335159111749, 1.8389319670188793,
+    1.8255131289035191, 1.81217528852639, 1.7989167704602902, 1.7857359354841253,
+    1.772631179231305, 1.7596009308890743, 1.746643651946074, 1.7337578349855711,
+    1.7209420025219349, 1.7081947058780576, 1.6955145241015377, 1.6829000629175537,
+    1.6703499537164519, 1.6578628525741725, 1.6454374393037234, 1.6330724165359913,
+    1.6207665088282579, 1.6085184617988584, 1.5963270412864834, 1.5841910325326889,
+    1.5721092393862297, 1.5600804835278881, 1.5481036037145135, 1.5361774550410321,
+    1.5243009082192263, 1.5124728488721171, 1.5006921768428167, 1.4889578055167461,
+    1.4772686611561339, 1.4656236822457454, 1.4540218188487934, 1.4424620319720125,
+    1.4309432929388797, 1.4194645827699832, 1.4080248915695357, 1.3966232179170421,
+    1.385258568263122, 1.3739299563284906, 1.3626364025050868, 1.3513769332583352,
+    1.3401505805295046, 1.3289563811371166, 1.3177933761763247, 1.3066606104151741,
+    1.295557131686601, 1.2844819902750126, 1.2734342382962411, 1.2624129290696153,
+    1.2514171164808525, 1.2404458543344066, 1.2294981956938491, 1.2185731922087901,
+    1.2076698934267611, 1.1967873460884031, 1.1859245934042022, 1.1750806743109117,
+    1.1642546227056789, 1.1534454666557747, 1.1426522275816728, 1.1318739194110785,
+    1.1211095477013302, 1.110358108727411, 1.0996185885325973, 1.0888899619385468,
+    1.0781711915113723, 1.0674612264799677, 1.0567590016025514, 1.0460634359770442,
+    1.0353734317905285, 1.0246878730026172, 1.0140056239570965, 1.0033255279156967,
+    0.9926464055072759, 0.9819670530850626, 0.97128624098390326, 0.96060271166866651,
+    0.94991517776407597, 0.93922231995526229, 0.92852278474721039, 0.91781518207004431,
+    0.90709808271569026, 0.89637001558988993, 0.88562946476175153, 0.87487486629102507,
+    0.86410460481100448, 0.85331700984237335, 0.84251035181036849, 0.83168283773427321,
+    0.82083260655441181, 0.80995772405741828, 0.79905617735548717, 0.78812586886949243,
+    0.77716460975912971, 0.76617011273543467, 0.75513998418198225, 0.7440717155005081,
+    0.7329626735843654, 0.7218100903087562, 0.71061105090965504, 0.69936248110323196,
+    0.68806113277374781, 0.67670356802952258, 0.66528614139267794, 0.65380497984766495,
+    0.64225596042453637, 0.63063468493349029, 0.61893645139487607, 0.60715622162030003,
+    0.59528858429150289, 0.58332771274876949, 0.57126731653258833, 0.55910058551154063,
+    0.54682012516331058, 0.5344178812371656, 0.52188505159213505, 0.5092119824436544,
+    0.49638804551867116, 0.48340149165346186, 0.47023927508216901, 0.45688684093142024,
+    0.4433278660735524, 0.4295439402254107, 0.41551416960035636, 0.40121467889627777,
+    0.38661797794111957, 0.37169214532991723, 0.35639976025839382, 0.34069648106484912,
+    0.32452911701690945, 0.30783295467493216, 0.29052795549123039, 0.2725131854784647,
+    0.25365836338591202, 0.23379048305967473, 0.21267151063096662, 0.18995868962243184,
+    0.16512762256418728, 0.13730498094001259, 0.10483850756581865, 0.063852163815001445,
+    0
+};
+
+const double cZigguratExpF[257] = {
+    0.00016706669230796397, 0.00045413435384149698, 0.00096726928232717519, 0.0015362997803015741,
+    0.0021459677437189089, 0.0027887987935740783, 0.0034602647778369071, 0.0041572951208338005,
+    0.0048776559835424001, 0.0056196422072054934, 0.0063819059373191895, 0.0071633531836349977,
+    0.0079630774380170504, 0.0087803149858089839, 0.0096144136425022203, 0.010464810181029991,
+    0.011331013597834611, 0.0122125924262554, 0.013109164931255014, 0.014020391403181955,
+    0.014945968011691162, 0.01588562183997317, 0.016839106826039955, 0.017806200410911372,
+    0.018786700744696041, 0.019780424338009757, 0.020787204072578135, 0.021806887504283601,
+    0.022839335406385261, 0.023884420511558195, 0.024942026419731807, 0.026012046645134242,
+    0.027094383780955827, 0.028188948763978657, 0.029295660224637421, 0.030414443910466635,
+    0.031545232172893636, 0.032687963508959569, 0.033842582150874372, 0.035009037697397445,
+    0.036187284781931457, 0.037377282772959396, 0.038578995503074906, 0.039792391023374174,
+    0.041017441380414875, 0.042254122413316296, 0.043502413568888239, 0.044762297732943331,
+    0.046033761076175218, 0.047316792913181603, 0.048611385573379545, 0.049917534282706427,
+    0.051235237055126323, 0.052564494593071734, 0.053905310196046122, 0.055257689676697079,
+    0.056621641283742918, 0.057997175631200715, 0.059384305633420328, 0.060783046445479716,
+    0.062193415408541092, 0.063615431999807431, 0.06504911778675386, 0.066494496385339885,
+    0.067951593421936698, 0.069420436498728852, 0.07090105516237194, 0.072393480875708849,
+    0.073897746992364843, 0.075413888734058507, 0.076941943170480628, 0.078481949201606546,
+    0.080033947542320044, 0.081597980709237558, 0.083174093009632508, 0.084762330532368257,
+    0.086362741140757038, 0.087975374467270356, 0.089600281910032997, 0.09123751663104028,
+    0.092887133556043652, 0.094549189376055956, 0.096223742550432909, 0.097910853311492296,
+    0.099610583670637229, 0.10132299742595373, 0.1030481601712578, 0.10478613930657024,
+    0.10653700405000172, 0.10830082545103385, 0.11007767640518545, 0.11186763167005638,
+    0.11367076788274438, 0.1154871635786336, 0.11731689921155564, 0.11916005717532775,
+    0.1210167218266749, 0.12288697950954522, 0.12477091858083104, 0.12666862943751078,
+    0.12858020454522831, 0.13050573846833088, 0.13244532790138763, 0.13439907170221371,
+    0.13636707092642894, 0.13834942886358029, 0.14034625107486251, 0.14235764543247223,
+    0.1443837221606348, 0.14642459387834497, 0.14848037564386682, 0.15055118500103992,
+    0.15263714202744288, 0.15473836938446811, 0.15685499236936526, 0.15898713896931421,
+    0.16113493991759203, 0.16329852875190184, 0.16547804187493603, 0.16767361861725019,
+    0.16988540130252766, 0.17211353531532003, 0.17435816917135349, 0.17661945459049491,
+    0.17889754657247833, 0.18119260347549629, 0.18350478709776746, 0.18583426276219714,
+    0.18818119940425432, 0.19054576966319539, 0.19292814997677132, 0.19532852067956319,
+    0.19774706610509882, 0.20018397469191121, 0.20263943909370896, 0.20511365629383765,
+    0.20760682772422198, 0.21011915938898823, 0.21265086199297822, 0.21520215107537863,
+    0.21777324714870047, 0.22036437584335944, 0.22297576805812011, 0.22560766011668396,
+    0.22826029393071662, 0.23093391716962736, 0.23362878343743329, 0.23634515245705956,
+    0.23908329026244909, 0.24184346939887713, 0.24462596913189202, 0.24743107566532754,
+    0.25025908236886224, 0.2531102900156294, 0.25598500703041532, 0.25888354974901617,
+    0.26180624268936292, 0.26475341883506215, 0.26772541993204474, 0.27072259679905997,
+    0.27374530965280292, 0.2767939284485173, 0.27986883323697287, 0.28297041453878075,
+    0.28609907373707683, 0.28925522348967769, 0.29243928816189263, 0.29565170428126125,
+    0.29889292101558185, 0.30216340067569353, 0.30546361924459026, 0.30879406693456019,
+    0.31215524877417961, 0.31554768522712895, 0.31897191284495724, 0.32242848495608922,
+    0.32591797239355635, 0.32944096426413644, 0.3329980687618091, 0.33658991402867772,
+    0.34021714906678019, 0.34388044470450257, 0.34758049462163715, 0.35131801643748345,
+    0.35509375286678763, 0.35890847294875, 0.362762973354818, 0.36665807978151438,
+    0.37059464843514622, 0.37457356761590238, 0.37859575940958107, 0.38266218149601006,
+    0.38677382908413793, 0.39093173698479738, 0.39513698183329043, 0.39939068447523135,
+    0.40369401253053055, 0.40804818315203267, 0.41245446599716146, 0.41691418643300321,
+    0.42142872899761691, 0.42599954114303468, 0.43062813728845917, 0.43531610321563691,
+    0.44006510084235417, 0.44487687341454885, 0.44975325116275533, 0.45469615747461584,
+    0.45970761564213802, 0.46478975625042651, 0.46994482528396031, 0.47517519303737771,
+    0.48048336393045454, 0.48587198734188525, 0.49134386959403287, 0.49690198724154988,
+    0.50254950184134806, 0.50828977641064321, 0.51412639381474889, 0.52006317736823393,
+    0.52610421398362006, 0.53225388026304365, 0.53851687200286225, 0.54489823767244006,
+    0.55140341654064173, 0.55803828226258789, 0.56480919291240061, 0.57172304866482615,
+    0.57878735860284536, 0.58601031847726837, 0.59340090169173376, 0.60096896636523256,
+    0.60872538207962235, 0.61668218091520788, 0.6248527387036662, 0.6332519942143664,
+    0.64189671642726642, 0.65080583341457143, 0.66000084107900014, 0.66950631673192518,
+    0.67935057226476581, 0.68956649611707843, 0.70019265508278861, 0.71127476080507646,
+    0.72286765959357246, 0.73503809243142404, 0.74786862198519566, 0.76146338884989684,
+    0.77595685204011622, 0.79152763697249628, 0.80842165152300904, 0.8269932966430511,
+    0.8477855006239905, 0.87170433238120471, 0.90046992992574781, 0.93814368086217659,
+    1
+};
+
+} // namespace detail
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Четыре независимых потока xoshiro256**. Количество потоков не зависит от набора команд,
+/// поэтому последовательность одинакова в скалярной, SSE2 и AVX2 сборках.
+class XoshiroLanes
+{
+public:
+    enum { Lanes = 4 };
+
+    /// Состояния потоков заполняются SplitMix64 от четырех выходов e
+    explicit XoshiroLanes(MXoshiro256ss & e)
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            MSplitMix64 sm(e());
+            for (int k = 0; k < 4; ++k)
+                m_s[k][lane] = sm();
+        }
+    }
+
+    /// blocks * Lanes слов, слово потока l блока b - out[b * Lanes + l] (выравнивание любое)
+    void generate(void * out, size_t blocks);
+
+private:
+    uint64_t m_s[4][Lanes];     ///< Слово состояния k потока l - m_s[k][l]
+};
+
+#if defined(MLIB_SIMD_AVX2)
+
+template <int K>
+MLIB_FORCE_INLINE __m256i rotl(__m256i x)
+{   return _mm256_or_si256(_mm256_slli_epi64(x, K), _mm256_srli_epi64(x, 64 - K)); }
+
+void XoshiroLanes::generate(void * out, size_t blocks)
+{
+    __m256i * dst = static_cast<__m256i *>(out);
+    __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_s[0]));
+    __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_s[1]));
+    __m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_s[2]));
+    __m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_s[3]));
+    for (size_t b = 0; b < blocks; ++b)
+    {
+        // rotl(s1 * 5, 7) * 9: умножения - сдвигами и сложениями (в AVX2 нет 64-битного умножения)
+        __m256i r = rotl<7>(_mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2)));
+        r = _mm256_add_epi64(r, _mm256_slli_epi64(r, 3));
+        _mm256_storeu_si256(dst + b, r);
+
+        const __m256i t = _mm256_slli_epi64(s1, 17);
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = rotl<45>(s3);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(m_s[0]), s0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(m_s[1]), s1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(m_s[2]), s2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(m_s[3]), s3);
+}
+
+#elif defined(MLIB_SIMD_SSE2)
+
+template <int K>
+MLIB_FORCE_INLINE __m128i rotl(__m128i x)
+{   return _mm_or_si128(_mm_slli_epi64(x, K), _mm_srli_epi64(x, 64 - K)); }
+
+/// Один шаг двух потоков, выход - в out
+MLIB_FORCE_INLINE void step(__m128i & s0, __m128i & s1, __m128i & s2, __m128i & s3, __m128i * out)
+{
+    __m128i r = rotl<7>(_mm_add_epi64(s1, _mm_slli_epi64(s1, 2)));
+    r = _mm_add_epi64(r, _mm_slli_epi64(r, 3));
+    _mm_storeu_si128(out, r);
+
+    const __m128i t = _mm_slli_epi64(s1, 17);
+    s2 = _mm_xor_si128(s2, s0);
+    s3 = _mm_xor_si128(s3, s1);
+    s1 = _mm_xor_si128(s1, s2);
+    s0 = _mm_xor_si128(s0, s3);
+    s2 = _mm_xor_si128(s2, t);
+    s3 = rotl<45>(s3);
+}
+
+void XoshiroLanes::generate(void * out, size_t blocks)
+{
+    __m128i * dst = static_cast<__m128i *>(out);
+    __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_s[0]));
+    __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_s[1]));
+    __m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_s[2]));
+    __m128i a3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_s[3]));
+    __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_s[0] + 2));
+    __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_s[1] + 2));
+    __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_s[2] + 2));
+    __m128i b3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_s[3] + 2));
+    for (size_t b = 0; b < blocks; ++b)
+    {
+        step(a0, a1, a2, a3, dst + 2 * b);
+        step(b0, b1, b2, b3, dst + 2 * b + 1);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(m_s[0]), a0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(m_s[1]), a1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(m_s[2]), a2);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(m_s[3]), a3);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(m_s[0] + 2), b0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(m_s[1] + 2), b1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(m_s[2] + 2), b2);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(m_s[3] + 2), b3);
+}
+
+#else
+
+void XoshiroLanes::generate(void * out, size_t blocks)
+{
+    unsigned char * dst = static_cast<unsigned char *>(out);
+    // Локальная копия состояния: запись в out не должна заставлять перечитывать m_s
+    uint64_t s[4][Lanes];
+    std::memcpy(s, m_s, sizeof(s));
+    for (size_t b = 0; b < blocks; ++b)
+    {
+        for (int l = 0; l < Lanes; ++l)
+        {
+            const uint64_t s1 = s[1][l];
+            const uint64_t r = detail::rotl64(s1 * 5, 7) * 9;
+            std::memcpy(dst + (b * Lanes + l) * sizeof(r), &r, sizeof(r));
+            const uint64_t t = s1 << 17;
+            s[2][l] ^= s[0][l];
+            s[3][l] ^= s1;
+            s[1][l] ^= s[2][l];
+            s[0][l] ^= s[3][l];
+            s[2][l] ^= t;
+            s[3][l] = detail::rotl64(s[3][l], 45);
+        }
+    }
+    std::memcpy(m_s, s, sizeof(s));
+}
+
+#endif
+
+/// Буферизованный источник слов XoshiroLanes с интерфейсом генератора
+class LaneSource
+{
+public:
+    typedef uint64_t result_type;
+    enum { Buffer = 256 };
+
+    static MLIB_CONSTEXPR result_type min() { return 0; }
+    static MLIB_CONSTEXPR result_type max() { return ~static_cast<uint64_t>(0); }
+
+    explicit LaneSource(MXoshiro256ss & e) : m_lanes(e), m_pos(Buffer) {}
+
+    inline result_type operator()()
+    {
+        if (m_pos == Buffer)
+        {
+            m_lanes.generate(m_buffer, Buffer / XoshiroLanes::Lanes);
+            m_pos = 0;
+        }
+        return m_buffer[m_pos++];
+    }
+
+private:
+    XoshiroLanes m_lanes;
+    size_t m_pos;
+    uint64_t m_buffer[Buffer];
+};
+
+/// Меньше - поэлементная генерация (подготовка потоков дороже выигрыша)
+const size_t cMinBatch = 64;
+
+/// Слов в одном блоке преобразования
+const size_t cChunk = 256;
+
+/// Начиная с этого размера случайные байты пишутся в обход кэша: буфер все равно
+/// не поместится в кэш, а запись без чтения строк экономит половину обмена с памятью.
+/// Слова генерируются в буфер в кэше и копируются, поэтому содержимое то же, что без обхода
+const size_t cNonTemporalBytes = 4 * 1024 * 1024;
+
+#if defined(MLIB_SIMD_SSE2)
+/// Копирование из кэша в память в обход кэша (выравнивание dst любое)
+void streamCopy(unsigned char * dst, const void * src, size_t size)
+{
+    const unsigned char * from = static_cast<const unsigned char *>(src);
+#if defined(MLIB_SIMD_AVX2)
+    const size_t width = sizeof(__m256i);
+#else
+    const size_t width = sizeof(__m128i);
+#endif
+    size_t i = (width - reinterpret_cast<uintptr_t>(dst) % width) % width;
+    if (i > size)
+        i = size;
+    std::memcpy(dst, from, i);
+    for (; i + width <= size; i += width)
+    {
+#if defined(MLIB_SIMD_AVX2)
+        _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i)));
+#else
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i)));
+#endif
+    }
+    std::memcpy(dst + i, from + i, size - i);
+}
+#endif
+
+/// Повтор отбракованного кандидата Lemire (32 бита) по выходам e
+uint32_t boundedRetry(MXoshiro256ss & e, uint32_t range, uint32_t threshold)
+{
+    uint64_t m;
+    do
+        m = (e() >> 32) * range;
+    while (static_cast<uint32_t>(m) < threshold);
+    return static_cast<uint32_t>(m >> 32);
+}
+
+/// out[i] = a + scale * unitDouble(bits[i])
+void toUniform(const uint64_t * bits, double * out, size_t count, double a, double scale)
+{
+    size_t i = 0;
+#if defined(MLIB_SIMD_AVX2)
+    const __m256i exponent = _mm256_set1_epi64x(0x3FF0000000000000ll);
+    const __m256d one = _mm256_set1_pd(1.0), va = _mm256_set1_pd(a), vs = _mm256_set1_pd(scale);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i));
+        const __m256d u = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(v, 12), exponent)), one);
+        _mm256_storeu_pd(out + i, _mm256_add_pd(va, _mm256_mul_pd(vs, u)));
+    }
+#elif defined(MLIB_SIMD_SSE2)
+    const __m128i exponent = _mm_set_epi32(0x3FF00000, 0, 0x3FF00000, 0);
+    const __m128d one = _mm_set1_pd(1.0), va = _mm_set1_pd(a), vs = _mm_set1_pd(scale);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bits + i));
+        const __m128d u = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(v, 12), exponent)), one);
+        _mm_storeu_pd(out + i, _mm_add_pd(va, _mm_mul_pd(vs, u)));
+    }
+#endif
+    for (; i < count; ++i)
+        out[i] = a + scale * detail::unitDouble(bits[i]);
+}
+
+/// Два числа из слова: out[2i] - по младшей половине bits[i], out[2i + 1] - по старшей
+void toUniform(const uint64_t * bits, float * out, size_t count, float a, float scale)
+{
+    size_t i = 0;
+#if defined(MLIB_SIMD_AVX2)
+    // На x86 (little-endian) половины слов лежат в памяти в том же порядке
+    const __m256i exponent = _mm256_set1_epi32(0x3F800000);
+    const __m256 one = _mm256_set1_ps(1.0f), va = _mm256_set1_ps(a), vs = _mm256_set1_ps(scale);
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i / 2));
+        const __m256 u = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_srli_epi32(v, 9), exponent)), one);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(va, _mm256_mul_ps(vs, u)));
+    }
+#elif defined(MLIB_SIMD_SSE2)
+    const __m128i exponent = _mm_set1_epi32(0x3F800000);
+    const __m128 one = _mm_set1_ps(1.0f), va = _mm_set1_ps(a), vs = _mm_set1_ps(scale);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bits + i / 2));
+        const __m128 u = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(v, 9), exponent)), one);
+        _mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(vs, u)));
+    }
+#endif
+    for (; i < count; ++i)
+        out[i] = a + scale * detail::unitFloat(i & 1 ? bits[i / 2] : bits[i / 2] << 32);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void fillBits(MXoshiro256ss & e, uint64_t * out, size_t count)
+{
+    if (count < cMinBatch)
+    {
+        fillBits<MXoshiro256ss>(e, out, count);
+        return;
+    }
+    XoshiroLanes lanes(e);
+    const size_t blocks = count / XoshiroLanes::Lanes;
+    lanes.generate(out, blocks);
+    const size_t done = blocks * XoshiroLanes::Lanes;
+    if (done < count)
+    {
+        uint64_t tail[XoshiroLanes::Lanes];
+        lanes.generate(tail, 1);
+        for (size_t i = done; i < count; ++i)
+            out[i] = tail[i - done];
+    }
+}
+
+void fillRandom(MXoshiro256ss & e, void * data, size_t size)
+{
+    if (size < cMinBatch * sizeof(uint64_t))
+    {
+        fillRandom<MXoshiro256ss>(e, data, size);
+        return;
+    }
+    // Байты - подряд идущие слова потоков независимо от выравнивания data
+    XoshiroLanes lanes(e);
+    unsigned char * dst = static_cast<unsigned char *>(data);
+#if defined(MLIB_SIMD_SSE2)
+    if (size >= cNonTemporalBytes)
+    {
+        uint64_t buffer[cChunk];
+        for (size_t i = 0; i < size; i += sizeof(buffer))
+        {
+            const size_t n = size - i < sizeof(buffer) ? size - i : sizeof(buffer);
+            lanes.generate(buffer, (n + sizeof(uint64_t) * XoshiroLanes::Lanes - 1) / (sizeof(uint64_t) * XoshiroLanes::Lanes));
+            streamCopy(dst + i, buffer, n);
+        }
+        _mm_sfence();
+        return;
+    }
+#endif
+    const size_t blockSize = sizeof(uint64_t) * XoshiroLanes::Lanes;
+    const size_t blocks = size / blockSize;
+    lanes.generate(dst, blocks);
+    const size_t rest = size - blocks * blockSize;
+    if (rest != 0)
+    {
+        uint64_t tail[XoshiroLanes::Lanes];
+        lanes.generate(tail, 1);
+        std::memcpy(dst + blocks * blockSize, tail, rest);
+    }
+}
+
+void fillBounded(MXoshiro256ss & e, uint32_t * out, size_t count, uint32_t range)
+{
+    if (count < cMinBatch || range == 0)
+    {
+        fillBounded<MXoshiro256ss>(e, out, count, range);
+        return;
+    }
+    // Lemire для 32 бит: каждое слово дает два кандидата, отбракованные (вероятность
+    // меньше range / 2^32) заменяются значениями скалярного генератора
+    XoshiroLanes lanes(e);
+    uint64_t buffer[cChunk];
+    const uint32_t threshold = static_cast<uint32_t>(0u - range) % range;
+    for (size_t i = 0; i < count; i += 2 * cChunk)
+    {
+        const size_t n = count - i < 2 * cChunk ? count - i : 2 * cChunk;
+        lanes.generate(buffer, ((n + 1) / 2 + XoshiroLanes::Lanes - 1) / XoshiroLanes::Lanes);
+        uint32_t * dst = out + i;
+        for (size_t j = 0; j < n; j += 2)
+        {
+            const uint64_t word = buffer[j / 2];
+            const uint64_t m0 = (word & 0xFFFFFFFFu) * range;
+            const uint64_t m1 = (word >> 32) * range;
+            dst[j] = static_cast<uint32_t>(m0 >> 32);
+            if (j + 1 < n)
+                dst[j + 1] = static_cast<uint32_t>(m1 >> 32);
+            if (static_cast<uint32_t>(m0) < threshold)
+                dst[j] = boundedRetry(e, range, threshold);
+            if (static_cast<uint32_t>(m1) < threshold && j + 1 < n)
+                dst[j + 1] = boundedRetry(e, range, threshold);
+        }
+    }
+}
+
+void fillUniform(MXoshiro256ss & e, double * out, size_t count, double a, double b)
+{
+    if (count < cMinBatch)
+    {
+        fillUniform<MXoshiro256ss>(e, out, count, a, b);
+        return;
+    }
+    XoshiroLanes lanes(e);
+    uint64_t buffer[cChunk];
+    for (size_t i = 0; i < count; i += cChunk)
+    {
+        const size_t n = count - i < cChunk ? count - i : cChunk;
+        lanes.generate(buffer, (n + XoshiroLanes::Lanes - 1) / XoshiroLanes::Lanes);
+        toUniform(buffer, out + i, n, a, b - a);
+    }
+}
+
+void fillUniform(MXoshiro256ss & e, float * out, size_t count, float a, float b)
+{
+    if (count < cMinBatch)
+    {
+        fillUniform<MXoshiro256ss>(e, out, count, a, b);
+        return;
+    }
+    // Два числа из каждого слова
+    XoshiroLanes lanes(e);
+    uint64_t buffer[cChunk];
+    for (size_t i = 0; i < count; i += 2 * cChunk)
+    {
+        const size_t n = count - i < 2 * cChunk ? count - i : 2 * cChunk;
+        lanes.generate(buffer, ((n + 1) / 2 + XoshiroLanes::Lanes - 1) / XoshiroLanes::Lanes);
+        toUniform(buffer, out + i, n, a, b - a);
+    }
+}
+
+void fillNormal(MXoshiro256ss & e, double * out, size_t count, double mean, double sigma)
+{
+    if (count < cMinBatch)
+    {
+        fillNormal<MXoshiro256ss>(e, out, count, mean, sigma);
+        return;
+    }
+    LaneSource src(e);
+    fillNormal(src, out, count, mean, sigma);
+}
+
+void fillNormal(MXoshiro256ss & e, float * out, size_t count, float mean, float sigma)
+{
+    if (count < cMinBatch)
+    {
+        fillNormal<MXoshiro256ss>(e, out, count, mean, sigma);
+        return;
+    }
+    LaneSource src(e);
+    fillNormal(src, out, count, mean, sigma);
+}
+
+void fillExponential(MXoshiro256ss & e, double * out, size_t count, double lambda)
+{
+    if (count < cMinBatch)
+    {
+        fillExponential<MXoshiro256ss>(e, out, count, lambda);
+        return;
+    }
+    LaneSource src(e);
+    fillExponential(src, out, count, lambda);
+}
+
+void fillExponential(MXoshiro256ss & e, float * out, size_t count, float lambda)
+{
+    if (count < cMinBatch)
+    {
+        fillExponential<MXoshiro256ss>(e, out, count, lambda);
+        return;
+    }
+    LaneSource src(e);
+    fillExponential(src, out, count, lambda);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MRandomEngine.cpp
+/// @brief Генераторы на счетчике: пакетное вычисление блоков Philox и Threefry
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Блоки независимы, поэтому в AVX2 считаются по четыре: слово i блоков - в 64-битных
+/// элементах одного регистра. Результат совпадает со скалярным вычислением.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MRandomEngine.h"
+#if defined(MLIB_SIMD_AVX2)
+    #include <immintrin.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+#if defined(MLIB_SIMD_AVX2)
+
+/// Номера блоков first .. first + 3
+MLIB_FORCE_INLINE __m256i blockIndices(uint64_t first)
+{
+    return _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(first)), _mm256_set_epi64x(3, 2, 1, 0));
+}
+
+/// Запись четырех блоков: v01 - слова 0 и 1 блоков, v23 - слова 2 и 3 (по 128 бит на блок)
+MLIB_FORCE_INLINE void storeBlocks(__m256i v01, __m256i v23, void * out)
+{
+    const __m256i lo = _mm256_unpacklo_epi64(v01, v23);     // блоки 0 | 2
+    const __m256i hi = _mm256_unpackhi_epi64(v01, v23);     // блоки 1 | 3
+    __m256i * dst = static_cast<__m256i *>(out);
+    _mm256_storeu_si256(dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+template <int K>
+MLIB_FORCE_INLINE __m256i rotl(__m256i x)
+{   return _mm256_or_si256(_mm256_slli_epi64(x, K), _mm256_srli_epi64(x, 64 - K)); }
+
+/// Раунды Threefry: четный - пары (0, 1), (2, 3), нечетный - (0, 3), (2, 1)
+template <int A, int B>
+MLIB_FORCE_INLINE void mixEven(__m256i & x0, __m256i & x1, __m256i & x2, __m256i & x3)
+{
+    x0 = _mm256_add_epi64(x0, x1);
+    x1 = _mm256_xor_si256(rotl<A>(x1), x0);
+    x2 = _mm256_add_epi64(x2, x3);
+    x3 = _mm256_xor_si256(rotl<B>(x3), x2);
+}
+
+template <int A, int B>
+MLIB_FORCE_INLINE void mixOdd(__m256i & x0, __m256i & x1, __m256i & x2, __m256i & x3)
+{
+    x0 = _mm256_add_epi64(x0, x3);
+    x3 = _mm256_xor_si256(rotl<A>(x3), x0);
+    x2 = _mm256_add_epi64(x2, x1);
+    x1 = _mm256_xor_si256(rotl<B>(x1), x2);
+}
+
+#endif
+
+} // namespace
+
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void philox4x32Blocks(const uint32_t key[2], uint64_t stream, uint64_t first, size_t count, uint32_t * out)
+{
+    size_t b = 0;
+#if defined(MLIB_SIMD_AVX2)
+    // 32-битные слова - в младших половинах 64-битных элементов, _mm256_mul_epu32 дает
+    // полное произведение 32x32->64
+    const __m256i mask = _mm256_set1_epi64x(0xFFFFFFFFll);
+    const __m256i m0 = _mm256_set1_epi64x(0xD2511F53ll), m1 = _mm256_set1_epi64x(0xCD9E8D57ll);
+    const __m256i w0 = _mm256_set1_epi64x(0x9E3779B9ll), w1 = _mm256_set1_epi64x(0xBB67AE85ll);
+    const __m256i s0 = _mm256_set1_epi64x(static_cast<long long>(stream & 0xFFFFFFFFu));
+    const __m256i s1 = _mm256_set1_epi64x(static_cast<long long>(stream >> 32));
+    for (; b + 4 <= count; b += 4)
+    {
+        const __m256i index = blockIndices(first + b);
+        __m256i c0 = _mm256_and_si256(index, mask), c1 = _mm256_srli_epi64(index, 32);
+        __m256i c2 = s0, c3 = s1;
+        __m256i k0 = _mm256_set1_epi64x(key[0]), k1 = _mm256_set1_epi64x(key[1]);
+        for (int round = 0; round < 10; ++round)
+        {
+            const __m256i p0 = _mm256_mul_epu32(c0, m0);
+            const __m256i p1 = _mm256_mul_epu32(c2, m1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1), k0);
+            c2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3), k1);
+            c1 = _mm256_and_si256(p1, mask);
+            c3 = _mm256_and_si256(p0, mask);
+            k0 = _mm256_add_epi32(k0, w0);  // старшие половины остаются нулевыми
+            k1 = _mm256_add_epi32(k1, w1);
+        }
+        storeBlocks(_mm256_or_si256(c0, _mm256_slli_epi64(c1, 32)),
+                    _mm256_or_si256(c2, _mm256_slli_epi64(c3, 32)), out + 4 * b);
+    }
+#endif
+    for (; b < count; ++b)
+        philox4x32Block(key, stream, first + b, out + 4 * b);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void threefry4x64Blocks(const uint64_t ks[5], uint64_t first, size_t count, uint64_t * out)
+{
+    size_t b = 0;
+#if defined(MLIB_SIMD_AVX2)
+    __m256i k[5];
+    for (int i = 0; i < 5; ++i)
+        k[i] = _mm256_set1_epi64x(static_cast<long long>(ks[i]));
+    for (; b + 4 <= count; b += 4)
+    {
+        __m256i x0 = _mm256_add_epi64(blockIndices(first + b), k[0]);
+        __m256i x1 = k[1], x2 = k[2], x3 = k[3];
+        for (int s = 1; s <= 5; ++s)
+        {
+            if (s % 2 != 0)
+            {
+                mixEven<14, 16>(x0, x1, x2, x3);
+                mixOdd<52, 57>(x0, x1, x2, x3);
+                mixEven<23, 40>(x0, x1, x2, x3);
+                mixOdd<5, 37>(x0, x1, x2, x3);
+            }
+            else
+            {
+                mixEven<25, 33>(x0, x1, x2, x3);
+                mixOdd<46, 12>(x0, x1, x2, x3);
+                mixEven<58, 22>(x0, x1, x2, x3);
+                mixOdd<32, 32>(x0, x1, x2, x3);
+            }
+            x0 = _mm256_add_epi64(x0, k[s % 5]);
+            x1 = _mm256_add_epi64(x1, k[(s + 1) % 5]);
+            x2 = _mm256_add_epi64(x2, k[(s + 2) % 5]);
+            x3 = _mm256_add_epi64(_mm256_add_epi64(x3, k[(s + 3) % 5]), _mm256_set1_epi64x(s));
+        }
+        // Транспонирование 4x4: блок - четыре подряд идущих слова
+        const __m256i t0 = _mm256_unpacklo_epi64(x0, x1);  // x0, x1 блоков 0 | 2
+        const __m256i t1 = _mm256_unpackhi_epi64(x0, x1);  // x0, x1 блоков 1 | 3
+        const __m256i t2 = _mm256_unpacklo_epi64(x2, x3);
+        const __m256i t3 = _mm256_unpackhi_epi64(x2, x3);
+        __m256i * dst = reinterpret_cast<__m256i *>(out + 4 * b);
+        _mm256_storeu_si256(dst,     _mm256_permute2x128_si256(t0, t2, 0x20));
+        _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(t1, t3, 0x20));
+        _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(t0, t2, 0x31));
+        _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(t1, t3, 0x31));
+    }
+#endif
+    for (; b < count; ++b)
+        threefry4x64Block(ks, first + b, out + 4 * b);
+}
+
+} // namespace detail
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
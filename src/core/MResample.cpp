@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MResample.cpp
+/// @brief Интерполяция с учетом перехода угла через 0/2ПИ, развертка фазы, передискретизация
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Сокращение разностей углов для interpolateAngle и результата resampleAngle выполняют
+/// пакетные modPi/mod2Pi (MMathBatch) над блоками в кеше, поэтому семантика совпадает с ними.
+/// Внутри прохода по отрезкам разность соседних углов сокращается выражением
+/// d - 2ПИ ceil((d - ПИ) / 2ПИ) без fmod.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MResample.h"
+#include "MMathKernels.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+using namespace detail;
+
+/// Размер блока промежуточных буферов
+const size_t cBlock = 512;
+
+/// Разность углов, сокращенная до (-ПИ, ПИ]
+template <typename T>
+inline T wrapDiff(T d)
+{   return d - c2pi<T>() * std::ceil((d - cPi<T>()) * (static_cast<T>(1) / c2pi<T>())); }
+
+//--------------------------------------------------------------------------------------------------
+// interpolateAngle
+
+/// d[i] = b[i] - a[i]
+template <class Vec>
+size_t diffBlock(const typename Vec::T * a, const typename Vec::T * b, typename Vec::T * d,
+                 size_t begin, size_t count)
+{
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+        Vec::store(d + i, Vec::sub(Vec::load(b + i), Vec::load(a + i)));
+    return i;
+}
+
+/// d[i] = a[i] + t[i] d[i]
+template <class Vec>
+size_t axpyBlock(const typename Vec::T * a, const typename Vec::T * t, typename Vec::T * d,
+                 size_t begin, size_t count)
+{
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+        Vec::store(d + i, Vec::fmadd(Vec::load(t + i), Vec::load(d + i), Vec::load(a + i)));
+    return i;
+}
+
+template <typename T>
+void interpolateAngleImpl(const T * a, const T * b, const T * t, T * out, size_t count)
+{
+    typedef typename VecBest<T>::type Vec;
+
+    T buf[cBlock];
+    for (size_t pos = 0; pos < count; pos += cBlock)
+    {
+        const size_t n = count - pos < cBlock ? count - pos : cBlock;
+        size_t i = diffBlock<Vec>(a + pos, b + pos, buf, 0, n);
+        diffBlock<Vec1<T> >(a + pos, b + pos, buf, i, n);
+        modPi(buf, buf, n);
+        i = axpyBlock<Vec>(a + pos, t + pos, buf, 0, n);
+        axpyBlock<Vec1<T> >(a + pos, t + pos, buf, i, n);
+        mod2Pi(buf, out + pos, n);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// unwrap
+
+/// Граница скачка фазы: больше нее, а также NaN и Inf число оборотов не меняют
+/// (в пределах точного floor всех наборов команд)
+inline double jumpLimit() { return 1073741824.0; }
+
+/// k[i] = floor((ПИ - (in[i] - in[i - 1])) / 2ПИ) - приращение числа оборотов, i >= 1
+template <class Vec>
+size_t turnsBlock(const typename Vec::T * in, typename Vec::T * k, size_t begin, size_t count)
+{
+    typedef typename Vec::T T;
+    typedef typename Vec::V V;
+
+    const V pi = Vec::set1(cPi<T>());
+    const V inv = Vec::set1(static_cast<T>(1) / c2pi<T>());
+    const V limit = Vec::set1(static_cast<T>(jumpLimit()));
+
+    size_t i = begin;
+    for (; i + Vec::Width <= count; i += Vec::Width)
+    {
+        V d = Vec::sub(Vec::load(in + i), Vec::load(in + i - 1));
+        d = Vec::ifThen(Vec::lt(Vec::abs(d), limit), d);
+        Vec::store(k + i, Vec::floor(Vec::mul(Vec::sub(pi, d), inv)));
+    }
+    return i;
+}
+
+template <typename T>
+void unwrapImpl(const T * in, T * out, size_t count, T & prev, int64_t & turns)
+{
+    typedef typename VecBest<T>::type Vec;
+
+    if (count == 0)
+        return;
+    const T inv = static_cast<T>(1) / c2pi<T>();
+    T k[cBlock];
+    int64_t n = turns;
+    for (size_t pos = 0; pos < count; pos += cBlock)
+    {
+        const size_t len = count - pos < cBlock ? count - pos : cBlock;
+        const T * src = in + pos;
+        // Первый элемент блока - относительно последнего значения предыдущего
+        const T d = src[0] - prev;
+        k[0] = std::fabs(d) < static_cast<T>(jumpLimit()) ? std::floor((cPi<T>() - d) * inv) : 0;
+        size_t i = turnsBlock<Vec>(src, k, 1, len);
+        turnsBlock<Vec1<T> >(src, k, i, len);
+        prev = src[len - 1];
+        for (size_t j = 0; j < len; ++j)
+        {
+            n += static_cast<int64_t>(k[j]);
+            out[pos + j] = src[j] + c2pi<T>() * static_cast<T>(n);
+        }
+    }
+    turns = n;
+}
+
+//--------------------------------------------------------------------------------------------------
+// resample
+
+/// Производная в узле i по трем точкам (на краях - односторонняя разность)
+template <typename T>
+inline T slope(const T * time, const T * y, size_t i, size_t count)
+{
+    if (i == 0)
+        return (y[1] - y[0]) / (time[1] - time[0]);
+    if (i + 1 == count)
+        return (y[i] - y[i - 1]) / (time[i] - time[i - 1]);
+    const T h0 = time[i] - time[i - 1];
+    const T h1 = time[i + 1] - time[i];
+    const T s0 = (y[i] - y[i - 1]) / h0;
+    const T s1 = (y[i + 1] - y[i]) / h1;
+    return (s0 * h1 + s1 * h0) / (h0 + h1);
+}
+
+/// Значения ym1, y0, y1, y2 вокруг отрезка [i, i + 1]; для углов - развернутые относительно y0
+template <typename T, bool Angle>
+inline void neighbours(const T * value, size_t i, size_t count, T * y)
+{
+    const size_t lo = i > 0 ? i - 1 : i;
+    const size_t hi = i + 2 < count ? i + 2 : i + 1;
+    y[1] = value[i];
+    if (Angle)
+    {
+        y[0] = y[1] - wrapDiff(value[i] - value[lo]);
+        y[2] = y[1] + wrapDiff(value[i + 1] - value[i]);
+        y[3] = y[2] + wrapDiff(value[hi] - value[i + 1]);
+    }
+    else
+    {
+        y[0] = value[lo];
+        y[2] = value[i + 1];
+        y[3] = value[hi];
+    }
+}
+
+template <typename T, bool Angle, bool Cubic>
+void resampleImpl(const T * time, const T * value, size_t count, T start, T step, T * out, size_t outCount)
+{
+    if (count == 0)
+    {
+        for (size_t j = 0; j < outCount; ++j)
+            out[j] = std::numeric_limits<T>::quiet_NaN();
+        return;
+    }
+
+    const T first = time[0];
+    const T last = time[count - 1];
+    size_t i = 0;   // Текущий отрезок [time[i], time[i + 1]]
+    for (size_t j = 0; j < outCount; ++j)
+    {
+        const T tj = start + step * static_cast<T>(j);
+        if (!(tj > first))
+        {
+            out[j] = value[0];
+            continue;
+        }
+        if (!(tj < last))
+        {
+            out[j] = value[count - 1];
+            continue;
+        }
+
+        // Сетка обычно идет вперед - линейный поиск от текущего отрезка, иначе двоичный
+        if (tj < time[i])
+        {
+            size_t lo = 0, hi = i;
+            while (hi - lo > 1)
+            {
+                const size_t mid = lo + (hi - lo) / 2;
+                if (time[mid] <= tj)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+            i = lo;
+        }
+        while (time[i + 1] <= tj)
+            ++i;
+
+        const T h = time[i + 1] - time[i];
+        const T s = (tj - time[i]) / h;
+        T y[4];
+        neighbours<T, Angle>(value, i, count, y);
+        if (!Cubic)
+        {
+            out[j] = y[1] + s * (y[2] - y[1]);
+            continue;
+        }
+
+        // Узлы для производных: соседние отсчеты с развернутыми значениями
+        const size_t lo = i > 0 ? i - 1 : i;
+        const size_t hi = i + 2 < count ? i + 2 : i + 1;
+        const T tt[4] = { time[lo], time[i], time[i + 1], time[hi] };
+        const T m0 = i > 0 ? slope(tt, y, 1, 4) : (y[2] - y[1]) / h;
+        const T m1 = i + 2 < count ? slope(tt, y, 2, 4) : (y[2] - y[1]) / h;
+
+        const T s2 = s * s;
+        const T s3 = s2 * s;
+        const T h00 = 2 * s3 - 3 * s2 + 1;
+        const T h10 = s3 - 2 * s2 + s;
+        const T h01 = 3 * s2 - 2 * s3;
+        const T h11 = s3 - s2;
+        out[j] = h00 * y[1] + h10 * h * m0 + h01 * y[2] + h11 * h * m1;
+    }
+
+    if (Angle)
+        mod2Pi(out, out, outCount);
+}
+
+template <typename T, bool Angle>
+inline void resampleDispatch(const T * time, const T * value, size_t count, T start, T step,
+                             T * out, size_t outCount, ResampleMethod method)
+{
+    if (method == ResampleCubic && count > 2)
+        resampleImpl<T, Angle, true>(time, value, count, start, step, out, outCount);
+    else
+        resampleImpl<T, Angle, false>(time, value, count, start, step, out, outCount);
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void interpolateAngle(const float * a, const float * b, const float * t, float * out, size_t count)
+{   interpolateAngleImpl(a, b, t, out, count); }
+
+void interpolateAngle(const double * a, const double * b, const double * t, double * out, size_t count)
+{   interpolateAngleImpl(a, b, t, out, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void unwrap(const float * in, float * out, size_t count, float & prev, int64_t & turns)
+{   unwrapImpl(in, out, count, prev, turns); }
+
+void unwrap(const double * in, double * out, size_t count, double & prev, int64_t & turns)
+{   unwrapImpl(in, out, count, prev, turns); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void resample(const float * time, const float * value, size_t count,
+              float start, float step, float * out, size_t outCount, ResampleMethod method)
+{   resampleDispatch<float, false>(time, value, count, start, step, out, outCount, method); }
+
+void resample(const double * time, const double * value, size_t count,
+              double start, double step, double * out, size_t outCount, ResampleMethod method)
+{   resampleDispatch<double, false>(time, value, count, start, step, out, outCount, method); }
+
+void resampleAngle(const float * time, const float * value, size_t count,
+                   float start, float step, float * out, size_t outCount, ResampleMethod method)
+{   resampleDispatch<float, true>(time, value, count, start, step, out, outCount, method); }
+
+void resampleAngle(const double * time, const double * value, size_t count,
+                   double start, double step, double * out, size_t outCount, ResampleMethod method)
+{   resampleDispatch<double, true>(time, value, count, start, step, out, outCount, method); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MStatistics.cpp
+/// @brief Накопители статистики потока за один проход
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+///
+/// Объединение частей (Chan et al.): n = na + nb, d = mean_b - mean_a,
+/// mean = mean_a + d nb / n, M2 = M2a + M2b + d² na nb / n.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MStatistics.h"
+#include "MMathKernels.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+namespace math {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+using namespace detail;
+
+/// Размер блока пакетного обновления (два прохода по блоку - в кеше L1)
+const size_t cBlock = 2048;
+
+/// Сумма дорожек регистра
+template <class Vec>
+inline double laneSum(typename Vec::V a)
+{
+    double t[Vec::Width];
+    Vec::store(t, a);
+    double s = 0.0;
+    for (int i = 0; i < Vec::Width; ++i)
+        s += t[i];
+    return s;
+}
+
+template <class Vec>
+inline void laneMinMax(typename Vec::V mn, typename Vec::V mx, double & outMin, double & outMax)
+{
+    double a[Vec::Width], b[Vec::Width];
+    Vec::store(a, mn);
+    Vec::store(b, mx);
+    for (int i = 0; i < Vec::Width; ++i)
+    {
+        outMin = a[i] < outMin ? a[i] : outMin;
+        outMax = b[i] > outMax ? b[i] : outMax;
+    }
+}
+
+/// Статистика блока: сумма, min, max за первый проход, M2 относительно среднего - за второй
+template <class Vec>
+void blockStats(const double * data, size_t count, double & mean, double & m2, double & mn, double & mx)
+{
+    typedef typename Vec::V V;
+
+    // Четыре независимых аккумулятора скрывают задержку сложения
+    V s0 = Vec::set1(0), s1 = s0, s2 = s0, s3 = s0;
+    V vmin = Vec::set1(std::numeric_limits<double>::infinity());
+    V vmax = Vec::set1(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 4 * Vec::Width <= count; i += 4 * Vec::Width)
+    {
+        const V a = Vec::load(data + i);
+        const V b = Vec::load(data + i + Vec::Width);
+        const V c = Vec::load(data + i + 2 * Vec::Width);
+        const V d = Vec::load(data + i + 3 * Vec::Width);
+        s0 = Vec::add(s0, a);
+        s1 = Vec::add(s1, b);
+        s2 = Vec::add(s2, c);
+        s3 = Vec::add(s3, d);
+        vmin = Vec::min(vmin, Vec::min(Vec::min(a, b), Vec::min(c, d)));
+        vmax = Vec::max(vmax, Vec::max(Vec::max(a, b), Vec::max(c, d)));
+    }
+    double sum = laneSum<Vec>(Vec::add(Vec::add(s0, s1), Vec::add(s2, s3)));
+    laneMinMax<Vec>(vmin, vmax, mn, mx);
+    for (size_t j = i; j < count; ++j)
+    {
+        sum += data[j];
+        mn = data[j] < mn ? data[j] : mn;
+        mx = data[j] > mx ? data[j] : mx;
+    }
+    mean = sum / static_cast<double>(count);
+
+    // Второй проход: сумма квадратов отклонений и поправка на погрешность среднего
+    const V vm = Vec::set1(mean);
+    V q0 = Vec::set1(0), q1 = q0, e0 = q0, e1 = q0;
+    for (i = 0; i + 2 * Vec::Width <= count; i += 2 * Vec::Width)
+    {
+        const V a = Vec::sub(Vec::load(data + i), vm);
+        const V b = Vec::sub(Vec::load(data + i + Vec::Width), vm);
+        q0 = Vec::fmadd(a, a, q0);
+        q1 = Vec::fmadd(b, b, q1);
+        e0 = Vec::add(e0, a);
+        e1 = Vec::add(e1, b);
+    }
+    double q = laneSum<Vec>(Vec::add(q0, q1));
+    double e = laneSum<Vec>(Vec::add(e0, e1));
+    for (; i < count; ++i)
+    {
+        const double a = data[i] - mean;
+        q += a * a;
+        e += a;
+    }
+    // Скорректированный двухпроходный алгоритм: M2 = Σ(x - m)² - (Σ(x - m))² / n
+    m2 = q - e * e / static_cast<double>(count);
+    if (m2 < 0.0)
+        m2 = 0.0;
+}
+
+/// EWMA - рекуррентность, векторизации не поддается; цикл без ветвлений после первого значения
+template <typename T>
+inline void ewmaUpdate(double alpha, uint64_t & count, double & mean, double & var,
+                       const T * data, size_t n)
+{
+    size_t i = 0;
+    if (n > 0 && count == 0)
+    {
+        mean = data[0];
+        i = 1;
+    }
+    const double beta = 1.0 - alpha;
+    double m = mean, v = var;
+    for (; i < n; ++i)
+    {
+        const double delta = static_cast<double>(data[i]) - m;
+        const double incr = alpha * delta;
+        m += incr;
+        v = beta * (v + delta * incr);
+    }
+    mean = m;
+    var = v;
+    count += n;
+}
+
+} // namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MRunningStats::mergePart(uint64_t n, double mean, double m2, double mn, double mx)
+{
+    if (n == 0)
+        return;
+    if (m_count == 0)
+    {
+        m_count = n;
+        m_mean = mean;
+        m_m2 = m2;
+    }
+    else
+    {
+        const double na = static_cast<double>(m_count);
+        const double nb = static_cast<double>(n);
+        const double total = na + nb;
+        const double delta = mean - m_mean;
+        m_mean += delta * (nb / total);
+        m_m2 += m2 + delta * delta * (na * nb / total);
+        m_count += n;
+    }
+    m_min = mn < m_min ? mn : m_min;
+    m_max = mx > m_max ? mx : m_max;
+}
+
+void MRunningStats::merge(const MRunningStats & other)
+{   mergePart(other.m_count, other.m_mean, other.m_m2, other.m_min, other.m_max); }
+
+void MRunningStats::update(const double * data, size_t count)
+{
+    for (size_t pos = 0; pos < count; pos += cBlock)
+    {
+        const size_t n = count - pos < cBlock ? count - pos : cBlock;
+        double mean, m2;
+        double mn = std::numeric_limits<double>::infinity();
+        double mx = -std::numeric_limits<double>::infinity();
+        blockStats<VecBest<double>::type>(data + pos, n, mean, m2, mn, mx);
+        mergePart(n, mean, m2, mn, mx);
+    }
+}
+
+void MRunningStats::update(const float * data, size_t count)
+{
+    double buf[cBlock];
+    for (size_t pos = 0; pos < count; pos += cBlock)
+    {
+        const size_t n = count - pos < cBlock ? count - pos : cBlock;
+        for (size_t j = 0; j < n; ++j)
+            buf[j] = data[pos + j];
+        double mean, m2;
+        double mn = std::numeric_limits<double>::infinity();
+        double mx = -std::numeric_limits<double>::infinity();
+        blockStats<VecBest<double>::type>(buf, n, mean, m2, mn, mx);
+        mergePart(n, mean, m2, mn, mx);
+    }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MEwma::update(const float * data, size_t count)
+{   ewmaUpdate(m_alpha, m_count, m_mean, m_var, data, count); }
+
+void MEwma::update(const double * data, size_t count)
+{   ewmaUpdate(m_alpha, m_count, m_mean, m_var, data, count); }
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace math
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
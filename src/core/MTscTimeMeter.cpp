@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2011-2026 Mitrokhin S.V. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file MTscTimeMeter.cpp
+/// @brief Счетчик времени на TSC: определение возможностей процессора и калибровка
+/// @author Mitrokhin S.V.
+/// @date 19.10.2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#include "MTscTimeMeter.h"
+#if defined(MLIB_ARCH_X86) && !defined(MLIB_MSC)
+    #include <cpuid.h>
+#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_BEGIN_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+/// Регистры CPUID (eax, ebx, ecx, edx), false - лист не поддерживается
+bool cpuid(unsigned leaf, unsigned regs[4])
+{
+#if defined(MLIB_ARCH_X86) && defined(MLIB_MSC)
+    int info[4];
+    __cpuid(info, static_cast<int>(leaf & 0x80000000u));
+    if (static_cast<unsigned>(info[0]) < leaf)
+        return false;
+    __cpuid(info, static_cast<int>(leaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<unsigned>(info[i]);
+    return true;
+#elif defined(MLIB_ARCH_X86)
+    return __get_cpuid(leaf, &regs[0], &regs[1], &regs[2], &regs[3]) != 0;
+#else
+    (void)leaf;
+    (void)regs;
+    return false;
+#endif
+}
+
+/// Эталонное время в наносекундах: CLOCK_MONOTONIC (в Windows - steady_clock)
+uint64_t referenceNsecs()
+{
+#if defined(MLIB_OS_WIN)
+    return tsc::clockNsecs();
+#else
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ull + static_cast<uint64_t>(time.tv_nsec);
+#endif
+}
+
+/// Одновременные отсчеты TSC и эталонного времени
+struct Sample
+{
+    uint64_t ticks;
+    uint64_t nsecs;
+};
+
+/// Лучшая из нескольких попыток: чтение эталона между двумя отсчетами TSC, ближайшими
+/// друг к другу, а прерывания и вытеснение дают заметно большее расстояние
+Sample sample()
+{
+    Sample best = { 0, 0 };
+    uint64_t bestWidth = ~static_cast<uint64_t>(0);
+    for (int i = 0; i < 16; ++i)
+    {
+        const uint64_t t0 = tsc::readStart();
+        const uint64_t ns = referenceNsecs();
+        const uint64_t t1 = tsc::readStop();
+        if (t1 - t0 < bestWidth)
+        {
+            bestWidth = t1 - t0;
+            best.ticks = t0 + (t1 - t0) / 2;
+            best.nsecs = ns;
+        }
+    }
+    return best;
+}
+
+/// Калибровка при запуске программы, чтобы первый замер не ждал ее
+const MTscCalibration & s_startup = tsc::calibration();
+
+} // namespace
+
+namespace tsc {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MTscCalibration calibrate(unsigned durationMs)
+{
+    MTscCalibration c;
+    c.frequency = 1000000000u;
+    c.mult = static_cast<uint64_t>(1) << 32;
+    c.supported = c.invariant = c.hardware = false;
+
+    unsigned regs[4];
+    // Лист 1 EDX бит 4 - rdtsc, 0x80000001 EDX бит 27 - rdtscp, 0x80000007 EDX бит 8 - инвариантный TSC
+    c.supported = cpuid(1, regs) && (regs[3] & (1u << 4)) != 0
+               && cpuid(0x80000001u, regs) && (regs[3] & (1u << 27)) != 0;
+    c.invariant = c.supported && cpuid(0x80000007u, regs) && (regs[3] & (1u << 8)) != 0;
+    if (!c.invariant)
+        return c;
+
+    if (durationMs == 0)
+        durationMs = 1;
+    // Эталон - не длиннее ~4 с, чтобы nsecs << 32 не переполнялось
+    if (durationMs > 4000)
+        durationMs = 4000;
+    const Sample first = sample();
+    const uint64_t until = first.nsecs + durationMs * 1000000ull;
+    while (referenceNsecs() < until)
+        ;
+    const Sample last = sample();
+    const uint64_t ticks = last.ticks - first.ticks;
+    const uint64_t nsecs = last.nsecs - first.nsecs;
+    if (ticks == 0 || nsecs == 0)
+        return c;
+
+    c.frequency = static_cast<uint64_t>(static_cast<double>(ticks) * 1e+9 / static_cast<double>(nsecs) + 0.5);
+    c.mult = ((nsecs << 32) + ticks / 2) / ticks;
+    c.hardware = c.mult != 0;
+    if (!c.hardware)
+    {
+        c.frequency = 1000000000u;
+        c.mult = static_cast<uint64_t>(1) << 32;
+    }
+    return c;
+}
+
+const MTscCalibration & calibration()
+{
+    static const MTscCalibration c = calibrate();
+    return c;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+} // namespace tsc
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MLIB_END_NAMESPACE
+////////////////////////////////////////////////////////////////////////////////////////////////////